@@ -29,6 +29,16 @@ namespace il2cpp
 		public bool IsStatic => Def.IsStatic;
 		public bool IsInstance => Helper.IsInstanceField(Def);
 
+		// 编译器生成的 RVA 静态数据, 从不被写入, 可直接放入只读段
+		public bool IsRVAData =>
+			IsStatic && Def.HasFieldRVA &&
+			Def.InitialValue != null && Def.InitialValue.Length > 0 &&
+			DeclType.Def.Name.StartsWith("<PrivateImplementationDetails>");
+
+		// [ThreadStatic] 字段, 每个线程各有一份
+		public bool IsThreadStatic =>
+			IsStatic && Def.CustomAttributes.IsDefined("System.ThreadStaticAttribute");
+
 		public FieldX(TypeX declType, FieldDef fldDef)
 		{
 			Debug.Assert(declType != null);
@@ -20,6 +20,35 @@ namespace il2cpp
 			TransMap = transMap;
 		}
 
+		// 与生成代码匹配的编译参数
+		public string BuildParams
+		{
+			get
+			{
+				List<string> cflags = new List<string>();
+				if (GenContext.IsStatusException)
+					cflags.Add("-DIL2CPP_EXCEPTION_STATUS -fno-exceptions");
+				else if (GenContext.IsImplicitNullCheck)
+				{
+					// 信号处理直接抛出异常, 需要访存指令也能展开
+					cflags.Add("-DIL2CPP_IMPLICIT_NULLCHECK -fnon-call-exceptions");
+				}
+
+				uint stackSize = GenContext.TypeMgr.Context.ThreadStackSize;
+				if (stackSize != 0)
+					cflags.Add("-DIL2CPP_THREAD_STACK_SIZE=" + stackSize);
+
+				if (cflags.Count == 0)
+					return null;
+				return "-addcflags \"" + string.Join(" ", cflags) + "\"";
+			}
+		}
+
+		// 生成的方法实现中被折叠的数量与比例
+		public int ImplMethodCount => GenContext.ImplMethodCount;
+		public int FoldedMethodCount => GenContext.FoldedMethodCount;
+		public double FoldRatio => ImplMethodCount == 0 ? 0 : (double)FoldedMethodCount / ImplMethodCount;
+
 		public void GenerateIncludes()
 		{
 			StringBuilder sb = new StringBuilder();
@@ -57,6 +86,13 @@ namespace il2cpp
 			unitName = TransMap[typeName];
 			return GenContext.GetMethodName(metX, MethodGenerator.PrefixMet);
 		}
+
+		// 方法实际使用的实现函数名, 被折叠时为保留的函数名
+		public string GetImplMethodName(MethodDef metDef)
+		{
+			string metName = GetMethodName(metDef, out _);
+			return GenContext.GetFoldedMethodName(metName) ?? metName;
+		}
 	}
 
 	public class CompileUnit
@@ -264,10 +300,20 @@ namespace il2cpp
 	internal class GeneratorContext
 	{
 		public readonly TypeManager TypeMgr;
+		public bool IsStatusException => TypeMgr.Context.UseStatusException;
+		// 状态返回模式无法从信号处理中展开, 此时不启用
+		public bool IsImplicitNullCheck => TypeMgr.Context.UseImplicitNullCheck && !IsStatusException;
 		public readonly StringGenerator StrGen = new StringGenerator();
 		private readonly HashSet<string> UsedTypeNames = new HashSet<string>();
 		private readonly HashSet<string> UsedMethodNames = new HashSet<string>();
-		private readonly Dictionary<string, List<Tuple<string, bool>>> InitFldsMap = new Dictionary<string, List<Tuple<string, bool>>>();
+		private readonly Dictionary<string, List<Tuple<string, bool, string>>> InitFldsMap = new Dictionary<string, List<Tuple<string, bool, string>>>();
+		private readonly List<Tuple<string, string>> ThreadStaticBlocks = new List<Tuple<string, string>>();
+		// 折叠键对应的首个方法名与声明
+		private readonly Dictionary<string, Tuple<string, string>> FoldedImpls = new Dictionary<string, Tuple<string, string>>();
+		// 被折叠的方法名对应的保留方法名
+		private readonly Dictionary<string, string> FoldedMethods = new Dictionary<string, string>();
+		public int ImplMethodCount { get; private set; }
+		public int FoldedMethodCount { get; private set; }
 		private uint TypeIDCounter;
 		private uint StringTypeID;
 
@@ -276,14 +322,42 @@ namespace il2cpp
 			TypeMgr = typeMgr;
 		}
 
-		public void AddStaticField(string typeName, string sfldName, bool hasRef)
+		public void AddStaticField(string typeName, string sfldName, bool hasRef, string initValue = null)
 		{
 			if (!InitFldsMap.TryGetValue(typeName, out var nameSet))
 			{
-				nameSet = new List<Tuple<string, bool>>();
+				nameSet = new List<Tuple<string, bool, string>>();
 				InitFldsMap.Add(typeName, nameSet);
 			}
-			nameSet.Add(new Tuple<string, bool>(sfldName, hasRef));
+			nameSet.Add(new Tuple<string, bool, string>(sfldName, hasRef, initValue));
+		}
+
+		// 返回折叠键相同的已生成方法名与声明, 首次出现或不可折叠时返回空
+		public Tuple<string, string> FoldMethodImpl(string foldKey, string metName, string metDecl)
+		{
+			++ImplMethodCount;
+			if (foldKey == null)
+				return null;
+
+			if (FoldedImpls.TryGetValue(foldKey, out var foldImpl))
+			{
+				++FoldedMethodCount;
+				FoldedMethods.Add(metName, foldImpl.Item1);
+				return foldImpl;
+			}
+			FoldedImpls.Add(foldKey, new Tuple<string, string>(metName, metDecl));
+			return null;
+		}
+
+		public string GetFoldedMethodName(string metName)
+		{
+			FoldedMethods.TryGetValue(metName, out string foldName);
+			return foldName;
+		}
+
+		public void AddThreadStaticBlock(string typeName, string blockName)
+		{
+			ThreadStaticBlocks.Add(new Tuple<string, string>(typeName, blockName));
 		}
 
 		private CompileUnit GenInitUnit(Dictionary<string, string> transMap)
@@ -305,13 +379,23 @@ namespace il2cpp
 						prtGC.AppendFormatLine("IL2CPP_ADD_ROOT({0}),", item.Item1);
 						addedRoots = true;
 					}
-					prtInit.AppendFormatLine("{0} = {{}};", item.Item1);
+					if (item.Item3 != null)
+						prtInit.AppendFormatLine("{0} = {1};", item.Item1, item.Item3);
+					else
+						prtInit.AppendFormatLine("{0} = {{}};", item.Item1);
 				}
 			}
 
 			CodePrinter prtFunc = new CodePrinter();
+			// 没有静态字段和字符串时不会引用其他单元, 需要直接包含运行时头文件
+			prtFunc.AppendLine("#include \"il2cpp.h\"");
 			prtFunc.AppendLine("void il2cpp_InitVariables()\n{");
 			++prtFunc.Indents;
+			if (StrGen.HasStrings)
+			{
+				unit.ImplDepends.Add(StringGenerator.BlobUnitName);
+				prtFunc.AppendLine("il2cpp_String__RegisterLiterals(&il2cpp_LiteralTable);");
+			}
 			if (addedRoots)
 			{
 				prtFunc.AppendLine("il2cppRootItem roots[] =\n{");
@@ -325,6 +409,21 @@ namespace il2cpp
 			--prtFunc.Indents;
 			prtFunc.AppendLine("}");
 
+			// 线程注册到 GC 时调用, 添加或移除当前线程的 TLS 块
+			prtFunc.AppendLine("void il2cpp_ThreadStatics__Register(uint8_t isAdd)\n{");
+			++prtFunc.Indents;
+			if (ThreadStaticBlocks.Count != 0)
+			{
+				prtFunc.AppendLine("auto func = isAdd ? &il2cpp_GC_AddRoots : &il2cpp_GC_RemoveRoots;");
+				foreach (var item in ThreadStaticBlocks)
+				{
+					unit.ImplDepends.Add(transMap[item.Item1]);
+					prtFunc.AppendFormatLine("func(&{0}, &{0} + 1);", item.Item2);
+				}
+			}
+			--prtFunc.Indents;
+			prtFunc.AppendLine("}");
+
 			unit.ImplCode = prtFunc.ToString();
 
 			return unit;
@@ -334,8 +433,18 @@ namespace il2cpp
 		{
 			var unitMap = new Dictionary<string, CompileUnit>();
 
-			// 生成类型代码
 			var types = TypeMgr.Types;
+
+			// 展开小方法并去虚化单实现的调用
+			MethodInliner.Inline(types);
+
+			// 全局分析只读的静态数组
+			StaticArrayAnalyzer.Analyze(types);
+
+			// 引用类型实参的泛型实例共享实现
+			GenericShareAnalyzer.Analyze(types);
+
+			// 生成类型代码
 			foreach (TypeX tyX in types)
 			{
 				CompileUnit unit = new TypeGenerator(this, tyX).Generate();
@@ -490,6 +599,35 @@ namespace il2cpp
 			return !IsInstanceNoRef(tyX);
 		}
 
+		// 较大的值类型参数按常量引用传递, 避免每次调用复制整个结构体
+		public bool IsArgPassByRef(TypeSig argType)
+		{
+			uint refSize = TypeMgr.Context.ValueTypeRefSize;
+			if (refSize == 0)
+				return false;
+
+			argType = argType.RemoveModifiers();
+			if (argType.ElementType != ElementType.ValueType &&
+				argType.ElementType != ElementType.GenericInst)
+				return false;
+
+			if (!argType.IsValueType ||
+				Helper.IsEnumType(argType, out _) ||
+				GetTypeBySig(argType) == null)
+				return false;
+
+			return GetTypeLayoutOrder(argType) > refSize;
+		}
+
+		// 函数签名与函数指针中的参数类型
+		public string GetArgTypeName(TypeSig argType)
+		{
+			string strType = GetTypeName(argType);
+			if (IsArgPassByRef(argType))
+				return "const " + strType + '&';
+			return strType;
+		}
+
 		public string GetTypeDefaultValue(TypeSig tySig)
 		{
 			switch (tySig.ElementType)
@@ -0,0 +1,380 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using dnlib.DotNet;
+using dnlib.DotNet.Emit;
+
+namespace il2cpp
+{
+	// 引用类型实参的泛型实例共享同一份实现 (__Canon)
+	// 类型转换, 分配对象, 访问静态字段等依赖具体实参的方法仍各自展开
+	internal static class GenericShareAnalyzer
+	{
+		private const string CanonName = "__Canon";
+
+		public static void Analyze(IEnumerable<TypeX> types)
+		{
+			// 按方法定义与规范化实参分组
+			var groupMap = new Dictionary<MethodDef, Dictionary<string, List<MethodX>>>();
+			foreach (var tyX in types)
+			{
+				if (tyX.IsArrayType)
+					continue;
+
+				foreach (var metX in tyX.Methods)
+				{
+					if (!IsShareCandidate(metX))
+						continue;
+
+					string canonKey = GetCanonKey(metX);
+					if (canonKey == null)
+						continue;
+
+					if (!groupMap.TryGetValue(metX.Def, out var canonMap))
+					{
+						canonMap = new Dictionary<string, List<MethodX>>();
+						groupMap.Add(metX.Def, canonMap);
+					}
+					if (!canonMap.TryGetValue(canonKey, out var group))
+					{
+						group = new List<MethodX>();
+						canonMap.Add(canonKey, group);
+					}
+					group.Add(metX);
+				}
+			}
+
+			// 拆分出结构一致的等价类, 调用目标暂时视为等价
+			var classes = new List<List<MethodX>>();
+			var classMap = new Dictionary<MethodX, int>();
+			foreach (var canonMap in groupMap.Values)
+			{
+				foreach (var group in canonMap.Values)
+				{
+					if (group.Count < 2)
+						continue;
+
+					int first = classes.Count;
+					foreach (var metX in group)
+					{
+						int idx = first;
+						for (; idx < classes.Count; ++idx)
+						{
+							if (IsStructEqual(classes[idx][0], metX))
+								break;
+						}
+
+						if (idx == classes.Count)
+							classes.Add(new List<MethodX>());
+						classes[idx].Add(metX);
+						classMap[metX] = idx;
+					}
+				}
+			}
+
+			// 细分等价类直到调用目标也在同一等价类中
+			for (; ; )
+			{
+				bool changed = false;
+				for (int i = 0, sz = classes.Count; i < sz; ++i)
+				{
+					var cls = classes[i];
+					if (cls.Count < 2)
+						continue;
+
+					var repMetX = cls[0];
+					var keep = new List<MethodX> { repMetX };
+					List<MethodX> moved = null;
+					for (int j = 1; j < cls.Count; ++j)
+					{
+						var metX = cls[j];
+						if (IsCallsEqual(repMetX, metX, classMap))
+							keep.Add(metX);
+						else
+						{
+							if (moved == null)
+								moved = new List<MethodX>();
+							moved.Add(metX);
+						}
+					}
+
+					if (moved != null)
+					{
+						classes[i] = keep;
+						int idx = classes.Count;
+						classes.Add(moved);
+						foreach (var metX in moved)
+							classMap[metX] = idx;
+						changed = true;
+					}
+				}
+
+				if (!changed)
+					break;
+			}
+
+			foreach (var cls in classes)
+			{
+				for (int i = 1; i < cls.Count; ++i)
+					cls[i].SharedMethod = cls[0];
+			}
+		}
+
+		private static bool IsShareCandidate(MethodX metX)
+		{
+			if (!metX.IsProcessed || metX.InstList == null)
+				return false;
+
+			if (!metX.HasGenArgs && !metX.DeclType.HasGenArgs)
+				return false;
+
+			var metDef = metX.Def;
+			if (metDef.IsStaticConstructor)
+				return false;
+
+			// 实例构造会触发本类型的静态构造
+			if (metDef.IsConstructor && metX.DeclType.CctorMethod != null)
+				return false;
+
+			return true;
+		}
+
+		// 引用类型实参替换为 __Canon, 没有引用类型实参时不参与共享
+		private static string GetCanonKey(MethodX metX)
+		{
+			bool hasCanon = false;
+			var sb = new StringBuilder();
+			AppendCanonArgs(sb, metX.DeclType.GenArgs, ref hasCanon);
+			sb.Append('|');
+			AppendCanonArgs(sb, metX.GenArgs, ref hasCanon);
+
+			if (!hasCanon)
+				return null;
+			return sb.ToString();
+		}
+
+		private static void AppendCanonArgs(StringBuilder sb, IList<TypeSig> genArgs, ref bool hasCanon)
+		{
+			if (!genArgs.IsCollectionValid())
+				return;
+
+			for (int i = 0; i < genArgs.Count; ++i)
+			{
+				if (i != 0)
+					sb.Append(',');
+
+				string name = GetCanonName(genArgs[i]);
+				if (name == CanonName)
+					hasCanon = true;
+				sb.Append(name);
+			}
+		}
+
+		private static string GetCanonName(TypeSig tySig)
+		{
+			switch (tySig.ElementType)
+			{
+				case ElementType.Object:
+				case ElementType.String:
+				case ElementType.Class:
+				case ElementType.SZArray:
+				case ElementType.Array:
+					return CanonName;
+
+				case ElementType.GenericInst:
+					{
+						if (!tySig.IsValueType)
+							return CanonName;
+
+						var genSig = (GenericInstSig)tySig;
+						var sb = new StringBuilder();
+						sb.Append(genSig.GenericType.FullName);
+						sb.Append('<');
+						for (int i = 0; i < genSig.GenericArguments.Count; ++i)
+						{
+							if (i != 0)
+								sb.Append(',');
+							sb.Append(GetCanonName(genSig.GenericArguments[i]));
+						}
+						sb.Append('>');
+						return sb.ToString();
+					}
+
+				case ElementType.Ptr:
+					return GetCanonName(tySig.Next) + '*';
+				case ElementType.ByRef:
+					return GetCanonName(tySig.Next) + '&';
+
+				case ElementType.Pinned:
+				case ElementType.CModOpt:
+					return GetCanonName(tySig.Next);
+
+				case ElementType.CModReqd:
+					return ((CModReqdSig)tySig).Modifier.FullName + ' ' + GetCanonName(tySig.Next);
+			}
+			return tySig.FullName;
+		}
+
+		// 两个类型的内存布局一致
+		private static bool IsLayoutEqual(TypeSig lhs, TypeSig rhs)
+		{
+			return GetCanonName(lhs) == GetCanonName(rhs);
+		}
+
+		private static bool IsLayoutEqual(TypeX lhs, TypeX rhs)
+		{
+			if (lhs == rhs)
+				return true;
+			// 引用类型本身都规范为 __Canon, 需要比较实参决定字段布局
+			return lhs.Def == rhs.Def &&
+				   IsLayoutEqual(lhs.GenArgs, rhs.GenArgs);
+		}
+
+		private static bool IsLayoutEqual(IList<TypeSig> lhs, IList<TypeSig> rhs)
+		{
+			int count = lhs?.Count ?? 0;
+			if (count != (rhs?.Count ?? 0))
+				return false;
+
+			for (int i = 0; i < count; ++i)
+			{
+				if (!IsLayoutEqual(lhs[i], rhs[i]))
+					return false;
+			}
+			return true;
+		}
+
+		private static bool IsStructEqual(MethodX lhs, MethodX rhs)
+		{
+			if (!IsLayoutEqual(lhs.ReturnType, rhs.ReturnType) ||
+				!IsLayoutEqual(lhs.ParamTypes, rhs.ParamTypes) ||
+				!IsLayoutEqual(lhs.LocalTypes, rhs.LocalTypes))
+				return false;
+
+			if (!IsExHandlersEqual(lhs.ExHandlerList, rhs.ExHandlerList))
+				return false;
+
+			var lhsInsts = lhs.InstList;
+			var rhsInsts = rhs.InstList;
+			if (lhsInsts.Length != rhsInsts.Length)
+				return false;
+
+			for (int i = 0; i < lhsInsts.Length; ++i)
+			{
+				var lhsInst = lhsInsts[i];
+				var rhsInst = rhsInsts[i];
+				if (lhsInst.OpCode != rhsInst.OpCode ||
+					lhsInst.IsBrTarget != rhsInst.IsBrTarget ||
+					lhsInst.StaticArray != rhsInst.StaticArray)
+					return false;
+
+				if (!IsOperandEqual(lhsInst.OpCode.Code, lhsInst.Operand, rhsInst.Operand))
+					return false;
+			}
+			return true;
+		}
+
+		private static bool IsExHandlersEqual(List<ExHandlerInfo> lhs, List<ExHandlerInfo> rhs)
+		{
+			int count = lhs?.Count ?? 0;
+			if (count != (rhs?.Count ?? 0))
+				return false;
+
+			for (int i = 0; i < count; ++i)
+			{
+				var lhsCombined = lhs[i].CombinedHandlers;
+				var rhsCombined = rhs[i].CombinedHandlers;
+				if (lhsCombined.Count != rhsCombined.Count)
+					return false;
+
+				for (int j = 0; j < lhsCombined.Count; ++j)
+				{
+					var lh = lhsCombined[j];
+					var rh = rhsCombined[j];
+					if (lh.TryStart != rh.TryStart ||
+						lh.TryEnd != rh.TryEnd ||
+						lh.FilterStart != rh.FilterStart ||
+						lh.HandlerStart != rh.HandlerStart ||
+						lh.HandlerEnd != rh.HandlerEnd ||
+						lh.HandlerType != rh.HandlerType ||
+						lh.CatchType != rh.CatchType)
+						return false;
+				}
+			}
+			return true;
+		}
+
+		private static bool IsOperandEqual(Code code, object lhs, object rhs)
+		{
+			if (lhs == rhs)
+				return true;
+			if (lhs == null || rhs == null)
+				return false;
+
+			switch (lhs)
+			{
+				case int[] lhsTargets:
+					return rhs is int[] rhsTargets && lhsTargets.SequenceEqual(rhsTargets);
+
+				case Parameter lhsParam:
+					return rhs is Parameter rhsParam && lhsParam.Index == rhsParam.Index;
+
+				case Local lhsLocal:
+					return rhs is Local rhsLocal && lhsLocal.Index == rhsLocal.Index;
+
+				case FieldX lhsFld:
+					{
+						// 实例字段只依赖布局, 静态字段属于各自的实例
+						if (!(rhs is FieldX rhsFld) || lhsFld.Def != rhsFld.Def || lhsFld.IsStatic)
+							return false;
+						return IsLayoutEqual(lhsFld.DeclType, rhsFld.DeclType);
+					}
+
+				case MethodX lhsMet:
+					{
+						// 直接调用的目标由 IsCallsEqual 检查, 其他指令依赖具体实例
+						if (!(rhs is MethodX rhsMet) || code != Code.Call || lhsMet.Def != rhsMet.Def)
+							return false;
+
+						if (lhsMet.DeclType.IsArrayType)
+						{
+							// 数组的读写只依赖元素布局, 构造需要具体类型
+							return lhsMet.Def.Name != ".ctor" &&
+								   IsLayoutEqual(lhsMet.DeclType.GenArgs[0], rhsMet.DeclType.GenArgs[0]) &&
+								   lhsMet.DeclType.ArrayInfo.Rank == rhsMet.DeclType.ArrayInfo.Rank;
+						}
+						return IsLayoutEqual(lhsMet.ParamTypes, rhsMet.ParamTypes) &&
+							   IsLayoutEqual(lhsMet.ReturnType, rhsMet.ReturnType);
+					}
+
+				// 类型相关的操作
+				case TypeX _:
+					return false;
+			}
+
+			return lhs.Equals(rhs);
+		}
+
+		private static bool IsCallsEqual(MethodX lhs, MethodX rhs, Dictionary<MethodX, int> classMap)
+		{
+			var lhsInsts = lhs.InstList;
+			var rhsInsts = rhs.InstList;
+			for (int i = 0; i < lhsInsts.Length; ++i)
+			{
+				if (lhsInsts[i].OpCode.Code != Code.Call)
+					continue;
+
+				var lhsMet = (MethodX)lhsInsts[i].Operand;
+				var rhsMet = (MethodX)rhsInsts[i].Operand;
+				if (lhsMet == rhsMet || lhsMet.DeclType.IsArrayType)
+					continue;
+
+				if (!classMap.TryGetValue(lhsMet, out int lhsClass) ||
+					!classMap.TryGetValue(rhsMet, out int rhsClass) ||
+					lhsClass != rhsClass)
+					return false;
+			}
+			return true;
+		}
+	}
+}
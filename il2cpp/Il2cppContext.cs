@@ -18,6 +18,15 @@ namespace il2cpp
 
 		internal TypeManager TypeMgr;
 
+		// 使用线程局部的待处理异常与调用后检查代替 C++ 异常, 运行时以 -fno-exceptions 编译
+		public bool UseStatusException;
+		// 由运行时的 SIGSEGV 处理把低地址访问转为空引用异常, 仅在偏移可能超出保护页时显式检查
+		public bool UseImplicitNullCheck;
+		// 托管线程未指定 maxStackSize 时的栈大小, 0 表示使用系统默认值
+		public uint ThreadStackSize;
+		// 值类型参数的累计字段大小超过该值时按常量引用传递, 0 表示始终按值传递
+		public uint ValueTypeRefSize;
+
 		static Il2cppContext()
 		{
 			// 释放 GAC
@@ -105,7 +114,7 @@ namespace il2cpp
 			// 生成编译脚本
 			StringBuilder sb = new StringBuilder();
 			sb.AppendLine("@echo off");
-			sb.AppendFormat("BuildTheCode -addcflags \"-DGC_THREADS\" {0} il2cpp.cpp", addParams);
+			sb.AppendFormat("BuildTheCode -addcflags \"-DGC_THREADS\" {0} il2cpp.cpp il2cppString.cpp il2cppArray.cpp il2cppThread.cpp il2cppThreadPool.cpp", addParams);
 			foreach (string unitName in unitNames)
 				sb.AppendFormat(" {0}.cpp", unitName);
 			sb.AppendLine();
@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.Diagnostics;
 using System.Linq;
 using System.Text;
+using System.Text.RegularExpressions;
 using dnlib.DotNet;
 using dnlib.DotNet.Emit;
 
@@ -134,6 +135,9 @@ namespace il2cpp
 	{
 		public readonly StackType SlotType;
 		public readonly int SlotIndex;
+		// 前向替换的表达式, 为空时使用临时变量
+		public string Expr;
+		public bool IsCompound;
 
 		public SlotInfo(StackType stype, int idx)
 		{
@@ -143,10 +147,33 @@ namespace il2cpp
 
 		public override string ToString()
 		{
-			return "tmp_" + SlotIndex + '_' + SlotType.GetPostfix();
+			return Expr ?? "tmp_" + SlotIndex + '_' + SlotType.GetPostfix();
 		}
 	}
 
+	// 栈槽上尚未写入临时变量的纯表达式
+	internal class ForwardInfo
+	{
+		public readonly string Expr;
+		// 由运算组合而成, 重复展开会重复计算
+		public readonly bool IsCompound;
+
+		public ForwardInfo(string expr, bool isCompound)
+		{
+			Expr = expr;
+			IsCompound = isCompound;
+		}
+	}
+
+	// 指令对出栈表达式的展开方式
+	internal enum FoldKind
+	{
+		// 只展开变量与常量
+		Atomic,
+		// 每个操作数只使用一次, 可展开组合表达式
+		All
+	}
+
 	// 方法生成器
 	internal class MethodGenerator
 	{
@@ -163,6 +190,18 @@ namespace il2cpp
 		// 分支队列
 		private readonly Queue<Tuple<Stack<StackType>, int>> Branches = new Queue<Tuple<Stack<StackType>, int>>();
 		private readonly Dictionary<int, HashSet<StackType>> SlotMap = new Dictionary<int, HashSet<StackType>>();
+		// 可前向替换的栈槽表达式
+		private readonly Dictionary<int, ForwardInfo> Forwards = new Dictionary<int, ForwardInfo>();
+		// 取过地址的局部变量与参数, 可能被间接修改
+		private HashSet<string> AddrTakenVars;
+		// 当前指令的出栈展开方式
+		private FoldKind CurrFold;
+		// 当前指令的下标
+		private int CurrIP;
+		// 被读取过的局部变量, 隐式空检查模式下按需收集
+		private HashSet<int> ReadLocals;
+		// 当前指令之前需要写入临时变量的表达式
+		private List<string> FlushCodes;
 
 		// 离开异常映射
 		private readonly Dictionary<int, int> LeaveMap = new Dictionary<int, int>();
@@ -171,6 +210,18 @@ namespace il2cpp
 		// 约束类型
 		private TypeX ConstrainedType;
 
+		// 按引用传入但会被修改或取地址的参数, 在函数内使用副本
+		private HashSet<int> ArgCopies;
+
+		// 循环提升的行基址变量声明
+		private List<string> HoistDecls;
+		// 编译期构造的只读数组对象定义
+		private List<string> StaticArrayDecls;
+		// 状态返回模式下当前指令所在 try 块的着陆点, 为空时直接返回
+		private string CurrLandingPad;
+		// 隐式空检查用的实例大小估算
+		private readonly Dictionary<TypeX, long> InstanceSizeCache = new Dictionary<TypeX, long>();
+
 		public readonly HashSet<string> DeclDepends = new HashSet<string>();
 		public readonly HashSet<string> ImplDepends = new HashSet<string>();
 		public readonly HashSet<string> StringDepends = new HashSet<string>();
@@ -196,9 +247,9 @@ namespace il2cpp
 		private SlotInfo Push(StackType stype)
 		{
 			SlotInfo slot = new SlotInfo(stype, TypeStack.Count);
+			Debug.Assert(!Forwards.ContainsKey(slot.SlotIndex));
 			TypeStack.Push(stype);
 			++PushCount;
-			AddSlotMap(slot);
 			return slot;
 		}
 
@@ -207,7 +258,20 @@ namespace il2cpp
 			Debug.Assert(TypeStack.Count > 0);
 			StackType stype = TypeStack.Pop();
 			++PopCount;
-			return new SlotInfo(stype, TypeStack.Count);
+			SlotInfo slot = new SlotInfo(stype, TypeStack.Count);
+
+			if (Forwards.TryGetValue(slot.SlotIndex, out var fwd))
+			{
+				Forwards.Remove(slot.SlotIndex);
+				if (CurrFold == FoldKind.All || !fwd.IsCompound)
+				{
+					slot.Expr = fwd.Expr;
+					slot.IsCompound = fwd.IsCompound;
+				}
+				else
+					FlushCodes.Add(GenAssign(TempName(slot), fwd.Expr, (StackType?)null));
+			}
+			return slot;
 		}
 
 		private SlotInfo[] Pop(int num)
@@ -221,17 +285,231 @@ namespace il2cpp
 		private SlotInfo Peek()
 		{
 			Debug.Assert(TypeStack.Count > 0);
-			return new SlotInfo(TypeStack.Peek(), TypeStack.Count - 1);
+			var slot = new SlotInfo(TypeStack.Peek(), TypeStack.Count - 1);
+			FlushForward(slot, FlushCodes);
+			return slot;
 		}
 
 		private SlotInfo GetStackSlot(int slot)
 		{
 			Debug.Assert(slot > 0);
-			return new SlotInfo(TypeStack.ElementAt(slot - 1), TypeStack.Count - slot);
+			var slotInfo = new SlotInfo(TypeStack.ElementAt(slot - 1), TypeStack.Count - slot);
+			FlushForward(slotInfo, FlushCodes);
+			return slotInfo;
+		}
+
+		// 把栈槽上的表达式写入临时变量
+		private void FlushForward(SlotInfo slot, List<string> codes)
+		{
+			if (Forwards.TryGetValue(slot.SlotIndex, out var fwd))
+			{
+				Forwards.Remove(slot.SlotIndex);
+				codes.Add(GenAssign(TempName(slot), fwd.Expr, (StackType?)null));
+			}
+		}
+
+		private void FlushAllForwards(List<string> codes)
+		{
+			if (Forwards.Count == 0)
+				return;
+
+			int idx = 0;
+			foreach (var stype in TypeStack.Reverse())
+				FlushForward(new SlotInfo(stype, idx++), codes);
+			Debug.Assert(Forwards.Count == 0);
+		}
+
+		// 变量被修改前, 写入引用了它的表达式
+		private void FlushForwardsReading(string varName)
+		{
+			if (Forwards.Count == 0)
+				return;
+
+			var regex = new Regex(@"\b" + varName + @"\b");
+			int idx = 0;
+			foreach (var stype in TypeStack.Reverse())
+			{
+				if (Forwards.TryGetValue(idx, out var fwd) && regex.IsMatch(fwd.Expr))
+					FlushForward(new SlotInfo(stype, idx), FlushCodes);
+				++idx;
+			}
+		}
+
+		// 纯表达式暂存在栈槽上, 由消费指令直接展开
+		private void GenPushExpr(InstInfo inst, SlotInfo slotPush, string rhs, bool canForward, string rhsType = null, bool isCompound = true)
+		{
+			if (canForward)
+			{
+				string expr = rhsType == slotPush.SlotType.GetTypeName() ? rhs : CastType(slotPush.SlotType) + rhs;
+				Forwards[slotPush.SlotIndex] = new ForwardInfo(WrapExpr(expr), isCompound);
+			}
+			else
+				inst.InstCode = GenAssign(TempName(slotPush), rhs, slotPush.SlotType);
+		}
+
+		private static string WrapExpr(string expr)
+		{
+			if (IsPrimaryExpr(expr))
+				return expr;
+			return '(' + expr + ')';
+		}
+
+		private static bool IsPrimaryExpr(string expr)
+		{
+			if (expr[0] == '(')
+			{
+				// 最外层括号包住整个表达式
+				int depth = 0;
+				for (int i = 0; i < expr.Length; ++i)
+				{
+					if (expr[i] == '(')
+						++depth;
+					else if (expr[i] == ')' && --depth == 0)
+						return i == expr.Length - 1;
+				}
+				return false;
+			}
+
+			foreach (char ch in expr)
+			{
+				if (!char.IsLetterOrDigit(ch) && ch != '_' && ch != '.')
+					return false;
+			}
+			return true;
+		}
+
+		private static bool IsForwardable(params SlotInfo[] slots)
+		{
+			foreach (var slot in slots)
+			{
+				if (slot.Expr == null)
+					return false;
+			}
+			return true;
+		}
+
+		private static bool IsNumericKind(StackTypeKind kind)
+		{
+			return kind == StackTypeKind.I4 || kind == StackTypeKind.I8 ||
+				kind == StackTypeKind.R4 || kind == StackTypeKind.R8 ||
+				kind == StackTypeKind.Ptr;
+		}
+
+		// 每个操作数只展开一次的指令可以接受组合表达式
+		private FoldKind GetFoldKind(InstInfo inst)
+		{
+			switch (inst.OpCode.Code)
+			{
+				case Code.Pop:
+				case Code.Ret:
+				case Code.Stloc:
+				case Code.Stloc_S:
+				case Code.Stloc_0:
+				case Code.Stloc_1:
+				case Code.Stloc_2:
+				case Code.Stloc_3:
+				case Code.Starg:
+				case Code.Starg_S:
+				case Code.Stsfld:
+				case Code.Stfld:
+				case Code.Ldfld:
+				case Code.Brfalse:
+				case Code.Brfalse_S:
+				case Code.Brtrue:
+				case Code.Brtrue_S:
+				case Code.Beq:
+				case Code.Beq_S:
+				case Code.Bge:
+				case Code.Bge_S:
+				case Code.Bgt:
+				case Code.Bgt_S:
+				case Code.Ble:
+				case Code.Ble_S:
+				case Code.Blt:
+				case Code.Blt_S:
+				case Code.Bne_Un:
+				case Code.Bne_Un_S:
+				case Code.Bge_Un:
+				case Code.Bge_Un_S:
+				case Code.Bgt_Un:
+				case Code.Bgt_Un_S:
+				case Code.Ble_Un:
+				case Code.Ble_Un_S:
+				case Code.Blt_Un:
+				case Code.Blt_Un_S:
+				case Code.Switch:
+				case Code.Ceq:
+				case Code.Cgt:
+				case Code.Cgt_Un:
+				case Code.Clt:
+				case Code.Clt_Un:
+				case Code.Add:
+				case Code.Sub:
+				case Code.Mul:
+				case Code.Div:
+				case Code.Div_Un:
+				case Code.Rem:
+				case Code.Neg:
+				case Code.Add_Ovf:
+				case Code.Add_Ovf_Un:
+				case Code.Sub_Ovf:
+				case Code.Sub_Ovf_Un:
+				case Code.Mul_Ovf:
+				case Code.Mul_Ovf_Un:
+				case Code.And:
+				case Code.Or:
+				case Code.Xor:
+				case Code.Not:
+				case Code.Shl:
+				case Code.Shr:
+				case Code.Shr_Un:
+				case Code.Conv_I1:
+				case Code.Conv_I2:
+				case Code.Conv_I4:
+				case Code.Conv_I8:
+				case Code.Conv_U1:
+				case Code.Conv_U2:
+				case Code.Conv_U4:
+				case Code.Conv_U8:
+				case Code.Conv_R4:
+				case Code.Conv_R8:
+				case Code.Conv_I:
+				case Code.Conv_U:
+				case Code.Conv_R_Un:
+					return FoldKind.All;
+
+				case Code.Call:
+				case Code.Callvirt:
+					// 展开的数组访问会重复使用操作数
+					if (inst.StaticArray != null || inst.IsRangeSafe ||
+						inst.RowHoist != null || inst.IsZeroLowerBound)
+						return FoldKind.Atomic;
+					return FoldKind.All;
+
+				case Code.Newobj:
+					if (inst.StaticArray != null || Helper.IsExtern(((MethodX)inst.Operand).Def))
+						return FoldKind.Atomic;
+					return FoldKind.All;
+
+				default:
+					return FoldKind.Atomic;
+			}
+		}
+
+		// 需要取地址或写入的出栈值不能展开
+		private void MaterializeSlot(SlotInfo slot)
+		{
+			if (slot.Expr == null)
+				return;
+
+			string expr = slot.Expr;
+			slot.Expr = null;
+			FlushCodes.Add(GenAssign(TempName(slot), expr, (StackType?)null));
 		}
 
 		private void AddBranch(int target)
 		{
+			Debug.Assert(Forwards.Count == 0);
 			Branches.Enqueue(new Tuple<Stack<StackType>, int>(
 				new Stack<StackType>(TypeStack.Reverse()),
 				target));
@@ -259,6 +537,10 @@ namespace il2cpp
 
 		private void GenFuncDef(CodePrinter prt, string prefix, TypeSig arg0Type = null)
 		{
+			// 隐式空检查只转换生成代码段内的访问错误
+			if (GenContext.IsImplicitNullCheck)
+				prt.Append("IL2CPP_CODE_SECTION ");
+
 			// 函数签名
 			prt.AppendFormat("{0} {1}(",
 				GenContext.GetTypeName(CurrMethod.ReturnType),
@@ -280,8 +562,8 @@ namespace il2cpp
 				}
 
 				prt.AppendFormat("{0} {1}",
-					GenContext.GetTypeName(argType),
-					ArgName(i));
+					GenContext.GetArgTypeName(argType),
+					ArgCopies != null && ArgCopies.Contains(i) ? ArgRefName(i) : ArgName(i));
 			}
 
 			prt.Append(")");
@@ -298,7 +580,7 @@ namespace il2cpp
 					prt.Append(",");
 
 				var argType = CurrMethod.ParamTypes[i];
-				prt.Append(GenContext.GetTypeName(argType));
+				prt.Append(GenContext.GetArgTypeName(argType));
 			}
 
 			prt.Append(")");
@@ -306,7 +588,9 @@ namespace il2cpp
 
 		public void Generate()
 		{
+			ArgCopies = CollectArgCopies();
 			GenerateMet();
+			ArgCopies = null;
 			GenerateWrap();
 			GenerateVFtn();
 			GenerateVMet();
@@ -324,7 +608,8 @@ namespace il2cpp
 				// 静态构造实现
 				string onceFuncName = string.Format("once_{0}",
 					GenContext.GetMethodName(CurrMethod, PrefixMet));
-				prt.AppendFormatLine("static void {0}()",
+				prt.AppendFormatLine("static {0}void {1}()",
+					GenContext.IsImplicitNullCheck ? "IL2CPP_CODE_SECTION " : null,
 					onceFuncName);
 				prt.AppendLine("{");
 				++prt.Indents;
@@ -353,40 +638,224 @@ namespace il2cpp
 			}
 			else
 			{
+				if (IsThrowOnlyMethod(CurrMethod))
+					prt.Append("IL2CPP_THROW_METHOD ");
 				GenFuncDef(prt, PrefixMet);
-				DeclCode += prt + ";\n";
+				string strDecl = prt.ToString();
 
 				CodePrinter prt2 = new CodePrinter();
 				prt2.AppendLine("\n{");
 				++prt2.Indents;
 
-				bool isGen = GenMethodImpl(prt2);
+				bool isGen;
+				if (CurrMethod.SharedMethod != null)
+				{
+					GenSharedForward(prt2);
+					isGen = true;
+				}
+				else
+					isGen = GenMethodImpl(prt2);
 
 				--prt2.Indents;
 				prt2.AppendLine("}");
 
 				if (isGen)
 				{
-					prt.Append(prt2.ToString());
+					// 折叠键相同的方法只保留一份, 其余在声明处重定向
+					string metName = GenContext.GetMethodName(CurrMethod, PrefixMet);
+					string strImpl = prt2.ToString();
+					var foldImpl = GenContext.FoldMethodImpl(GenFoldKey(strImpl), metName, strDecl);
+
+					if (foldImpl != null)
+					{
+						string foldName = foldImpl.Item1;
+						string foldDecl = foldImpl.Item2;
+						DeclCode += foldDecl + ";\n";
+
+						if (foldDecl.Replace(foldName + '(', "(") == strDecl.Replace(metName + '(', "("))
+							DeclCode += string.Format("#define {0} {1}\n", metName, foldName);
+						else
+						{
+							// 引用类型参数不同时按自身签名转换函数指针
+							CodePrinter prtType = new CodePrinter();
+							GenFuncType(prtType);
+							DeclCode += string.Format("#define {0} (*({1})&{2})\n", metName, prtType, foldName);
+						}
+						return;
+					}
+
+					prt.Append(strImpl);
 					ImplCode += prt;
 				}
+				else if (Helper.IsExtern(CurrMethod.Def))
+					GenMissingNative(strDecl);
+				DeclCode += strDecl + ";\n";
 			}
 		}
 
+		private string GenFoldKey(string strImpl)
+		{
+			// 委托目标与终结器的地址需要保持唯一
+			if (CurrMethod.IsAddressTaken ||
+				CurrMethod.IsVirtual && CurrMethod.Def.Name == "Finalize" && CurrMethod.ParamTypes.Count == 1)
+				return null;
+
+			CodePrinter prt = new CodePrinter();
+			if (IsThrowOnlyMethod(CurrMethod))
+				prt.Append("IL2CPP_THROW_METHOD ");
+			// 构造只与构造折叠
+			if (CurrMethod.Def.IsConstructor)
+				prt.Append(".ctor ");
+
+			prt.AppendFormat("{0} (",
+				GenContext.GetTypeName(CurrMethod.ReturnType));
+
+			for (int i = 0, sz = CurrMethod.ParamTypes.Count; i < sz; ++i)
+			{
+				if (i != 0)
+					prt.Append(", ");
+
+				var argType = CurrMethod.ParamTypes[i];
+				string argName = ArgCopies != null && ArgCopies.Contains(i) ? ArgRefName(i) : ArgName(i);
+
+				// 实现中只经由类型转换使用的引用类型参数, 统一为对象指针
+				string argTypeName;
+				if (ToStackType(argType).Kind == StackTypeKind.Obj &&
+					!Regex.IsMatch(strImpl, @"[&*]\s*" + argName + @"\b|\b" + argName + @"\s*(->|\[|\.)"))
+				{
+					argTypeName = "cls_Object*";
+				}
+				else
+					argTypeName = GenContext.GetArgTypeName(argType);
+
+				prt.AppendFormat("{0} {1}", argTypeName, argName);
+			}
+
+			prt.Append(")");
+			prt.Append(strImpl);
+			return prt.ToString();
+		}
+
+		private void GenMissingNative(string strDecl)
+		{
+			// 运行时未实现的外部方法, 调用时报告方法名后终止
+			CodePrinter prt = new CodePrinter();
+			prt.AppendLine("#if defined(IL2CPP_NATIVE_STUB)");
+			prt.AppendFormatLine("IL2CPP_NATIVE_STUB {0}", strDecl);
+			prt.AppendLine("{");
+			++prt.Indents;
+			prt.AppendFormatLine("il2cpp_MissingNative(\"{0}::{1}\");",
+				CurrMethod.DeclType.GetNameKey(),
+				CurrMethod.GetNameKey());
+			--prt.Indents;
+			prt.AppendLine("}");
+			prt.AppendLine("#endif");
+			ImplCode += prt;
+		}
+
+		private HashSet<int> CollectArgCopies()
+		{
+			var instList = CurrMethod.InstList;
+			if (instList == null || CurrMethod.SharedMethod != null)
+				return null;
+
+			HashSet<int> copies = null;
+			foreach (var inst in instList)
+			{
+				switch (inst.OpCode.Code)
+				{
+					case Code.Starg:
+					case Code.Starg_S:
+					case Code.Ldarga:
+					case Code.Ldarga_S:
+						int argID = ((Parameter)inst.Operand).Index;
+						if (GenContext.IsArgPassByRef(CurrMethod.ParamTypes[argID]))
+						{
+							if (copies == null)
+								copies = new HashSet<int>();
+							copies.Add(argID);
+						}
+						break;
+				}
+			}
+			return copies;
+		}
+
+		// 转发到布局一致的共享实例
+		private void GenSharedForward(CodePrinter prt)
+		{
+			var sharedMetX = CurrMethod.SharedMethod;
+			RefTypeImpl(sharedMetX.DeclType);
+
+			StringBuilder sb = new StringBuilder();
+			sb.AppendFormat("{0}(", GenContext.GetMethodName(sharedMetX, PrefixMet));
+			for (int i = 0, sz = CurrMethod.ParamTypes.Count; i < sz; ++i)
+			{
+				if (i != 0)
+					sb.Append(", ");
+				sb.Append(GenSharedCast(CurrMethod.ParamTypes[i], sharedMetX.ParamTypes[i], ArgName(i)));
+			}
+			sb.Append(')');
+
+			var retType = CurrMethod.ReturnType;
+			if (retType.ElementType == ElementType.Void)
+				prt.AppendLine(sb + ";");
+			else if (IsSharedValueCast(retType, sharedMetX.ReturnType))
+			{
+				prt.AppendFormatLine("auto ret = {0};", sb);
+				prt.AppendFormatLine("return {0};",
+					GenSharedCast(sharedMetX.ReturnType, retType, "ret"));
+			}
+			else
+			{
+				prt.AppendFormatLine("return {0};",
+					GenSharedCast(sharedMetX.ReturnType, retType, sb.ToString()));
+			}
+		}
+
+		private string GenSharedCast(TypeSig fromType, TypeSig toType, string expr)
+		{
+			string toName = GenContext.GetTypeName(toType);
+			if (GenContext.GetTypeName(fromType) == toName)
+				return expr;
+
+			// 布局一致的泛型结构体按内存重新解释
+			if (IsSharedValueCast(fromType, toType))
+			{
+				RefValueTypeImpl(fromType);
+				RefValueTypeImpl(toType);
+				return string.Format("*({0}*)&{1}", toName, expr);
+			}
+			return string.Format("({0}){1}", toName, expr);
+		}
+
+		private bool IsSharedValueCast(TypeSig fromType, TypeSig toType)
+		{
+			return toType.IsValueType &&
+				   GenContext.GetTypeName(fromType) != GenContext.GetTypeName(toType) &&
+				   !Helper.IsEnumType(toType, out _);
+		}
+
 		private bool GenMethodImpl(CodePrinter prt)
 		{
 			var instList = CurrMethod.InstList;
+			CurrLandingPad = null;
 			if (instList == null)
 			{
 				// 生成内部实现
-				Debug.Assert(!CurrMethod.Def.HasBody);
+				Debug.Assert(!CurrMethod.Def.HasBody || RuntimeInternals.IsReplacedMethod(CurrMethod));
 				return GenerateRuntimeImpl(prt);
 			}
 
+			RangeCheckAnalyzer.Analyze(CurrMethod);
+			AddrTakenVars = CollectAddrTakenVars(instList);
+			DeclRowHoists(instList);
+			DeclStaticArrays(instList);
+
 			// 添加异常处理块分支
 			if (CurrMethod.ExHandlerList.IsCollectionValid())
 			{
-				Push(StackType.Obj);
+				AddSlotMap(Push(StackType.Obj));
 				foreach (var handler in CurrMethod.ExHandlerList)
 				{
 					foreach (var chandler in handler.CombinedHandlers)
@@ -409,6 +878,7 @@ namespace il2cpp
 					{
 						var branch = Branches.Dequeue();
 						TypeStack = branch.Item1;
+						Forwards.Clear();
 						currIP = branch.Item2;
 					}
 					else
@@ -442,7 +912,28 @@ namespace il2cpp
 				}
 
 				if (isGen)
+				{
 					prt.Append(GenInvokeStaticCctor(CurrMethod.DeclType));
+					if (GenContext.IsStatusException)
+					{
+						CurrLandingPad = null;
+						prt.AppendLine(GenPendingCheck());
+					}
+				}
+			}
+
+			// 参数副本
+			if (ArgCopies != null)
+			{
+				prt.AppendLine("// args");
+				foreach (int argID in ArgCopies.OrderBy(id => id))
+				{
+					prt.AppendFormatLine("{0} {1} = {2};",
+						GenContext.GetTypeName(CurrMethod.ParamTypes[argID]),
+						ArgName(argID),
+						ArgRefName(argID));
+				}
+				prt.AppendLine();
 			}
 
 			// 局部变量
@@ -478,15 +969,65 @@ namespace il2cpp
 				prt.AppendLine();
 			}
 
+			// 循环提升变量
+			if (HoistDecls != null)
+			{
+				prt.AppendLine("// hoisted");
+				foreach (string decl in HoistDecls)
+					prt.AppendLine(decl);
+				prt.AppendLine();
+			}
+
+			// 只读数组对象
+			if (StaticArrayDecls != null)
+			{
+				prt.AppendLine("// static arrays");
+				foreach (string decl in StaticArrayDecls)
+					prt.AppendLine(decl);
+				prt.AppendLine();
+			}
+
 			// 构造异常辅助变量
 			if (CurrMethod.ExHandlerList.IsCollectionValid())
 			{
 				prt.AppendLine("// exceptions");
 				prt.AppendLine("cls_Object* lastException = nullptr;");
 				prt.AppendLine("int leaveTarget = 0;");
+				var handlerList = CurrMethod.ExHandlerList;
+				for (int i = 0; i < handlerList.Count; ++i)
+				{
+					var handler = handlerList[i];
+					if (handler.HandlerType != ExceptionHandlerType.Finally &&
+						handler.HandlerType != ExceptionHandlerType.Fault)
+						continue;
+					if (!HasNestedHandlers(handler))
+						continue;
+
+					// 嵌套异常块会覆盖辅助变量, 进入处理块时另存一份
+					prt.AppendFormatLine("cls_Object* finallyException_{0} = nullptr;", i);
+					if (handler.HandlerType == ExceptionHandlerType.Finally)
+						prt.AppendFormatLine("int finallyLeave_{0} = 0;", i);
+				}
 				prt.AppendLine();
 			}
 
+			// 异常处理块只在抛出时进入
+			HashSet<int> coldLabels = null;
+			if (CurrMethod.ExHandlerList.IsCollectionValid())
+			{
+				coldLabels = new HashSet<int>();
+				foreach (var handler in CurrMethod.ExHandlerList)
+				{
+					foreach (var chandler in handler.CombinedHandlers)
+					{
+						if (chandler.HandlerType != ExceptionHandlerType.Finally)
+							coldLabels.Add(chandler.HandlerOrFilterStart);
+						if (chandler.HandlerType == ExceptionHandlerType.Filter)
+							coldLabels.Add(chandler.HandlerStart);
+					}
+				}
+			}
+
 			// 生成代码体
 			foreach (var inst in instList)
 			{
@@ -495,7 +1036,10 @@ namespace il2cpp
 				if (inst.IsBrTarget)
 				{
 					--prt.Indents;
-					prt.AppendLine(LabelName(inst.Offset) + ':');
+					if (coldLabels != null && coldLabels.Contains(inst.Offset))
+						prt.AppendLine(LabelName(inst.Offset) + ": IL2CPP_COLD_LABEL;");
+					else
+						prt.AppendLine(LabelName(inst.Offset) + ':');
 					++prt.Indents;
 				}
 
@@ -749,9 +1293,7 @@ namespace il2cpp
 				{
 					if (isSZArray)
 					{
-						prt.AppendFormatLine("IL2CPP_CHECK_RANGE(0, {0}->Length, {1});",
-							ArgName(0),
-							ArgName(1));
+						prt.AppendLine(GenCheckSZRange(ArgName(0) + "->Length", ArgName(1)));
 						prt.AppendFormatLine("return (({0}*)(&{1}[1]))[{2}];",
 							GenContext.GetTypeName(elemType),
 							ArgName(0),
@@ -773,9 +1315,7 @@ namespace il2cpp
 				{
 					if (isSZArray)
 					{
-						prt.AppendFormatLine("IL2CPP_CHECK_RANGE(0, {0}->Length, {1});",
-							ArgName(0),
-							ArgName(1));
+						prt.AppendLine(GenCheckSZRange(ArgName(0) + "->Length", ArgName(1)));
 						prt.AppendFormatLine("(({0}*)(&{1}[1]))[{2}] = {3};",
 							GenContext.GetTypeName(elemType),
 							ArgName(0),
@@ -799,9 +1339,7 @@ namespace il2cpp
 				{
 					if (isSZArray)
 					{
-						prt.AppendFormatLine("IL2CPP_CHECK_RANGE(0, {0}->Length, {1});",
-							ArgName(0),
-							ArgName(1));
+						prt.AppendLine(GenCheckSZRange(ArgName(0) + "->Length", ArgName(1)));
 						prt.AppendFormatLine("return &(({0}*)(&{1}[1]))[{2}];",
 							GenContext.GetTypeName(elemType),
 							ArgName(0),
@@ -863,7 +1401,7 @@ namespace il2cpp
 							last = true;
 
 							var argType = CurrMethod.ParamTypes[i];
-							prt.Append(GenContext.GetTypeName(argType));
+							prt.Append(GenContext.GetArgTypeName(argType));
 						}
 
 						prt.AppendFormat("))arg_0->{0})({1}",
@@ -897,36 +1435,25 @@ namespace il2cpp
 
 		private void GenerateMDArrayIndex(CodePrinter prt, uint rank)
 		{
+			// 按无符号偏移检查各维, 下界为 0 时与一维数组的检查相同
 			for (int i = 0; i < rank; ++i)
 			{
-				prt.AppendFormatLine("IL2CPP_CHECK_RANGE({0}->LowerBound{1}, {0}->Size{1}, {2});",
+				prt.AppendFormatLine("int32_t off{2} = (int32_t)((uint32_t){1} - (uint32_t){0}->LowerBound{2});",
 					ArgName(0),
-					i,
-					ArgName(i + 1));
+					ArgName(i + 1),
+					i);
+				prt.AppendLine(GenCheckSZRange(
+					string.Format("{0}->Size{1}", ArgName(0), i),
+					"off" + i));
 			}
 
-			prt.AppendLine("uint64_t index =");
-			++prt.Indents;
-			for (int i = 0; i < rank; ++i)
+			prt.AppendLine("uintptr_t index = (uint32_t)off0;");
+			for (int i = 1; i < rank; ++i)
 			{
-				prt.AppendFormat("({0} - {1}->LowerBound{2})",
-					ArgName(i + 1),
+				prt.AppendFormatLine("index = index * {0}->Size{1} + (uint32_t)off{1};",
 					ArgName(0),
 					i);
-
-				for (int j = i + 1; j < rank; ++j)
-				{
-					prt.AppendFormat(" * {0}->Size{1}",
-						ArgName(0),
-						j);
-				}
-
-				if (i == rank - 1)
-					prt.AppendLine(";");
-				else
-					prt.AppendLine(" +");
 			}
-			--prt.Indents;
 		}
 
 		private void GenExHandlerStart(InstInfo inst, CodePrinter prt)
@@ -941,7 +1468,7 @@ namespace il2cpp
 			{
 				if (offset == handler.TryStart)
 				{
-					prt.AppendLine("try\n{");
+					prt.AppendLine(GenContext.IsStatusException ? "{" : "try\n{");
 					++prt.Indents;
 				}
 				foreach (var chandler in handler.CombinedHandlers)
@@ -963,42 +1490,87 @@ namespace il2cpp
 							prt.AppendLine("{");
 							++prt.Indents;
 						}
+						else if (HasNestedHandlers(chandler))
+						{
+							int idx = handlerList.IndexOf(handler);
+							prt.AppendFormatLine("finallyException_{0} = lastException;", idx);
+							if (chandler.HandlerType == ExceptionHandlerType.Finally)
+								prt.AppendFormatLine("finallyLeave_{0} = leaveTarget;", idx);
+						}
 					}
 				}
+			}
 
-				if (offset >= handler.HandlerStart && offset < handler.HandlerEnd &&
-					inst.OpCode.Code == Code.Endfinally)
+			if (inst.OpCode.Code == Code.Endfinally)
+			{
+				// 只处理包含该指令的最内层 finally/fault
+				ExHandlerInfo handler = null;
+				foreach (var info in handlerList)
 				{
-					if (handler.HandlerType == ExceptionHandlerType.Finally)
+					if (offset >= info.HandlerStart && offset < info.HandlerEnd &&
+						(info.HandlerType == ExceptionHandlerType.Finally || info.HandlerType == ExceptionHandlerType.Fault))
 					{
-						prt.AppendLine("if (lastException) IL2CPP_THROW(lastException);");
-
-						if (handler.LeaveTargets.IsCollectionValid())
-						{
-							prt.AppendLine("switch (leaveTarget)\n{");
-							++prt.Indents;
+						handler = info;
+					}
+				}
+				Debug.Assert(handler != null);
 
-							List<int> leaveTargets = new List<int>(handler.LeaveTargets);
-							leaveTargets.Sort((lhs, rhs) => LeaveMap[lhs].CompareTo(LeaveMap[rhs]));
-							foreach (int target in leaveTargets)
-							{
-								prt.AppendFormatLine("case {0}: {1}",
-									LeaveMap[target],
-									GenGoto(target));
-							}
+				// 处理块内有嵌套的异常块时, 使用进入时保存的状态
+				string strException = "lastException";
+				string strLeave = "leaveTarget";
+				if (HasNestedHandlers(handler))
+				{
+					int idx = handlerList.IndexOf(handler);
+					strException = "finallyException_" + idx;
+					strLeave = "finallyLeave_" + idx;
+				}
 
-							--prt.Indents;
-							prt.AppendLine("}");
-						}
-						prt.AppendLine("IL2CPP_TRAP;");
-					}
+				CurrLandingPad = GetLandingPad(offset);
+				if (handler.HandlerType == ExceptionHandlerType.Finally)
+				{
+					// 正常离开时没有待抛出的异常
+					if (GenContext.IsStatusException)
+						prt.AppendFormatLine("if (IL2CPP_UNLIKELY({0}))\n{{\n\t{1}\n}}", strException, GenThrowCode(strException).Replace("\n", "\n\t"));
 					else
+						prt.AppendFormatLine("if (IL2CPP_UNLIKELY({0})) IL2CPP_THROW({0});", strException);
+
+					if (handler.LeaveTargets.IsCollectionValid())
 					{
-						Debug.Assert(handler.HandlerType == ExceptionHandlerType.Fault);
-						prt.AppendLine("IL2CPP_THROW(lastException);");
+						prt.AppendFormatLine("switch ({0})\n{{", strLeave);
+						++prt.Indents;
+
+						List<int> leaveTargets = new List<int>(handler.LeaveTargets);
+						leaveTargets.Sort((lhs, rhs) => LeaveMap[lhs].CompareTo(LeaveMap[rhs]));
+						foreach (int target in leaveTargets)
+						{
+							// 嵌套的 finally 由内向外依次执行
+							var outerHandler = GetOuterLeaveHandler(handler, target);
+							prt.AppendFormatLine("case {0}: {1}",
+								LeaveMap[target],
+								GenGoto(outerHandler != null ? outerHandler.HandlerStart : target));
+						}
+
+						--prt.Indents;
+						prt.AppendLine("}");
 					}
+					prt.AppendLine("IL2CPP_TRAP;");
 				}
+				else
+				{
+					prt.AppendLine(GenThrowCode(strException));
+				}
+			}
+		}
+
+		// finally/fault 处理块内是否还有异常块, 其中的 leave 与 catch 会覆盖异常辅助变量
+		private bool HasNestedHandlers(ExHandlerInfo handler)
+		{
+			foreach (var info in CurrMethod.ExHandlerList)
+			{
+				if (info.TryStart >= handler.HandlerStart && info.TryStart < handler.HandlerEnd)
+					return true;
 			}
+			return false;
 		}
 
 		private void GenExHandlerEnd(int offset, CodePrinter prt)
@@ -1027,7 +1599,8 @@ namespace il2cpp
 							if (i == sz - 1)
 							{
 								// 最后一项往上抛异常
-								prt.AppendLine("IL2CPP_THROW(lastException);");
+								CurrLandingPad = GetLandingPad(chandler.HandlerStart);
+								prt.AppendLine(GenThrowCode("lastException"));
 							}
 							else
 							{
@@ -1041,21 +1614,129 @@ namespace il2cpp
 
 				if (offset == info.TryEnd)
 				{
-					--prt.Indents;
-					prt.AppendLine("}\ncatch (il2cppException& ex)\n{");
-					++prt.Indents;
+					if (GenContext.IsStatusException)
+					{
+						// try 块内的检查跳到此处取出待处理异常
+						--prt.Indents;
+						prt.AppendLine("}");
+						--prt.Indents;
+						prt.AppendLine(LandingPadName(hlist.IndexOf(info)) + ": IL2CPP_COLD_LABEL;");
+						++prt.Indents;
 
-					prt.AppendLine("lastException = ex.ExceptionPtr;");
-					prt.AppendLine(GenAssign(TempName(0, StackType.Obj), "lastException", StackType.Obj));
+						prt.AppendLine("lastException = il2cpp_TakePendingException();");
+						prt.AppendLine(GenAssign(TempName(0, StackType.Obj), "lastException", StackType.Obj));
+					}
+					else
+					{
+						--prt.Indents;
+						prt.AppendLine("}\ncatch (il2cppException& ex)\n{");
+						++prt.Indents;
 
-					--prt.Indents;
-					prt.AppendLine("}");
+						prt.AppendLine("lastException = ex.ExceptionPtr;");
+						prt.AppendLine(GenAssign(TempName(0, StackType.Obj), "lastException", StackType.Obj));
+
+						--prt.Indents;
+						prt.AppendLine("}");
+					}
 
 					prt.AppendLine(GenGoto(info.HandlerOrFilterStart));
 				}
 			}
 		}
 
+		// 状态返回模式下, 包含指令偏移的最内层 try 块的着陆点
+		private string GetLandingPad(int offset)
+		{
+			var hlist = CurrMethod.ExHandlerList;
+			if (!hlist.IsCollectionValid())
+				return null;
+
+			int found = -1;
+			for (int i = 0; i < hlist.Count; ++i)
+			{
+				var info = hlist[i];
+				if (offset < info.TryStart || offset >= info.TryEnd)
+					continue;
+
+				if (found == -1 ||
+					info.TryEnd - info.TryStart < hlist[found].TryEnd - hlist[found].TryStart)
+					found = i;
+			}
+			return found == -1 ? null : LandingPadName(found);
+		}
+
+		private static string LandingPadName(int index)
+		{
+			return "LP_" + index;
+		}
+
+		// 离开当前位置: 跳到所在 try 块的着陆点, 或者以默认值返回
+		private string GenUnwind()
+		{
+			if (CurrLandingPad != null)
+				return "goto " + CurrLandingPad;
+			return CurrMethod.ReturnType.ElementType == ElementType.Void ? "return" : "return {}";
+		}
+
+		private string GenPendingCheck()
+		{
+			return string.Format("if (IL2CPP_PENDING_EXCEPTION) {0};", GenUnwind());
+		}
+
+		private string GenThrowCode(string exObj)
+		{
+			string code = string.Format("IL2CPP_THROW({0});", exObj);
+			if (GenContext.IsStatusException)
+				code += '\n' + GenUnwind() + ';';
+			return code;
+		}
+
+		public string GenCheckSZRange(string length, string index)
+		{
+			if (GenContext.IsStatusException)
+				return string.Format("IL2CPP_CHECK_SZRANGE_OR({0}, {1}, {2});", length, index, GenUnwind());
+			return string.Format("IL2CPP_CHECK_SZRANGE({0}, {1});", length, index);
+		}
+
+		private bool NeedPendingCheck(InstInfo inst)
+		{
+			var code = inst.OpCode.Code;
+			switch (code)
+			{
+				case Code.Call:
+				case Code.Callvirt:
+					// 展开的数组访问自带检查
+					return inst.StaticArray == null && !inst.IsRangeSafe &&
+						inst.RowHoist == null && !inst.IsZeroLowerBound;
+
+				case Code.Calli:
+				case Code.Newobj:
+					return inst.StaticArray == null;
+
+				case Code.Castclass:
+				case Code.Unbox:
+				case Code.Unbox_Any:
+				case Code.Ckfinite:
+				case Code.Add_Ovf:
+				case Code.Add_Ovf_Un:
+				case Code.Sub_Ovf:
+				case Code.Sub_Ovf_Un:
+				case Code.Mul_Ovf:
+				case Code.Mul_Ovf_Un:
+					return true;
+
+				case Code.Ldsfld:
+				case Code.Ldsflda:
+				case Code.Stsfld:
+					{
+						// 可能调用静态构造
+						FieldX fldX = (FieldX)inst.Operand;
+						return fldX.DeclType != CurrMethod.DeclType && fldX.DeclType.CctorMethod != null;
+					}
+			}
+			return inst.OpCode.Name.StartsWith("conv.ovf");
+		}
+
 		private string GenInvokeStaticCctor(TypeX tyX)
 		{
 			MethodX cctor = tyX.CctorMethod;
@@ -1071,9 +1752,47 @@ namespace il2cpp
 			inst.IsGenerated = true;
 
 			PushCount = PopCount = 0;
+			CurrIP = currIP;
+			CurrFold = GetFoldKind(inst);
+			FlushCodes = new List<string>();
+
+			if (GenContext.IsStatusException)
+				CurrLandingPad = GetLandingPad(inst.Offset);
 
 			GenerateInstCode(inst);
 
+			// 跳转前与汇合点前, 栈上剩余的表达式都要写入临时变量
+			var flowCtrl = inst.OpCode.FlowControl;
+			if (flowCtrl == FlowControl.Branch || flowCtrl == FlowControl.Cond_Branch)
+				FlushAllForwards(FlushCodes);
+			if (FlushCodes.Count > 0)
+			{
+				if (inst.InstCode != null)
+					FlushCodes.Add(inst.InstCode);
+				inst.InstCode = string.Join("\n", FlushCodes);
+			}
+			if (flowCtrl != FlowControl.Return && flowCtrl != FlowControl.Throw && flowCtrl != FlowControl.Branch)
+			{
+				var instList = CurrMethod.InstList;
+				if (currIP + 1 < instList.Length && instList[currIP + 1].IsBrTarget)
+				{
+					var suffixCodes = new List<string>();
+					FlushAllForwards(suffixCodes);
+					if (suffixCodes.Count > 0)
+					{
+						if (inst.InstCode != null)
+							suffixCodes.Insert(0, inst.InstCode);
+						inst.InstCode = string.Join("\n", suffixCodes);
+					}
+				}
+			}
+
+			if (GenContext.IsStatusException && NeedPendingCheck(inst))
+				inst.InstCode += '\n' + GenPendingCheck();
+
+			if (inst.RangeHoists != null)
+				inst.InstCode = GenRangeHoists(inst.RangeHoists) + inst.InstCode;
+
 			var opCode = inst.OpCode;
 			var operand = inst.Operand;
 
@@ -1209,10 +1928,16 @@ namespace il2cpp
 					return;
 
 				case Code.Call:
-					inst.InstCode = GenCall((MethodX)operand);
+					if (!GenStaticArray(inst) &&
+						!GenStringConcat(inst, (MethodX)operand) &&
+						!GenRangeSafeAccess(inst, (MethodX)operand) &&
+						!GenMDArrayAccess(inst, (MethodX)operand))
+						inst.InstCode = GenCall((MethodX)operand);
 					return;
 				case Code.Callvirt:
-					inst.InstCode = GenCall((MethodX)operand, true);
+					if (!GenRangeSafeAccess(inst, (MethodX)operand) &&
+						!GenMDArrayAccess(inst, (MethodX)operand))
+						inst.InstCode = GenCall((MethodX)operand, true);
 					return;
 				case Code.Constrained:
 					ConstrainedType = (TypeX)operand;
@@ -1395,7 +2120,10 @@ namespace il2cpp
 				case Code.Cgt_Un:
 				case Code.Clt:
 				case Code.Clt_Un:
-					GenLdc(inst, StackType.I4, '(' + GenCompareCond(inst.OpCode) + " ? 1 : 0)");
+					{
+						string cond = GenCompareCond(inst.OpCode, out bool isForward);
+						GenPushExpr(inst, Push(StackType.I4), '(' + cond + " ? 1 : 0)", isForward, StackType.I4.GetTypeName());
+					}
 					return;
 
 				case Code.Conv_I1:
@@ -1529,22 +2257,22 @@ namespace il2cpp
 					return;
 
 				case Code.Add_Ovf:
-					GenBinOpFunc(inst, "IL2CPP_ADD_OVF");
+					GenBinOpFunc(inst, "IL2CPP_ADD_OVF", false, true);
 					return;
 				case Code.Add_Ovf_Un:
-					GenBinOpFunc(inst, "IL2CPP_ADD_OVF", true);
+					GenBinOpFunc(inst, "IL2CPP_ADD_OVF", true, true);
 					return;
 				case Code.Sub_Ovf:
-					GenBinOpFunc(inst, "IL2CPP_SUB_OVF");
+					GenBinOpFunc(inst, "IL2CPP_SUB_OVF", false, true);
 					return;
 				case Code.Sub_Ovf_Un:
-					GenBinOpFunc(inst, "IL2CPP_SUB_OVF", true);
+					GenBinOpFunc(inst, "IL2CPP_SUB_OVF", true, true);
 					return;
 				case Code.Mul_Ovf:
-					GenBinOpFunc(inst, "IL2CPP_MUL_OVF");
+					GenBinOpFunc(inst, "IL2CPP_MUL_OVF", false, true);
 					return;
 				case Code.Mul_Ovf_Un:
-					GenBinOpFunc(inst, "IL2CPP_MUL_OVF", true);
+					GenBinOpFunc(inst, "IL2CPP_MUL_OVF", true, true);
 					return;
 
 				case Code.And:
@@ -1574,7 +2302,8 @@ namespace il2cpp
 					return;
 
 				case Code.Newobj:
-					GenNewobj(inst, (MethodX)operand);
+					if (!GenStaticArray(inst))
+						GenNewobj(inst, (MethodX)operand);
 					return;
 
 				case Code.Box:
@@ -1694,7 +2423,7 @@ namespace il2cpp
 					GenThrow(inst);
 					return;
 				case Code.Rethrow:
-					inst.InstCode = "IL2CPP_THROW(lastException);";
+					inst.InstCode = GenThrowCode("lastException");
 					return;
 
 				case Code.Endfilter:
@@ -1703,6 +2432,7 @@ namespace il2cpp
 
 				case Code.Endfinally:
 					TypeStack.Clear();
+					Forwards.Clear();
 					return;
 
 				case Code.Leave:
@@ -1715,6 +2445,23 @@ namespace il2cpp
 					switch (operand)
 					{
 						case TypeX opTyX:
+							{
+								TypeX rtTyHandle = GenContext.TypeMgr.RTTypeHandle;
+								Debug.Assert(rtTyHandle != null);
+								FieldX rtTyHandleFld = rtTyHandle.Fields.First(fld => !fld.IsStatic);
+
+								var slotPush = Push(new StackType(GenContext.GetTypeName(rtTyHandle)));
+
+								// 值类型使用装箱类型的 ID, 与 GetType 的结果一致. 未装箱过的值类型不会有实例
+								TypeX idTyX = opTyX.IsValueType && opTyX.BoxedType != null ? opTyX.BoxedType : opTyX;
+								inst.InstCode = GenAssign(
+									string.Format("{0}.{1}",
+										TempName(slotPush),
+										GenContext.GetFieldName(rtTyHandleFld)),
+									RuntimeInternals.GenRuntimeTypeObject(this, GenContext.GetTypeID(idTyX).ToString()),
+									rtTyHandleFld.FieldType);
+							}
+							break;
 						case TypeDef opTyDef:
 						case TypeSpec opTySpec:
 							GenLoad(inst, new StackType("stru_System_RuntimeTypeHandle"), "{}");
@@ -1799,14 +2546,20 @@ namespace il2cpp
 		private void GenLdc(InstInfo inst, StackType stype, string val)
 		{
 			var slotPush = Push(stype);
-			inst.InstCode = GenAssign(TempName(slotPush), val, stype);
+			// 十进制整数常量本身就是 int32_t
+			string valType = stype.Kind == StackTypeKind.I4 && val.TrimStart('-').All(char.IsDigit) ? stype.GetTypeName() : null;
+			GenPushExpr(inst, slotPush, val, true, valType, false);
 		}
 
 		private void GenLdstr(InstInfo inst, string str)
+		{
+			GenLdc(inst, StackType.Obj, GenStringLiteral(str));
+		}
+
+		public string GenStringLiteral(string str)
 		{
 			StringDepends.Add(str);
-			string constName = GenContext.StrGen.AddString(str);
-			GenLdc(inst, StackType.Obj, "&" + constName);
+			return GenContext.StrGen.AddString(str);
 		}
 
 		private void GenLdarg(InstInfo inst, int argID, bool isAddr = false)
@@ -1815,7 +2568,12 @@ namespace il2cpp
 			var argType = CurrMethod.ParamTypes[argID];
 			RefValueTypeImpl(argType);
 			var slotPush = isAddr ? Push(StackType.Ptr) : Push(ToStackType(argType));
-			inst.InstCode = GenAssign(TempName(slotPush), (isAddr ? "&" : null) + ArgName(argID), slotPush.SlotType);
+			GenPushExpr(inst,
+				slotPush,
+				(isAddr ? "&" : null) + ArgName(argID),
+				isAddr || !AddrTakenVars.Contains(ArgName(argID)),
+				isAddr ? null : GenContext.GetTypeName(argType),
+				false);
 		}
 
 		private void GenStarg(InstInfo inst, int argID)
@@ -1824,6 +2582,7 @@ namespace il2cpp
 			var argType = CurrMethod.ParamTypes[argID];
 			RefValueTypeImpl(argType);
 			var slotPop = Pop();
+			FlushForwardsReading(ArgName(argID));
 			inst.InstCode = GenAssign(ArgName(argID), TempName(slotPop), argType);
 		}
 
@@ -1833,7 +2592,12 @@ namespace il2cpp
 			var locType = CurrMethod.LocalTypes[locID];
 			RefValueTypeImpl(locType);
 			var slotPush = isAddr ? Push(StackType.Ptr) : Push(ToStackType(locType));
-			inst.InstCode = GenAssign(TempName(slotPush), (isAddr ? "&" : null) + LocalName(locID), slotPush.SlotType);
+			GenPushExpr(inst,
+				slotPush,
+				(isAddr ? "&" : null) + LocalName(locID),
+				isAddr || !AddrTakenVars.Contains(LocalName(locID)),
+				isAddr ? null : GenContext.GetTypeName(locType),
+				false);
 		}
 
 		private void GenStloc(InstInfo inst, int locID)
@@ -1842,9 +2606,30 @@ namespace il2cpp
 			var locType = CurrMethod.LocalTypes[locID];
 			RefValueTypeImpl(locType);
 			var slotPop = Pop();
+			FlushForwardsReading(LocalName(locID));
 			inst.InstCode = GenAssign(LocalName(locID), TempName(slotPop), locType);
 		}
 
+		private HashSet<string> CollectAddrTakenVars(IList<InstInfo> instList)
+		{
+			var vars = new HashSet<string>();
+			foreach (var inst in instList)
+			{
+				switch (inst.OpCode.Code)
+				{
+					case Code.Ldloca:
+					case Code.Ldloca_S:
+						vars.Add(LocalName(((Local)inst.Operand).Index));
+						break;
+					case Code.Ldarga:
+					case Code.Ldarga_S:
+						vars.Add(ArgName(((Parameter)inst.Operand).Index));
+						break;
+				}
+			}
+			return vars;
+		}
+
 		private void GenBrCond(InstInfo inst, int labelID, string cond)
 		{
 			inst.InstCode = "if (" + cond + ") " + GenGoto(labelID);
@@ -1882,10 +2667,11 @@ namespace il2cpp
 			if (cast == stype.GetTypeName())
 				cast = null;
 
-			inst.InstCode = GenAssign(
-				TempName(slotPush),
+			GenPushExpr(inst,
+				slotPush,
 				(cast != null ? '(' + cast + ')' : null) + TempName(slotPop),
-				stype);
+				IsForwardable(slotPop),
+				cast ?? slotPop.SlotType.GetTypeName());
 		}
 
 		private void GenConvR_Un(InstInfo inst)
@@ -1893,10 +2679,10 @@ namespace il2cpp
 			var slotPop = Pop();
 			var slotPush = Push(StackType.R8);
 
-			inst.InstCode = GenAssign(
-				TempName(slotPush),
+			GenPushExpr(inst,
+				slotPush,
 				'(' + slotPop.SlotType.GetUnsignedTypeName() + ')' + TempName(slotPop),
-				slotPush.SlotType);
+				IsForwardable(slotPop));
 		}
 
 		private void GenConvOvf(InstInfo inst, StackType stype, string cast, bool isUnsigned = false)
@@ -1928,10 +2714,16 @@ namespace il2cpp
 		}
 
 		private string GenCompareCond(OpCode opCode)
+		{
+			return GenCompareCond(opCode, out _);
+		}
+
+		private string GenCompareCond(OpCode opCode, out bool isForward)
 		{
 			var slotPops = Pop(2);
 			var slotLhs = slotPops[0];
 			var slotRhs = slotPops[1];
+			isForward = IsForwardable(slotLhs, slotRhs);
 
 			if (!IsBinaryCompareValid(slotLhs.SlotType.Kind, slotRhs.SlotType.Kind, opCode.Code))
 				throw new InvalidOperationException();
@@ -2129,7 +2921,7 @@ namespace il2cpp
 				slotPush.SlotType);
 		}
 
-		private void GenBinOpFunc(InstInfo inst, string func, bool isUnsigned = false)
+		private void GenBinOpFunc(InstInfo inst, string func, bool isUnsigned = false, bool isOverflow = false)
 		{
 			var slotPops = Pop(2);
 			var op1 = slotPops[0];
@@ -2139,15 +2931,28 @@ namespace il2cpp
 				throw new InvalidOperationException();
 
 			var slotPush = Push(new StackType(retType));
-			inst.InstCode = GenAssign(
-				TempName(slotPush),
+			// 溢出检查会抛出异常, 不能移动
+			GenPushExpr(inst,
+				slotPush,
 				string.Format("{0}({1}{2}, {3}{4})",
 					func,
 					isUnsigned ? '(' + op1.SlotType.GetUnsignedTypeName() + ')' : null,
 					TempName(op1),
 					isUnsigned ? '(' + op2.SlotType.GetUnsignedTypeName() + ')' : null,
 					TempName(op2)),
-				slotPush.SlotType);
+				!isOverflow && IsForwardable(op1, op2),
+				GetBinOpExprType(op1, op2, retType, isUnsigned));
+		}
+
+		// 同类数值运算的结果类型与栈类型一致, 无需再转换
+		private static string GetBinOpExprType(SlotInfo op1, SlotInfo op2, StackTypeKind retType, bool isUnsigned)
+		{
+			if (isUnsigned ||
+				op1.SlotType.Kind != op2.SlotType.Kind ||
+				op1.SlotType.Kind != retType ||
+				!IsNumericKind(retType))
+				return null;
+			return new StackType(retType).GetTypeName();
 		}
 
 		private void GenBinOp(InstInfo inst, string op, bool isUnsigned = false)
@@ -2160,15 +2965,17 @@ namespace il2cpp
 				throw new InvalidOperationException();
 
 			var slotPush = Push(new StackType(retType));
-			inst.InstCode = GenAssign(
-				TempName(slotPush),
+			// 除法可能触发除零异常, 不能移动
+			GenPushExpr(inst,
+				slotPush,
 				string.Format("({0}{1} {2} {3}{4})",
 					isUnsigned ? '(' + op1.SlotType.GetUnsignedTypeName() + ')' : null,
 					TempName(op1),
 					op,
 					isUnsigned ? '(' + op2.SlotType.GetUnsignedTypeName() + ')' : null,
 					TempName(op2)),
-				slotPush.SlotType);
+				op == "*" && IsForwardable(op1, op2),
+				GetBinOpExprType(op1, op2, retType, isUnsigned));
 		}
 
 		private void GenShiftOp(InstInfo inst, string op, bool isUnsigned = false)
@@ -2181,15 +2988,16 @@ namespace il2cpp
 				throw new InvalidOperationException();
 
 			var slotPush = Push(new StackType(retType));
-			inst.InstCode = GenAssign(
-				TempName(slotPush),
+			GenPushExpr(inst,
+				slotPush,
 				string.Format("({0}{1} {2} {3}{4})",
 					isUnsigned ? '(' + op1.SlotType.GetUnsignedTypeName() + ')' : null,
 					TempName(op1),
 					op,
 					isUnsigned ? '(' + op2.SlotType.GetUnsignedTypeName() + ')' : null,
 					TempName(op2)),
-				slotPush.SlotType);
+				IsForwardable(op1, op2),
+				!isUnsigned && op1.SlotType.Kind == retType && IsNumericKind(retType) ? new StackType(retType).GetTypeName() : null);
 		}
 
 		private void GenUnaryOp(InstInfo inst, string op)
@@ -2202,10 +3010,11 @@ namespace il2cpp
 				throw new InvalidOperationException();
 
 			var slotPush = Push(slotPop.SlotType);
-			inst.InstCode = GenAssign(
-				TempName(slotPush),
+			GenPushExpr(inst,
+				slotPush,
 				op + TempName(slotPop),
-				slotPush.SlotType);
+				IsForwardable(slotPop),
+				slotPush.SlotType.GetTypeName());
 		}
 
 		private void GenIntBinOp(InstInfo inst, string op)
@@ -2218,13 +3027,14 @@ namespace il2cpp
 				throw new InvalidOperationException();
 
 			var slotPush = Push(new StackType(retType));
-			inst.InstCode = GenAssign(
-				TempName(slotPush),
+			GenPushExpr(inst,
+				slotPush,
 				string.Format("({0} {1} {2})",
 					TempName(op1),
 					op,
 					TempName(op2)),
-				slotPush.SlotType);
+				IsForwardable(op1, op2),
+				GetBinOpExprType(op1, op2, retType, false));
 		}
 
 		private void GenIntUnaryOp(InstInfo inst, string op)
@@ -2236,10 +3046,11 @@ namespace il2cpp
 				throw new InvalidOperationException();
 
 			var slotPush = Push(slotPop.SlotType);
-			inst.InstCode = GenAssign(
-				TempName(slotPush),
+			GenPushExpr(inst,
+				slotPush,
 				op + TempName(slotPop),
-				slotPush.SlotType);
+				IsForwardable(slotPop),
+				slotPush.SlotType.GetTypeName());
 		}
 
 		private void GenLdlen(InstInfo inst)
@@ -2247,11 +3058,13 @@ namespace il2cpp
 			var slotPop = Pop();
 			var slotPush = Push(StackType.I4);
 
-			inst.InstCode = GenAssign(
-				TempName(slotPush),
-				string.Format("IL2CPP_SZARRAY_LEN({0})",
-					TempName(slotPop)),
-				slotPush.SlotType);
+			inst.InstCode = (IsResultUnused() ?
+				string.Format("IL2CPP_CHECK_NULL({0});\n", TempName(slotPop)) : null) +
+				GenAssign(
+					TempName(slotPush),
+					string.Format("IL2CPP_SZARRAY_LEN({0})",
+						TempName(slotPop)),
+					slotPush.SlotType);
 		}
 
 		private void GenReturn(InstInfo inst)
@@ -2349,6 +3162,321 @@ namespace il2cpp
 				return strPreCode + sb.ToString() + ';';
 		}
 
+		private bool GenStringConcat(InstInfo inst, MethodX metX)
+		{
+			// 定长参数的 String.Concat 直接调用运行时, 只分配一次结果字符串
+			if (metX.Def.Name != "Concat" || metX.DeclType.GetNameKey() != "String")
+				return false;
+
+			string metSigName = metX.GetNameKey();
+			if (metSigName != "Concat|String(String,String)|0" &&
+				metSigName != "Concat|String(String,String,String)|0" &&
+				metSigName != "Concat|String(String,String,String,String)|0")
+				return false;
+
+			RefTypeImpl(metX.DeclType);
+
+			StringBuilder sb = new StringBuilder();
+			sb.AppendFormat("il2cpp_String__Concat({0}, {1}",
+				GenContext.GetStringTypeID(),
+				GenStringLiteral(""));
+
+			foreach (var slot in Pop(metX.ParamTypes.Count))
+				sb.AppendFormat(", (il2cppString*){0}", TempName(slot));
+			sb.Append(')');
+
+			var slotPush = Push(StackType.Obj);
+			inst.InstCode = GenAssign(TempName(slotPush), sb.ToString(), slotPush.SlotType);
+			return true;
+		}
+
+		private bool GenRangeSafeAccess(InstInfo inst, MethodX metX)
+		{
+			// 已证明不越界的数组与字符串访问直接展开, 省略范围检查
+			if (!inst.IsRangeSafe)
+				return false;
+
+			var declType = metX.DeclType;
+			string metName = metX.Def.Name;
+			var slotArgs = Pop(metX.ParamTypes.Count);
+
+			string elemPtr;
+			if (declType.IsArrayType)
+			{
+				TypeSig elemType = declType.GenArgs[0];
+				RefTypeImpl(declType);
+				RefTypeImpl(elemType);
+
+				elemPtr = string.Format("(({0}*)&({1}{2})[1])",
+					GenContext.GetTypeName(elemType),
+					CastType(metX.ParamTypes[0]),
+					TempName(slotArgs[0]));
+
+				if (metName == "Set")
+				{
+					inst.InstCode = string.Format("{0}[{1}] = {2}{3};",
+						elemPtr,
+						TempName(slotArgs[1]),
+						CastType(elemType),
+						TempName(slotArgs[2]));
+					return true;
+				}
+			}
+			else
+			{
+				Debug.Assert(metName == "get_Chars");
+				FieldX fldFirstChar = declType.Fields.First(
+					fld => fld.FieldType.ElementType == ElementType.Char);
+
+				elemPtr = string.Format("((uint16_t*)&({0}{1})->{2})",
+					CastType(metX.ParamTypes[0]),
+					TempName(slotArgs[0]),
+					GenContext.GetFieldName(fldFirstChar));
+			}
+
+			var slotPush = Push(ToStackType(metX.ReturnType));
+			inst.InstCode = GenAssign(
+				TempName(slotPush),
+				string.Format("{0}{1}[{2}]",
+					metName == "Address" ? "&" : null,
+					elemPtr,
+					TempName(slotArgs[1])),
+				slotPush.SlotType);
+			return true;
+		}
+
+		private string GenRangeHoists(List<RangeHoist> hoists)
+		{
+			StringBuilder sb = new StringBuilder();
+			foreach (var hoist in hoists)
+			{
+				string bound = HoistBoundExpr(hoist);
+				if (hoist.RowIndices != null)
+				{
+					GenRowHoist(sb, hoist, bound);
+					continue;
+				}
+
+				sb.AppendFormat("if ({0} < {1}) {2}\n",
+					hoist.Start,
+					bound,
+					GenCheckSZRange(
+						string.Format("IL2CPP_SZARRAY_LEN({0})", HoistVarName(hoist.Array)),
+						bound + " - 1"));
+			}
+			return sb.ToString();
+		}
+
+		private string HoistBoundExpr(RangeHoist hoist)
+		{
+			string bound = HoistVarName(hoist.Bound);
+			if (hoist.IsBoundArrayLen)
+				return string.Format("(int32_t)IL2CPP_SZARRAY_LEN({0})", bound);
+			if (hoist.BoundDim >= 0)
+				return string.Format("(int32_t)il2cpp_Array__GetLength((cls_System_Array*){0}, {1})", bound, hoist.BoundDim);
+			return bound;
+		}
+
+		// 在循环入口检查行下标与循环下标的范围, 并算出行基址
+		private void GenRowHoist(StringBuilder sb, RangeHoist hoist, string bound)
+		{
+			int lastDim = hoist.RowIndices.Length;
+			string ary = string.Format("((struct {0}*){1})",
+				GenContext.GetTypeName(hoist.RowArrayType),
+				HoistVarName(hoist.Array));
+
+			sb.AppendFormat("if ({0} < {1})\n{{\n", hoist.Start, bound);
+
+			string rowOffset = null;
+			for (int d = 0; d < lastDim; ++d)
+			{
+				var idx = hoist.RowIndices[d];
+				string off = MDArrayOffset(ary, d, idx.IsConst ? idx.Const.ToString() : HoistVarName(idx.Var), hoist.IsZeroLowerBound);
+				sb.AppendFormat("\t{0}\n", GenCheckSZRange(string.Format("{0}->Size{1}", ary, d), off));
+
+				rowOffset = rowOffset == null ?
+					string.Format("(uintptr_t)(uint32_t){0}", off) :
+					string.Format("({0} * {1}->Size{2} + (uint32_t){3})", rowOffset, ary, d, off);
+			}
+
+			string lastSize = string.Format("{0}->Size{1}", ary, lastDim);
+			sb.AppendFormat("\t{0}\n", GenCheckSZRange(
+				lastSize, MDArrayOffset(ary, lastDim, hoist.Start.ToString(), hoist.IsZeroLowerBound)));
+			sb.AppendFormat("\t{0}\n", GenCheckSZRange(
+				lastSize, MDArrayOffset(ary, lastDim, bound + " - 1", hoist.IsZeroLowerBound)));
+
+			// 最后一维的下界并入基址, 循环内直接用循环下标访问
+			sb.AppendFormat("\t{0} = (({1}*)&{2}[1]) + (intptr_t)({3} * {2}->Size{4}){5};\n}}\n",
+				hoist.RowName,
+				GenContext.GetTypeName(hoist.RowArrayType.GenArgs[0]),
+				ary,
+				rowOffset,
+				lastDim,
+				hoist.IsZeroLowerBound ? null : string.Format(" - {0}->LowerBound{1}", ary, lastDim));
+		}
+
+		private static string MDArrayOffset(string ary, int dim, string index, bool isZeroLowerBound)
+		{
+			if (isZeroLowerBound)
+				return index;
+			return string.Format("(int32_t)((uint32_t)({0}) - (uint32_t){1}->LowerBound{2})", index, ary, dim);
+		}
+
+		private void DeclRowHoists(InstInfo[] instList)
+		{
+			HoistDecls = null;
+			foreach (var inst in instList)
+			{
+				if (inst.RangeHoists == null)
+					continue;
+
+				foreach (var hoist in inst.RangeHoists)
+				{
+					if (hoist.RowIndices == null)
+						continue;
+
+					if (HoistDecls == null)
+						HoistDecls = new List<string>();
+
+					TypeSig elemType = hoist.RowArrayType.GenArgs[0];
+					RefTypeImpl(hoist.RowArrayType);
+					RefTypeImpl(elemType);
+
+					hoist.RowName = "row_" + HoistDecls.Count;
+					HoistDecls.Add(string.Format("{0}* {1} = nullptr;",
+						GenContext.GetTypeName(elemType),
+						hoist.RowName));
+				}
+			}
+		}
+
+		private void DeclStaticArrays(InstInfo[] instList)
+		{
+			StaticArrayDecls = null;
+			foreach (var inst in instList)
+			{
+				var info = inst.StaticArray;
+				if (info == null || inst.OpCode.Code != Code.Newobj)
+					continue;
+
+				if (StaticArrayDecls == null)
+					StaticArrayDecls = new List<string>();
+
+				TypeSig elemType = info.ArrayType.GenArgs[0];
+				RefTypeImpl(info.ArrayType);
+				RefTypeImpl(elemType);
+
+				// 对象头与 cls_System_Array 布局一致: TypeID, Flags, Length, ElemSize | Rank << 24
+				StaticArrayDecls.Add(string.Format(
+					"alignas(8) static const struct {{ uint32_t Header[4]; uint8_t Data[{0}]; }} {1} = {{ {{ {2}, IL2CPP_OBJFLAG_LITERAL << 8, {3}, sizeof({4}) }}, {5} }};",
+					info.Data.Length,
+					StaticArrayName(info),
+					GenContext.GetTypeID(info.ArrayType),
+					info.Length,
+					GenContext.GetTypeName(elemType),
+					Helper.ByteArrayToCode(info.Data)));
+			}
+		}
+
+		private string StaticArrayName(StaticArrayInfo info)
+		{
+			return "sary_" + GenContext.GetFieldName(info.Field);
+		}
+
+		private bool GenStaticArray(InstInfo inst)
+		{
+			var info = inst.StaticArray;
+			if (info == null)
+				return false;
+
+			if (inst.OpCode.Code == Code.Newobj)
+			{
+				// 长度已在编译期确定, 直接压入只读对象
+				Pop();
+				var slotPush = Push(StackType.Obj);
+				inst.InstCode = GenAssign(
+					TempName(slotPush),
+					string.Format("(cls_Object*)&{0}", StaticArrayName(info)),
+					slotPush.SlotType);
+			}
+			else
+			{
+				// 数据已在对象中, 丢弃数组与字段句柄
+				Pop(2);
+			}
+			return true;
+		}
+
+		// 多维数组访问: 使用提升的行基址, 或对下界为 0 的数组直接展开
+		private bool GenMDArrayAccess(InstInfo inst, MethodX metX)
+		{
+			if (inst.RowHoist == null && !inst.IsZeroLowerBound)
+				return false;
+
+			var declType = metX.DeclType;
+			string metName = metX.Def.Name;
+			int rank = (int)declType.ArrayInfo.Rank;
+			var slotArgs = Pop(metX.ParamTypes.Count);
+
+			TypeSig elemType = declType.GenArgs[0];
+			RefTypeImpl(declType);
+			RefTypeImpl(elemType);
+
+			StringBuilder sb = new StringBuilder();
+			string elemRef;
+			if (inst.RowHoist != null)
+			{
+				elemRef = string.Format("{0}[{1}]",
+					inst.RowHoist.RowName,
+					TempName(slotArgs[rank]));
+			}
+			else
+			{
+				string ary = string.Format("({0}{1})",
+					CastType(metX.ParamTypes[0]),
+					TempName(slotArgs[0]));
+
+				string index = null;
+				for (int d = 0; d < rank; ++d)
+				{
+					string idx = TempName(slotArgs[d + 1]);
+					sb.AppendLine(GenCheckSZRange(string.Format("{0}->Size{1}", ary, d), idx));
+					index = index == null ?
+						string.Format("(uintptr_t)(uint32_t){0}", idx) :
+						string.Format("({0} * {1}->Size{2} + (uint32_t){3})", index, ary, d, idx);
+				}
+
+				elemRef = string.Format("(({0}*)&{1}[1])[{2}]",
+					GenContext.GetTypeName(elemType),
+					ary,
+					index);
+			}
+
+			if (metName == "Set")
+			{
+				sb.AppendFormat("{0} = {1}{2};",
+					elemRef,
+					CastType(elemType),
+					TempName(slotArgs[rank + 1]));
+			}
+			else
+			{
+				var slotPush = Push(ToStackType(metX.ReturnType));
+				sb.Append(GenAssign(
+					TempName(slotPush),
+					(metName == "Address" ? "&" : null) + elemRef,
+					slotPush.SlotType));
+			}
+
+			inst.InstCode = sb.ToString();
+			return true;
+		}
+
+		private string HoistVarName(VarRef v)
+		{
+			return v.IsArg ? ArgName(v.Index) : LocalName(v.Index);
+		}
+
 		private void GenLdftn(InstInfo inst, MethodX metX, bool isVirt = false)
 		{
 			RefTypeImpl(metX.DeclType);
@@ -2444,6 +3572,7 @@ namespace il2cpp
 					{
 						strAddSize = " + sizeof(uint16_t) * ";
 
+						// 非法参数由构造函数抛出异常, 这里只需保证分配大小不为负
 						string metSigName = metX.GetNameKey();
 						if (metSigName == ".ctor|Void(Char*,Int32,Int32)|20")
 						{
@@ -2451,22 +3580,22 @@ namespace il2cpp
 						}
 						else if (metSigName == ".ctor|Void(Char[],Int32,Int32)|20")
 						{
-							strAddSize += string.Format("IL2CPP_MIN(IL2CPP_SZARRAY_LEN({0}) - {1}, {2})",
+							strAddSize += string.Format("({0} ? IL2CPP_MAX(IL2CPP_MIN((int32_t)IL2CPP_SZARRAY_LEN({0}) - {1}, (int32_t){2}), 0) : 0)",
 								TempName(ctorArgs[1]),
 								TempName(ctorArgs[2]),
 								TempName(ctorArgs[3]));
 						}
 						else if (metSigName == ".ctor|Void(Char*)|20")
 						{
-							strAddSize += string.Format("IL2CPP_STRLEN16({0})", TempName(ctorArgs[1]));
+							strAddSize += string.Format("({0} ? IL2CPP_STRLEN16({0}) : 0)", TempName(ctorArgs[1]));
 						}
 						else if (metSigName == ".ctor|Void(Char[])|20")
 						{
-							strAddSize += string.Format("IL2CPP_SZARRAY_LEN({0})", TempName(ctorArgs[1]));
+							strAddSize += string.Format("({0} ? IL2CPP_SZARRAY_LEN({0}) : 0)", TempName(ctorArgs[1]));
 						}
 						else if (metSigName == ".ctor|Void(Char,Int32)|20")
 						{
-							strAddSize += TempName(ctorArgs[2]);
+							strAddSize += string.Format("IL2CPP_MAX((int32_t){0}, 0)", TempName(ctorArgs[2]));
 						}
 						else if (metSigName == ".ctor|Void(SByte*,Int32,Int32)|20" ||
 								 metSigName == ".ctor|Void(SByte*,Int32,Int32,Encoding)|20")
@@ -2480,6 +3609,11 @@ namespace il2cpp
 						{
 							strAddSize += string.Format("IL2CPP_TOUTF16LEN({0})", TempName(ctorArgs[1]));
 						}
+						else if (metSigName == ".ctor|Void(System.ReadOnlySpan`1<Char>)|20")
+						{
+							TypeX spanTyX = GenContext.GetTypeBySig(metX.ParamTypes[1]);
+							strAddSize += TempName(ctorArgs[1]) + '.' + GenContext.GetFieldName(RuntimeInternals.GetSpanLengthField(spanTyX));
+						}
 						else
 							throw new ArgumentOutOfRangeException();
 					}
@@ -2719,6 +3853,10 @@ namespace il2cpp
 
 			var slotPop = Pop();
 
+			var popKind = slotPop.SlotType.Kind;
+			if (isAddr && popKind != StackTypeKind.Obj && popKind != StackTypeKind.Ptr && popKind != StackTypeKind.Ref)
+				MaterializeSlot(slotPop);
+
 			SlotInfo slotPush;
 			if (isAddr)
 				slotPush = Push(StackType.Ref);
@@ -2765,14 +3903,15 @@ namespace il2cpp
 				}
 				else
 				{
-					inst.InstCode = GenAssign(
-						TempName(slotPush),
-						string.Format("{0}(({1}*){2})->{3}",
-							isAddr ? "&" : null,
-							GenContext.GetTypeName(fldX.DeclType),
-							TempName(slotPop),
-							GenContext.GetFieldName(fldX)),
-						slotPush.SlotType);
+					inst.InstCode = GenNullCheck(TempName(slotPop), fldX, isAddr || IsResultUnused()) +
+						GenAssign(
+							TempName(slotPush),
+							string.Format("{0}(({1}*){2})->{3}",
+								isAddr ? "&" : null,
+								GenContext.GetTypeName(fldX.DeclType),
+								TempName(slotPop),
+								GenContext.GetFieldName(fldX)),
+							slotPush.SlotType);
 				}
 			}
 		}
@@ -2785,13 +3924,156 @@ namespace il2cpp
 			var slotObj = slotPops[0];
 			var slotVal = slotPops[1];
 
-			inst.InstCode = GenAssign(
-				string.Format("(({0}*){1})->{2}",
-					GenContext.GetTypeName(fldX.DeclType),
-					TempName(slotObj),
-					GenContext.GetFieldName(fldX)),
-				TempName(slotVal),
-				fldX.FieldType);
+			inst.InstCode = (slotObj.SlotType.Kind == StackTypeKind.Obj ?
+				GenNullCheck(TempName(slotObj), fldX, false) : null) +
+				GenAssign(
+					string.Format("(({0}*){1})->{2}",
+						GenContext.GetTypeName(fldX.DeclType),
+						TempName(slotObj),
+						GenContext.GetFieldName(fldX)),
+					TempName(slotVal),
+					fldX.FieldType);
+		}
+
+		// 隐式空检查模式下, 访问不会落在保护页内的字段需要显式检查
+		private string GenNullCheck(string obj, FieldX fldX, bool noAccess)
+		{
+			if (!GenContext.IsImplicitNullCheck || fldX.DeclType.IsValueType)
+				return null;
+
+			// 取地址与结果未使用的读取不会访问内存
+			if (noAccess)
+				return string.Format("IL2CPP_CHECK_NULL({0});\n", obj);
+
+			if (EstimateInstanceSize(fldX.DeclType) < NullGuardSize)
+				return null;
+
+			return string.Format("IL2CPP_CHECK_NULL_FIELD({0}, &{1}::{2});\n",
+				obj,
+				GenContext.GetTypeName(fldX.DeclType),
+				GenContext.GetFieldName(fldX));
+		}
+
+		// 读取结果被丢弃或写入不再读取的局部变量, 编译器会删除这次访问
+		private bool IsResultUnused()
+		{
+			if (!GenContext.IsImplicitNullCheck)
+				return false;
+
+			var instList = CurrMethod.InstList;
+			int ip = CurrIP + 1;
+			// 跳过不会出错的类型转换
+			for (; ip < instList.Length; ++ip)
+			{
+				var inst = instList[ip];
+				if (inst.IsBrTarget)
+					return false;
+
+				var code = inst.OpCode.Code;
+				if (code != Code.Conv_I4 && code != Code.Conv_U4 &&
+					code != Code.Conv_I8 && code != Code.Conv_U8 &&
+					code != Code.Conv_I && code != Code.Conv_U)
+					break;
+			}
+			if (ip >= instList.Length || instList[ip].IsBrTarget)
+				return false;
+
+			int locIdx;
+			var next = instList[ip];
+			switch (next.OpCode.Code)
+			{
+				case Code.Pop:
+					return true;
+
+				case Code.Stloc_0:
+				case Code.Stloc_1:
+				case Code.Stloc_2:
+				case Code.Stloc_3:
+					locIdx = next.OpCode.Code - Code.Stloc_0;
+					break;
+				case Code.Stloc:
+				case Code.Stloc_S:
+					locIdx = ((Local)next.Operand).Index;
+					break;
+
+				default:
+					return false;
+			}
+
+			if (ReadLocals == null)
+				ReadLocals = CollectReadLocals(instList);
+			return !ReadLocals.Contains(locIdx);
+		}
+
+		private static HashSet<int> CollectReadLocals(IList<InstInfo> instList)
+		{
+			var locals = new HashSet<int>();
+			foreach (var inst in instList)
+			{
+				switch (inst.OpCode.Code)
+				{
+					case Code.Ldloc_0:
+					case Code.Ldloc_1:
+					case Code.Ldloc_2:
+					case Code.Ldloc_3:
+						locals.Add(inst.OpCode.Code - Code.Ldloc_0);
+						break;
+					case Code.Ldloc:
+					case Code.Ldloc_S:
+					case Code.Ldloca:
+					case Code.Ldloca_S:
+						locals.Add(((Local)inst.Operand).Index);
+						break;
+				}
+			}
+			return locals;
+		}
+
+		// 与运行时的 IL2CPP_NULL_GUARD_SIZE 一致
+		private const long NullGuardSize = 4096;
+
+		// 估算实例大小的上界, 包含对象头与基类字段
+		private long EstimateInstanceSize(TypeX tyX)
+		{
+			if (InstanceSizeCache.TryGetValue(tyX, out long size))
+				return size;
+
+			// 避免递归结构导致的死循环
+			InstanceSizeCache[tyX] = NullGuardSize;
+
+			size = tyX.IsValueType ? 0 : 8;
+			if (tyX.BaseType != null && !tyX.IsValueType)
+				size = EstimateInstanceSize(tyX.BaseType);
+
+			foreach (var fldX in tyX.Fields)
+			{
+				if (!fldX.IsInstance)
+					continue;
+				size += EstimateFieldSize(fldX.FieldType);
+			}
+
+			if (tyX.Def.HasClassLayout)
+				size = Math.Max(size, tyX.Def.ClassSize);
+
+			InstanceSizeCache[tyX] = size;
+			return size;
+		}
+
+		private long EstimateFieldSize(TypeSig tySig)
+		{
+			tySig = tySig.RemoveModifiers();
+			switch (tySig.ElementType)
+			{
+				case ElementType.ValueType:
+				case ElementType.GenericInst:
+					{
+						TypeX tyX = GenContext.GetTypeBySig(tySig);
+						if (tyX != null && tyX.IsValueType)
+							return EstimateInstanceSize(tyX) + 8;
+					}
+					break;
+			}
+			return 8;
 		}
 
 		private void GenLdsfld(InstInfo inst, FieldX fldX, bool isAddr = false)
@@ -2845,6 +4127,7 @@ namespace il2cpp
 			}
 			else
 			{
+				MaterializeSlot(slotPop);
 				inst.InstCode = GenAssign(
 					TempName(slotPop),
 					"nullptr",
@@ -2932,8 +4215,25 @@ namespace il2cpp
 		private void GenThrow(InstInfo inst)
 		{
 			var slotPop = Pop();
-			inst.InstCode = string.Format("IL2CPP_THROW({0});",
-				TempName(slotPop));
+			// 用冷标签把抛出块移出热路径
+			inst.InstCode = string.Format("TH_{0}: IL2CPP_COLD_LABEL;\n{1}",
+				inst.Offset,
+				GenThrowCode(TempName(slotPop)));
+		}
+
+		// 没有返回指令的方法只会抛出异常
+		private static bool IsThrowOnlyMethod(MethodX metX)
+		{
+			var instList = metX.InstList;
+			if (instList == null || RuntimeInternals.IsReplacedMethod(metX))
+				return false;
+
+			foreach (var inst in instList)
+			{
+				if (inst.OpCode.Code == Code.Ret)
+					return false;
+			}
+			return true;
 		}
 
 		private void GenEndfilter(InstInfo inst)
@@ -2955,15 +4255,34 @@ namespace il2cpp
 
 				inst.InstCode += string.Format("leaveTarget = {0};\n{1}",
 					RegLeaveMap(target),
-					GenGoto(leaveHandlers[0].HandlerStart));
+					GenGoto(leaveHandlers[leaveHandlers.Count - 1].HandlerStart));
 			}
 			else
 			{
 				inst.InstCode += GenGoto(target);
 			}
 			TypeStack.Clear();
+			Forwards.Clear();
+		}
+
+		// 获得离开当前 finally 后还需经过的最内层 finally
+		private ExHandlerInfo GetOuterLeaveHandler(ExHandlerInfo inner, int target)
+		{
+			ExHandlerInfo result = null;
+			foreach (var handler in CurrMethod.ExHandlerList)
+			{
+				if (handler != inner &&
+					handler.HandlerType == ExceptionHandlerType.Finally &&
+					inner.TryStart >= handler.TryStart && inner.TryEnd <= handler.TryEnd &&
+					!(target >= handler.TryStart && target < handler.TryEnd))
+				{
+					result = handler;
+				}
+			}
+			return result;
 		}
 
+		// 按由外向内的顺序返回, 最后一个为最内层
 		private List<ExHandlerInfo> GetLeaveThroughHandlers(int offset, int target)
 		{
 			Debug.Assert(CurrMethod.ExHandlerList.IsCollectionValid());
@@ -3075,7 +4394,7 @@ namespace il2cpp
 				ImplDepends.Add(GenContext.GetTypeName(tyX));
 		}
 
-		private void RefTypeImpl(TypeX tyX)
+		public void RefTypeImpl(TypeX tyX)
 		{
 			ImplDepends.Add(GenContext.GetTypeName(tyX));
 		}
@@ -3108,6 +4427,11 @@ namespace il2cpp
 			return "arg_" + argID;
 		}
 
+		private string ArgRefName(int argID)
+		{
+			return ArgName(argID) + "_ref";
+		}
+
 		private string LocalName(int locID)
 		{
 			Debug.Assert(locID < CurrMethod.LocalTypes.Count);
@@ -3119,8 +4443,12 @@ namespace il2cpp
 			return "tmp_" + idx + '_' + stype.GetPostfix();
 		}
 
-		private static string TempName(SlotInfo slot)
+		private string TempName(SlotInfo slot)
 		{
+			if (slot.Expr != null)
+				return slot.Expr;
+
+			AddSlotMap(slot);
 			return TempName(slot.SlotIndex, slot.SlotType);
 		}
 
@@ -0,0 +1,467 @@
+﻿using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using dnlib.DotNet;
+using dnlib.DotNet.Emit;
+
+namespace il2cpp
+{
+	// 在生成代码前把小方法的指令展开到调用处, 不依赖 C++ 编译器的跨单元优化
+	internal static class MethodInliner
+	{
+		// 普通方法允许展开的指令数
+		private const int MaxInlineSize = 24;
+		// 标记 AggressiveInlining 的方法允许展开的指令数
+		private const int MaxAggressiveSize = 256;
+		// 调用者超过该指令数后不再展开
+		private const int MaxCallerSize = 8192;
+
+		public static void Inline(IEnumerable<TypeX> types)
+		{
+			var metList = new List<MethodX>();
+			foreach (var tyX in types)
+			{
+				foreach (var metX in tyX.Methods)
+				{
+					if (metX.InstList != null)
+						metList.Add(metX);
+				}
+			}
+
+			foreach (var metX in metList)
+				InlineCalls(metX);
+		}
+
+		private static void InlineCalls(MethodX metX)
+		{
+			var instList = metX.InstList;
+			if (instList.Length > MaxCallerSize)
+				return;
+
+			List<InstInfo> result = null;
+			int[] newIndex = new int[instList.Length + 1];
+			for (int i = 0; i < instList.Length; ++i)
+			{
+				var inst = instList[i];
+
+				MethodX calleeX = null;
+				// 展开后的返回跳转需要落在后继指令上
+				if (i + 1 < instList.Length &&
+					(result == null || result.Count < MaxCallerSize))
+				{
+					Devirtualize(instList, i);
+					calleeX = GetInlineCallee(metX, instList, i);
+				}
+
+				if (calleeX != null && result == null)
+				{
+					result = new List<InstInfo>(instList.Length * 2);
+					for (int j = 0; j < i; ++j)
+						result.Add(instList[j]);
+				}
+
+				newIndex[i] = result?.Count ?? i;
+
+				if (calleeX != null)
+				{
+					if (ExpandCallee(metX, calleeX, inst.IsBrTarget, result))
+						instList[i + 1].IsBrTarget = true;
+				}
+				else
+					result?.Add(inst);
+			}
+
+			if (result == null)
+				return;
+
+			newIndex[instList.Length] = result.Count;
+
+			// 重定向调用者自身的跳转
+			foreach (var inst in instList)
+			{
+				if (inst.Operand is int target)
+				{
+					if (IsBranch(inst))
+						inst.Operand = newIndex[target];
+				}
+				else if (inst.Operand is int[] targets)
+				{
+					int[] newTargets = new int[targets.Length];
+					for (int i = 0; i < targets.Length; ++i)
+						newTargets[i] = newIndex[targets[i]];
+					inst.Operand = newTargets;
+				}
+			}
+
+			// 重定向异常处理范围, 展开的指令随调用处落在同一范围内
+			if (metX.ExHandlerList.IsCollectionValid())
+			{
+				foreach (var handler in metX.ExHandlerList)
+				{
+					foreach (var chandler in handler.CombinedHandlers)
+					{
+						chandler.TryStart = newIndex[chandler.TryStart];
+						chandler.TryEnd = newIndex[chandler.TryEnd];
+						if (chandler.FilterStart != -1)
+							chandler.FilterStart = newIndex[chandler.FilterStart];
+						chandler.HandlerStart = newIndex[chandler.HandlerStart];
+						chandler.HandlerEnd = newIndex[chandler.HandlerEnd];
+					}
+				}
+			}
+
+			for (int i = 0; i < result.Count; ++i)
+				result[i].Offset = i;
+
+			metX.InstList = result.ToArray();
+		}
+
+		private static bool IsBranch(InstInfo inst)
+		{
+			switch (inst.OpCode.OperandType)
+			{
+				case OperandType.InlineBrTarget:
+				case OperandType.ShortInlineBrTarget:
+					return true;
+			}
+			return false;
+		}
+
+		// 只有一个实现的虚调用改为直接调用
+		private static void Devirtualize(InstInfo[] instList, int idx)
+		{
+			var inst = instList[idx];
+			if (inst.OpCode.Code != Code.Callvirt)
+				return;
+
+			var virtMetX = (MethodX)inst.Operand;
+			if (!virtMetX.IsVirtual || !virtMetX.HasOverrideImpls || virtMetX.OverrideImpls.Count != 1)
+				return;
+
+			// 值类型的实现需要拆箱包装
+			var implMetX = virtMetX.OverrideImpls.Keys.First();
+			if (implMetX.DeclType.IsValueType)
+				return;
+
+			if (idx > 0 && instList[idx - 1].OpCode.Code == Code.Constrained)
+				return;
+
+			inst.OpCode = OpCodes.Call;
+			inst.Operand = implMetX;
+		}
+
+		private static MethodX GetInlineCallee(MethodX metX, InstInfo[] instList, int idx)
+		{
+			var inst = instList[idx];
+			if (inst.OpCode.Code != Code.Call)
+				return null;
+
+			if (idx > 0 && instList[idx - 1].OpCode.Code == Code.Constrained)
+				return null;
+
+			var calleeX = (MethodX)inst.Operand;
+			if (calleeX == metX || !IsInlineable(calleeX))
+				return null;
+
+			return calleeX;
+		}
+
+		private static bool IsInlineable(MethodX metX)
+		{
+			var metDef = metX.Def;
+			var instList = metX.InstList;
+			if (instList == null ||
+				metDef.IsNoInlining ||
+				metDef.IsSynchronized ||
+				metDef.IsConstructor ||
+				metX.ExHandlerList.IsCollectionValid() ||
+				metX.ParamAfterSentinel.IsCollectionValid())
+				return false;
+
+			int maxSize = metDef.IsAggressiveInlining ? MaxAggressiveSize : MaxInlineSize;
+			int size = 0;
+			bool hasRet = false;
+			foreach (var inst in instList)
+			{
+				switch (inst.OpCode.Code)
+				{
+					case Code.Nop:
+						continue;
+
+					// 循环内的栈分配会不断增长
+					case Code.Localloc:
+					case Code.Jmp:
+					case Code.Arglist:
+						return false;
+
+					case Code.Ret:
+						hasRet = true;
+						break;
+				}
+
+				if (++size > maxSize)
+					return false;
+			}
+
+			// 只会抛出异常的方法保持为冷调用
+			if (!hasRet)
+				return false;
+
+			if (metX.LocalTypes.IsCollectionValid())
+			{
+				foreach (var locType in metX.LocalTypes)
+				{
+					if (locType.IsPinned)
+						return false;
+					// 每次进入都要重新清零局部变量
+					if (metDef.Body.InitLocals && GetZeroInitCode(locType) == null)
+						return false;
+				}
+			}
+
+			return true;
+		}
+
+		private static bool ExpandCallee(MethodX metX, MethodX calleeX, bool isBrTarget, List<InstInfo> result)
+		{
+			if (metX.LocalTypes == null)
+				metX.LocalTypes = new List<TypeSig>();
+			var locTypes = metX.LocalTypes;
+
+			// 实参与局部变量都映射为调用者的局部变量
+			var argLocals = new Local[calleeX.ParamTypes.Count];
+			for (int i = 0; i < argLocals.Length; ++i)
+			{
+				argLocals[i] = new Local(calleeX.ParamTypes[i], null, locTypes.Count);
+				locTypes.Add(calleeX.ParamTypes[i]);
+			}
+
+			int numLocals = calleeX.LocalTypes?.Count ?? 0;
+			var locLocals = new Local[numLocals];
+			for (int i = 0; i < numLocals; ++i)
+			{
+				locLocals[i] = new Local(calleeX.LocalTypes[i], null, locTypes.Count);
+				locTypes.Add(calleeX.LocalTypes[i]);
+			}
+
+			int start = result.Count;
+
+			// 实参按逆序出栈
+			for (int i = argLocals.Length - 1; i >= 0; --i)
+				result.Add(MakeInst(OpCodes.Stloc, argLocals[i]));
+
+			if (calleeX.Def.Body.InitLocals)
+			{
+				for (int i = 0; i < numLocals; ++i)
+				{
+					foreach (var opCode in GetZeroInitCode(calleeX.LocalTypes[i]))
+						result.Add(MakeInst(opCode, GetZeroOperand(opCode)));
+					result.Add(MakeInst(OpCodes.Stloc, locLocals[i]));
+				}
+			}
+
+			var calleeInsts = calleeX.InstList;
+			int bodyStart = result.Count;
+			int tail = bodyStart + calleeInsts.Length;
+
+			// 短整数返回值需要截断
+			OpCode retConv = GetReturnConv(calleeX.ReturnType);
+			bool isTailTarget = false;
+
+			for (int i = 0; i < calleeInsts.Length; ++i)
+			{
+				var src = calleeInsts[i];
+				var inst = new InstInfo
+				{
+					OpCode = src.OpCode,
+					Operand = src.Operand,
+					IsBrTarget = src.IsBrTarget
+				};
+
+				switch (src.OpCode.Code)
+				{
+					case Code.Ret:
+						if (i == calleeInsts.Length - 1)
+							inst.OpCode = OpCodes.Nop;
+						else
+						{
+							inst.OpCode = OpCodes.Br;
+							inst.Operand = tail;
+							isTailTarget = true;
+						}
+						break;
+
+					case Code.Ldarg_0:
+					case Code.Ldarg_1:
+					case Code.Ldarg_2:
+					case Code.Ldarg_3:
+						inst.OpCode = OpCodes.Ldloc;
+						inst.Operand = argLocals[src.OpCode.Code - Code.Ldarg_0];
+						break;
+					case Code.Ldarg:
+					case Code.Ldarg_S:
+						inst.OpCode = OpCodes.Ldloc;
+						inst.Operand = argLocals[((Parameter)src.Operand).Index];
+						break;
+					case Code.Ldarga:
+					case Code.Ldarga_S:
+						inst.OpCode = OpCodes.Ldloca;
+						inst.Operand = argLocals[((Parameter)src.Operand).Index];
+						break;
+					case Code.Starg:
+					case Code.Starg_S:
+						inst.OpCode = OpCodes.Stloc;
+						inst.Operand = argLocals[((Parameter)src.Operand).Index];
+						break;
+
+					case Code.Ldloc_0:
+					case Code.Ldloc_1:
+					case Code.Ldloc_2:
+					case Code.Ldloc_3:
+						inst.OpCode = OpCodes.Ldloc;
+						inst.Operand = locLocals[src.OpCode.Code - Code.Ldloc_0];
+						break;
+					case Code.Ldloc:
+					case Code.Ldloc_S:
+						inst.OpCode = OpCodes.Ldloc;
+						inst.Operand = locLocals[((Local)src.Operand).Index];
+						break;
+					case Code.Ldloca:
+					case Code.Ldloca_S:
+						inst.OpCode = OpCodes.Ldloca;
+						inst.Operand = locLocals[((Local)src.Operand).Index];
+						break;
+					case Code.Stloc_0:
+					case Code.Stloc_1:
+					case Code.Stloc_2:
+					case Code.Stloc_3:
+						inst.OpCode = OpCodes.Stloc;
+						inst.Operand = locLocals[src.OpCode.Code - Code.Stloc_0];
+						break;
+					case Code.Stloc:
+					case Code.Stloc_S:
+						inst.OpCode = OpCodes.Stloc;
+						inst.Operand = locLocals[((Local)src.Operand).Index];
+						break;
+
+					default:
+						if (src.Operand is int target && IsBranch(src))
+							inst.Operand = bodyStart + target;
+						else if (src.Operand is int[] targets)
+							inst.Operand = targets.Select(t => bodyStart + t).ToArray();
+						break;
+				}
+
+				result.Add(inst);
+			}
+
+			if (retConv != null)
+			{
+				result.Add(MakeInst(retConv, null));
+				if (isTailTarget)
+				{
+					result[tail].IsBrTarget = true;
+					isTailTarget = false;
+				}
+			}
+
+			if (isBrTarget)
+				result[start].IsBrTarget = true;
+
+			// 返回跳转落在调用者的后继指令上
+			return isTailTarget;
+		}
+
+		private static InstInfo MakeInst(OpCode opCode, object operand)
+		{
+			return new InstInfo
+			{
+				OpCode = opCode,
+				Operand = operand
+			};
+		}
+
+		private static OpCode GetReturnConv(TypeSig retType)
+		{
+			switch (retType.RemoveModifiers().ElementType)
+			{
+				case ElementType.I1:
+					return OpCodes.Conv_I1;
+				case ElementType.U1:
+					return OpCodes.Conv_U1;
+				case ElementType.I2:
+					return OpCodes.Conv_I2;
+				case ElementType.U2:
+				case ElementType.Char:
+					return OpCodes.Conv_U2;
+			}
+			return null;
+		}
+
+		private static OpCode[] GetZeroInitCode(TypeSig tySig)
+		{
+			tySig = tySig.RemoveModifiers();
+			switch (tySig.ElementType)
+			{
+				case ElementType.Boolean:
+				case ElementType.Char:
+				case ElementType.I1:
+				case ElementType.U1:
+				case ElementType.I2:
+				case ElementType.U2:
+				case ElementType.I4:
+				case ElementType.U4:
+					return new[] { OpCodes.Ldc_I4_0 };
+
+				case ElementType.I8:
+				case ElementType.U8:
+					return new[] { OpCodes.Ldc_I8 };
+
+				case ElementType.R4:
+					return new[] { OpCodes.Ldc_R4 };
+
+				case ElementType.R8:
+					return new[] { OpCodes.Ldc_R8 };
+
+				case ElementType.I:
+				case ElementType.U:
+				case ElementType.Ptr:
+				case ElementType.FnPtr:
+				case ElementType.ByRef:
+					return new[] { OpCodes.Ldc_I4_0, OpCodes.Conv_U };
+
+				case ElementType.Object:
+				case ElementType.String:
+				case ElementType.Class:
+				case ElementType.SZArray:
+				case ElementType.Array:
+					return new[] { OpCodes.Ldnull };
+
+				case ElementType.GenericInst:
+					if (!tySig.IsValueType)
+						return new[] { OpCodes.Ldnull };
+					break;
+
+				case ElementType.ValueType:
+					if (Helper.IsEnumType(tySig, out var enumSig))
+						return GetZeroInitCode(enumSig);
+					break;
+			}
+			return null;
+		}
+
+		private static object GetZeroOperand(OpCode opCode)
+		{
+			switch (opCode.Code)
+			{
+				case Code.Ldc_I8:
+					return 0L;
+				case Code.Ldc_R4:
+					return 0.0f;
+				case Code.Ldc_R8:
+					return 0.0;
+			}
+			return null;
+		}
+	}
+}
@@ -17,6 +17,17 @@ namespace il2cpp
 		public bool IsGenerated;
 		public string InstCode;
 
+		// 已证明下标不会越界
+		public bool IsRangeSafe;
+		// 多维数组访问的对象各维下界必为 0
+		public bool IsZeroLowerBound;
+		// 使用循环入口提升的行基址访问多维数组
+		public RangeHoist RowHoist;
+		// 提升到此处的循环范围检查
+		public List<RangeHoist> RangeHoists;
+		// 编译期构造的只读数组, 替换其 newobj 与 InitializeArray
+		public StaticArrayInfo StaticArray;
+
 		public override string ToString()
 		{
 			if (Operand is int[] iary)
@@ -106,6 +117,8 @@ namespace il2cpp
 
 		// 指令列表
 		public InstInfo[] InstList;
+		// 共享实现的规范实例, 为空时生成自身的实现
+		public MethodX SharedMethod;
 
 		// 虚方法绑定的实现方法
 		public Dictionary<MethodX, HashSet<TypeX>> OverrideImpls;
@@ -131,6 +144,8 @@ namespace il2cpp
 		public string GeneratedMethodName;
 		// 是否需要生成元数据
 		public bool NeedGenMetadata;
+		// 函数地址会被委托持有, 需要保持唯一
+		public bool IsAddressTaken;
 		public bool GenMetadata => NeedGenMetadata || DeclType.NeedGenMetadata;
 
 		public bool HasThis
@@ -0,0 +1,980 @@
+﻿using System.Collections.Generic;
+using dnlib.DotNet;
+using dnlib.DotNet.Emit;
+
+namespace il2cpp
+{
+	// 局部变量或参数
+	internal struct VarRef
+	{
+		public readonly bool IsArg;
+		public readonly int Index;
+
+		public VarRef(bool isArg, int index)
+		{
+			IsArg = isArg;
+			Index = index;
+		}
+
+		public override bool Equals(object obj)
+		{
+			return obj is VarRef other && IsArg == other.IsArg && Index == other.Index;
+		}
+
+		public override int GetHashCode()
+		{
+			return IsArg ? ~Index : Index;
+		}
+	}
+
+	// 常量或变量形式的下标
+	internal struct IndexOperand
+	{
+		public readonly bool IsConst;
+		public readonly int Const;
+		public readonly VarRef Var;
+
+		public IndexOperand(int val)
+		{
+			IsConst = true;
+			Const = val;
+			Var = default(VarRef);
+		}
+
+		public IndexOperand(VarRef v)
+		{
+			IsConst = false;
+			Const = 0;
+			Var = v;
+		}
+
+		public override bool Equals(object obj)
+		{
+			return obj is IndexOperand other && IsConst == other.IsConst && Const == other.Const && Var.Equals(other.Var);
+		}
+
+		public override int GetHashCode()
+		{
+			return IsConst ? Const : Var.GetHashCode();
+		}
+	}
+
+	// 提升到循环入口的范围检查
+	internal class RangeHoist
+	{
+		public VarRef Array;
+		public VarRef Bound;
+		public bool IsBoundArrayLen;
+		// 非负时上界为 Bound.GetLength(BoundDim)
+		public int BoundDim = -1;
+		public int Start;
+
+		// 多维数组的行基址提升: 除最后一维以外的下标, 以及元素类型
+		public IndexOperand[] RowIndices;
+		public TypeX RowArrayType;
+		public bool IsZeroLowerBound;
+		public string RowName;
+	}
+
+	// 循环内数组与字符串访问的范围检查消除
+	internal static class RangeCheckAnalyzer
+	{
+		private enum BoundKind
+		{
+			ArrayLen,
+			StringLen,
+			MDLength,
+			Variable
+		}
+
+		private class LoopInfo
+		{
+			public int Preheader;
+			public int BodyStart;
+			public int CondStart;
+			public int CondEnd;
+			public int Start;
+			public VarRef Index;
+			public VarRef Bound;
+			public BoundKind Kind;
+			public int BoundDim = -1;
+		}
+
+		public static void Analyze(MethodX metX)
+		{
+			var instList = metX.InstList;
+			if (instList == null)
+				return;
+
+			HashSet<VarRef> addrTaken = null;
+			for (int i = 0; i < instList.Length; ++i)
+			{
+				instList[i].IsRangeSafe = false;
+				instList[i].IsZeroLowerBound = false;
+				instList[i].RowHoist = null;
+				instList[i].RangeHoists = null;
+
+				if (GetAddrVar(instList[i], out var v))
+				{
+					if (addrTaken == null)
+						addrTaken = new HashSet<VarRef>();
+					addrTaken.Add(v);
+				}
+			}
+
+			var zeroBased = FindZeroLowerBoundLocals(instList, addrTaken);
+			if (zeroBased != null)
+				MarkZeroLowerBoundAccess(instList, zeroBased);
+
+			for (int i = 0; i < instList.Length; ++i)
+			{
+				var loop = MatchLoop(metX, i, addrTaken);
+				if (loop != null)
+					ProcessLoop(metX, loop, addrTaken, zeroBased);
+			}
+		}
+
+		// 只由 new T[n, m] 赋值的局部变量, 其各维下界必然为 0
+		private static HashSet<VarRef> FindZeroLowerBoundLocals(InstInfo[] instList, HashSet<VarRef> addrTaken)
+		{
+			HashSet<VarRef> candidates = null;
+			HashSet<VarRef> rejected = null;
+			for (int i = 0; i < instList.Length; ++i)
+			{
+				if (!GetStoreVar(instList[i], out var v) || v.IsArg)
+					continue;
+
+				int prev = PrevInst(instList, i);
+				bool isZeroBased = !instList[i].IsBrTarget && prev >= 0 &&
+					(instList[prev].OpCode.Code == Code.Ldnull || IsMDArrayCtor(instList[prev]));
+
+				if (isZeroBased)
+				{
+					if (candidates == null)
+						candidates = new HashSet<VarRef>();
+					candidates.Add(v);
+				}
+				else
+				{
+					if (rejected == null)
+						rejected = new HashSet<VarRef>();
+					rejected.Add(v);
+				}
+			}
+
+			if (candidates == null)
+				return null;
+			if (rejected != null)
+				candidates.ExceptWith(rejected);
+			if (addrTaken != null)
+				candidates.ExceptWith(addrTaken);
+			return candidates.Count > 0 ? candidates : null;
+		}
+
+		private static bool IsMDArrayCtor(InstInfo inst)
+		{
+			if (inst.OpCode.Code != Code.Newobj)
+				return false;
+
+			MethodX metX = (MethodX)inst.Operand;
+			var arrayInfo = metX.DeclType.ArrayInfo;
+			// 参数只含各维长度的构造
+			return arrayInfo != null && !arrayInfo.IsSZArray &&
+				metX.ParamTypes.Count - 1 == arrayInfo.Rank;
+		}
+
+		private static void MarkZeroLowerBoundAccess(InstInfo[] instList, HashSet<VarRef> zeroBased)
+		{
+			for (int i = 0; i < instList.Length; ++i)
+			{
+				if (!IsMDArrayAccessor(instList[i], out var accMetX))
+					continue;
+
+				int objLoad = FindArrayLoad(instList, i, accMetX, 0);
+				if (objLoad >= 0 &&
+					GetLoadVar(instList[objLoad], out var objVar) &&
+					zeroBased.Contains(objVar) &&
+					!IsStoredBetween(instList, objVar, objLoad + 1, i))
+				{
+					instList[i].IsZeroLowerBound = true;
+				}
+			}
+		}
+
+		// 跳过所有下标与值表达式, 返回压入数组对象的指令位置
+		private static int FindArrayLoad(InstInfo[] instList, int call, MethodX accMetX, int lowerBound)
+		{
+			int numExprs = (int)accMetX.DeclType.ArrayInfo.Rank + (accMetX.Def.Name == "Set" ? 1 : 0);
+			int ip = PrevInst(instList, call);
+			for (int n = 0; n < numExprs && ip >= lowerBound; ++n)
+				ip = SkipValueExpr(instList, ip, lowerBound);
+			return ip < lowerBound ? -1 : ip;
+		}
+
+		private static bool IsStoredBetween(InstInfo[] instList, VarRef v, int start, int end)
+		{
+			for (int i = start; i < end; ++i)
+			{
+				if (GetStoreVar(instList[i], out var sv) && sv.Equals(v))
+					return true;
+			}
+			return false;
+		}
+
+		private static LoopInfo MatchLoop(MethodX metX, int condStart, HashSet<VarRef> addrTaken)
+		{
+			var instList = metX.InstList;
+			if (!instList[condStart].IsBrTarget)
+				return null;
+
+			// 条件: ldloc i; <bound>; blt body
+			int ip = condStart;
+			if (!GetLoadVar(instList[ip], out var idxVar) || idxVar.IsArg)
+				return null;
+
+			ip = NextInst(instList, ip);
+			if (ip < 0 || !GetLoadVar(instList[ip], out var boundVar))
+				return null;
+
+			BoundKind kind = BoundKind.Variable;
+			int next = NextInst(instList, ip);
+			if (next < 0)
+				return null;
+
+			if (instList[next].OpCode.Code == Code.Ldlen)
+			{
+				kind = BoundKind.ArrayLen;
+				ip = next;
+				next = NextInst(instList, ip);
+				if (next >= 0 && instList[next].OpCode.Code == Code.Conv_I4)
+				{
+					ip = next;
+					next = NextInst(instList, ip);
+				}
+			}
+			else if (IsStringMethod(instList[next], "get_Length"))
+			{
+				kind = BoundKind.StringLen;
+				ip = next;
+				next = NextInst(instList, ip);
+			}
+
+			// A.GetLength(d)
+			int boundDim = -1;
+			if (kind == BoundKind.Variable && next >= 0 && GetLdcI4(instList[next], out int dim) && dim >= 0)
+			{
+				int call = NextInst(instList, next);
+				if (call >= 0 && IsArrayMethod(instList[call], "GetLength"))
+				{
+					kind = BoundKind.MDLength;
+					boundDim = dim;
+					ip = call;
+					next = NextInst(instList, ip);
+				}
+			}
+
+			int condEnd = MatchLessThanBranch(instList, next, out int bodyStart);
+			if (condEnd < 0 || bodyStart >= condStart)
+				return null;
+
+			// 循环只能从条件处进入: body 前必须是跳到条件的无条件跳转
+			int preheader = PrevInst(instList, bodyStart);
+			if (preheader < 0 ||
+				(instList[preheader].OpCode.Code != Code.Br && instList[preheader].OpCode.Code != Code.Br_S) ||
+				(int)instList[preheader].Operand != condStart)
+				return null;
+
+			// 初值必须是非负常量
+			int initStore = PrevInst(instList, preheader);
+			int initLoad = initStore < 0 ? -1 : PrevInst(instList, initStore);
+			if (initLoad < 0 ||
+				!GetStoreVar(instList[initStore], out var initVar) || !initVar.Equals(idxVar) ||
+				!GetLdcI4(instList[initLoad], out int start) || start < 0)
+				return null;
+
+			if (addrTaken != null && (addrTaken.Contains(idxVar) || addrTaken.Contains(boundVar)))
+				return null;
+
+			var loop = new LoopInfo
+			{
+				Preheader = preheader,
+				BodyStart = bodyStart,
+				CondStart = condStart,
+				CondEnd = condEnd,
+				Start = start,
+				Index = idxVar,
+				Bound = boundVar,
+				Kind = kind,
+				BoundDim = boundDim
+			};
+
+			if (!CheckLoopEntries(metX, loop) || !CheckInduction(instList, loop))
+				return null;
+
+			// 循环内不能修改上界变量
+			for (int i = bodyStart; i <= condEnd; ++i)
+			{
+				if (GetStoreVar(instList[i], out var v) && v.Equals(boundVar))
+					return null;
+			}
+
+			return loop;
+		}
+
+		// 匹配 blt body, 或调试版本的 clt; [stloc t; ldloc t;] brtrue body
+		private static int MatchLessThanBranch(InstInfo[] instList, int ip, out int target)
+		{
+			target = -1;
+			if (ip < 0)
+				return -1;
+
+			var code = instList[ip].OpCode.Code;
+			if (code == Code.Blt || code == Code.Blt_S)
+			{
+				target = (int)instList[ip].Operand;
+				return ip;
+			}
+
+			if (code != Code.Clt)
+				return -1;
+
+			ip = NextInst(instList, ip);
+			if (ip < 0)
+				return -1;
+
+			if (GetStoreVar(instList[ip], out var tmpVar))
+			{
+				ip = NextInst(instList, ip);
+				if (ip < 0 || !GetLoadVar(instList[ip], out var tmpLoad) || !tmpLoad.Equals(tmpVar))
+					return -1;
+				ip = NextInst(instList, ip);
+				if (ip < 0)
+					return -1;
+			}
+
+			code = instList[ip].OpCode.Code;
+			if (code != Code.Brtrue && code != Code.Brtrue_S)
+				return -1;
+
+			target = (int)instList[ip].Operand;
+			return ip;
+		}
+
+		// 除了跳到条件以外, 循环外不能跳入循环体
+		private static bool CheckLoopEntries(MethodX metX, LoopInfo loop)
+		{
+			var instList = metX.InstList;
+			for (int i = 0; i < instList.Length; ++i)
+			{
+				bool isInside = i >= loop.BodyStart && i <= loop.CondEnd;
+				if (isInside)
+					continue;
+
+				var operand = instList[i].Operand;
+				if (operand is int target && IsBranch(instList[i]))
+				{
+					if (target > loop.Preheader && target <= loop.CondEnd && target != loop.CondStart)
+						return false;
+				}
+				else if (operand is int[] targets)
+				{
+					foreach (int t in targets)
+					{
+						if (t > loop.Preheader && t <= loop.CondEnd && t != loop.CondStart)
+							return false;
+					}
+				}
+			}
+
+			if (metX.ExHandlerList != null)
+			{
+				foreach (var handler in metX.ExHandlerList)
+				{
+					foreach (var chandler in handler.CombinedHandlers)
+					{
+						if (chandler.HandlerOrFilterStart >= loop.BodyStart && chandler.HandlerOrFilterStart <= loop.CondEnd ||
+							chandler.TryStart > loop.BodyStart && chandler.TryStart <= loop.CondEnd)
+							return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		// 下标在循环内只允许在条件前执行一次 i = i + 1
+		private static bool CheckInduction(InstInfo[] instList, LoopInfo loop)
+		{
+			int incStore = PrevInst(instList, loop.CondStart);
+			if (incStore < loop.BodyStart || !GetStoreVar(instList[incStore], out var v) || !v.Equals(loop.Index))
+				return false;
+
+			int incAdd = PrevInst(instList, incStore);
+			int incOne = incAdd < 0 ? -1 : PrevInst(instList, incAdd);
+			int incLoad = incOne < 0 ? -1 : PrevInst(instList, incOne);
+			if (incLoad < loop.BodyStart ||
+				instList[incAdd].OpCode.Code != Code.Add ||
+				!GetLdcI4(instList[incOne], out int step) || step != 1 ||
+				!GetLoadVar(instList[incLoad], out v) || !v.Equals(loop.Index))
+				return false;
+
+			for (int i = incLoad; i <= incStore; ++i)
+			{
+				if (i != loop.BodyStart && instList[i].IsBrTarget && i != incLoad)
+					return false;
+			}
+
+			for (int i = loop.BodyStart; i <= loop.CondEnd; ++i)
+			{
+				if (i != incStore && GetStoreVar(instList[i], out v) && v.Equals(loop.Index))
+					return false;
+			}
+
+			return true;
+		}
+
+		private static void ProcessLoop(MethodX metX, LoopInfo loop, HashSet<VarRef> addrTaken, HashSet<VarRef> zeroBased)
+		{
+			var instList = metX.InstList;
+
+			// 循环内被修改的变量
+			HashSet<VarRef> stored = new HashSet<VarRef>();
+			for (int i = loop.BodyStart; i <= loop.CondEnd; ++i)
+			{
+				if (GetStoreVar(instList[i], out var v))
+					stored.Add(v);
+			}
+
+			// 提升的检查会在之前迭代的副作用发生前抛出, 只在副作用不可见时提升
+			bool canHoist = loop.Kind != BoundKind.StringLen &&
+				IsStraightLine(instList, loop) &&
+				!HasHeapStore(instList, loop) &&
+				!IsInProtectedRegion(metX, loop);
+			List<RangeHoist> hoists = null;
+
+			for (int i = loop.BodyStart; i < loop.CondStart; ++i)
+			{
+				var inst = instList[i];
+				if (inst.OpCode.Code != Code.Call && inst.OpCode.Code != Code.Callvirt)
+					continue;
+
+				if (canHoist && IsMDArrayAccessor(inst, out var mdMetX))
+				{
+					var rowHoist = MatchRowAccess(instList, i, mdMetX, loop, stored, addrTaken, zeroBased);
+					if (rowHoist != null)
+					{
+						if (hoists == null)
+							hoists = new List<RangeHoist>();
+
+						var existing = hoists.Find(h => h.RowIndices != null && IsSameRow(h, rowHoist));
+						if (existing != null)
+							rowHoist = existing;
+						else
+							hoists.Add(rowHoist);
+
+						inst.RowHoist = rowHoist;
+					}
+					continue;
+				}
+
+				MethodX accMetX = (MethodX)inst.Operand;
+				bool isArray = IsSZArrayAccessor(accMetX);
+				if (!isArray && !IsStringMethod(inst, "get_Chars"))
+					continue;
+
+				// 定位下标与对象的加载指令
+				int idxLoad = accMetX.Def.Name == "Set" ?
+					SkipValueExpr(instList, PrevInst(instList, i), loop.BodyStart) :
+					PrevInst(instList, i);
+				int objLoad = idxLoad < loop.BodyStart ? -1 : PrevInst(instList, idxLoad);
+				if (objLoad < loop.BodyStart ||
+					HasBrTarget(instList, objLoad + 1, i) ||
+					!GetLoadVar(instList[idxLoad], out var idxVar) || !idxVar.Equals(loop.Index) ||
+					!GetLoadVar(instList[objLoad], out var objVar) ||
+					stored.Contains(objVar) ||
+					addrTaken != null && addrTaken.Contains(objVar))
+					continue;
+
+				if (objVar.Equals(loop.Bound) &&
+					(isArray && loop.Kind == BoundKind.ArrayLen || !isArray && loop.Kind == BoundKind.StringLen))
+				{
+					// i < A.Length 已证明访问合法
+					inst.IsRangeSafe = true;
+				}
+				else if (isArray && canHoist)
+				{
+					inst.IsRangeSafe = true;
+
+					if (hoists == null)
+						hoists = new List<RangeHoist>();
+					if (!hoists.Exists(h => h.Array.Equals(objVar)))
+					{
+						hoists.Add(new RangeHoist
+						{
+							Array = objVar,
+							Bound = loop.Bound,
+							IsBoundArrayLen = loop.Kind == BoundKind.ArrayLen,
+							BoundDim = loop.BoundDim,
+							Start = loop.Start
+						});
+					}
+				}
+			}
+
+			if (hoists != null)
+			{
+				var preheader = instList[loop.Preheader];
+				if (preheader.RangeHoists == null)
+					preheader.RangeHoists = hoists;
+				else
+					preheader.RangeHoists.AddRange(hoists);
+			}
+		}
+
+		// A[r0, .., i] 中数组与前几维下标在循环内不变, 最后一维为循环下标
+		private static RangeHoist MatchRowAccess(
+			InstInfo[] instList,
+			int call,
+			MethodX accMetX,
+			LoopInfo loop,
+			HashSet<VarRef> stored,
+			HashSet<VarRef> addrTaken,
+			HashSet<VarRef> zeroBased)
+		{
+			int rank = (int)accMetX.DeclType.ArrayInfo.Rank;
+			int ip = accMetX.Def.Name == "Set" ?
+				SkipValueExpr(instList, PrevInst(instList, call), loop.BodyStart) :
+				PrevInst(instList, call);
+			if (ip < loop.BodyStart ||
+				!GetLoadVar(instList[ip], out var idxVar) || !idxVar.Equals(loop.Index))
+				return null;
+
+			var rowIndices = new IndexOperand[rank - 1];
+			for (int d = rank - 2; d >= 0; --d)
+			{
+				ip = PrevInst(instList, ip);
+				if (ip < loop.BodyStart)
+					return null;
+
+				if (GetLdcI4(instList[ip], out int val))
+					rowIndices[d] = new IndexOperand(val);
+				else if (GetLoadVar(instList[ip], out var rowVar) && IsInvariant(rowVar, stored, addrTaken))
+					rowIndices[d] = new IndexOperand(rowVar);
+				else
+					return null;
+			}
+
+			ip = PrevInst(instList, ip);
+			if (ip < loop.BodyStart || HasBrTarget(instList, ip + 1, call) ||
+				!GetLoadVar(instList[ip], out var objVar) || !IsInvariant(objVar, stored, addrTaken))
+				return null;
+
+			return new RangeHoist
+			{
+				Array = objVar,
+				Bound = loop.Bound,
+				IsBoundArrayLen = loop.Kind == BoundKind.ArrayLen,
+				BoundDim = loop.BoundDim,
+				Start = loop.Start,
+				RowIndices = rowIndices,
+				RowArrayType = accMetX.DeclType,
+				IsZeroLowerBound = zeroBased != null && zeroBased.Contains(objVar)
+			};
+		}
+
+		private static bool IsInvariant(VarRef v, HashSet<VarRef> stored, HashSet<VarRef> addrTaken)
+		{
+			return !stored.Contains(v) && (addrTaken == null || !addrTaken.Contains(v));
+		}
+
+		private static bool IsSameRow(RangeHoist lhs, RangeHoist rhs)
+		{
+			if (!lhs.Array.Equals(rhs.Array) || lhs.RowArrayType != rhs.RowArrayType)
+				return false;
+			for (int i = 0; i < lhs.RowIndices.Length; ++i)
+			{
+				if (!lhs.RowIndices[i].Equals(rhs.RowIndices[i]))
+					return false;
+			}
+			return true;
+		}
+
+		// 循环体无分支且不会抛出可捕获的异常时, 提前检查与逐次检查等价
+		private static bool IsStraightLine(InstInfo[] instList, LoopInfo loop)
+		{
+			for (int i = loop.BodyStart; i < loop.CondStart; ++i)
+			{
+				var inst = instList[i];
+				if (i != loop.BodyStart && inst.IsBrTarget)
+					return false;
+
+				switch (inst.OpCode.FlowControl)
+				{
+					case FlowControl.Next:
+					case FlowControl.Meta:
+						break;
+
+					case FlowControl.Call:
+						if (inst.OpCode.Code != Code.Call && inst.OpCode.Code != Code.Callvirt)
+							return false;
+						if (!IsSZArrayAccessor((MethodX)inst.Operand) &&
+							!IsMDArrayAccessor(inst, out _) &&
+							!IsArrayMethod(inst, "GetLength") &&
+							!IsStringMethod(inst, "get_Chars") &&
+							!IsStringMethod(inst, "get_Length"))
+							return false;
+						break;
+
+					default:
+						return false;
+				}
+
+				switch (inst.OpCode.Code)
+				{
+					case Code.Newobj:
+					case Code.Castclass:
+					case Code.Unbox:
+					case Code.Unbox_Any:
+					case Code.Ckfinite:
+					case Code.Div:
+					case Code.Div_Un:
+					case Code.Rem:
+					case Code.Rem_Un:
+					case Code.Add_Ovf:
+					case Code.Add_Ovf_Un:
+					case Code.Sub_Ovf:
+					case Code.Sub_Ovf_Un:
+					case Code.Mul_Ovf:
+					case Code.Mul_Ovf_Un:
+						return false;
+				}
+
+				if (inst.OpCode.Name.StartsWith("conv.ovf"))
+					return false;
+			}
+			return true;
+		}
+
+		// 循环体写入堆内存, 异常被任意调用方捕获后都能观察到
+		private static bool HasHeapStore(InstInfo[] instList, LoopInfo loop)
+		{
+			for (int i = loop.BodyStart; i < loop.CondStart; ++i)
+			{
+				var inst = instList[i];
+				switch (inst.OpCode.Code)
+				{
+					case Code.Stfld:
+					case Code.Stsfld:
+					case Code.Stobj:
+					case Code.Initobj:
+					case Code.Cpobj:
+					case Code.Cpblk:
+					case Code.Initblk:
+						return true;
+
+					case Code.Call:
+					case Code.Callvirt:
+						if (((MethodX)inst.Operand).Def.Name == "Set" &&
+							(IsSZArrayAccessor((MethodX)inst.Operand) || IsMDArrayAccessor(inst, out _)))
+							return true;
+						break;
+
+					default:
+						if (inst.OpCode.Name.StartsWith("stind") || inst.OpCode.Name.StartsWith("stelem"))
+							return true;
+						break;
+				}
+			}
+			return false;
+		}
+
+		// 循环位于本方法的 try 或 filter 中, 处理块能观察到局部变量的中间状态
+		private static bool IsInProtectedRegion(MethodX metX, LoopInfo loop)
+		{
+			if (!metX.ExHandlerList.IsCollectionValid())
+				return false;
+
+			foreach (var handler in metX.ExHandlerList)
+			{
+				foreach (var chandler in handler.CombinedHandlers)
+				{
+					if (loop.Preheader < chandler.TryEnd && chandler.TryStart <= loop.CondEnd)
+						return true;
+					if (chandler.FilterStart != -1 &&
+						loop.Preheader < chandler.HandlerStart && chandler.FilterStart <= loop.CondEnd)
+						return true;
+				}
+			}
+			return false;
+		}
+
+		// 从 Set 的值表达式末尾向前跳过, 返回下标加载指令的位置
+		internal static int SkipValueExpr(InstInfo[] instList, int ip, int lowerBound)
+		{
+			int need = 1;
+			while (ip >= lowerBound)
+			{
+				int push = GetPushCount(instList[ip]);
+				int pop = GetPopCount(instList[ip]);
+				if (push < 0 || pop < 0 || IsBranch(instList[ip]))
+					return -1;
+
+				need -= push;
+				if (need < 0)
+					return -1;
+				need += pop;
+
+				if (need == 0)
+				{
+					if (instList[ip].IsBrTarget)
+						return -1;
+					return PrevInst(instList, ip);
+				}
+
+				if (instList[ip].IsBrTarget)
+					return -1;
+				ip = PrevInst(instList, ip);
+			}
+			return -1;
+		}
+
+		private static int GetPushCount(InstInfo inst)
+		{
+			var code = inst.OpCode.Code;
+			if (code == Code.Call || code == Code.Callvirt || code == Code.Newobj)
+			{
+				MethodX metX = (MethodX)inst.Operand;
+				return code == Code.Newobj || metX.ReturnType.ElementType != ElementType.Void ? 1 : 0;
+			}
+
+			switch (inst.OpCode.StackBehaviourPush)
+			{
+				case StackBehaviour.Push0:
+					return 0;
+				case StackBehaviour.Push1:
+				case StackBehaviour.Pushi:
+				case StackBehaviour.Pushi8:
+				case StackBehaviour.Pushr4:
+				case StackBehaviour.Pushr8:
+				case StackBehaviour.Pushref:
+					return 1;
+				case StackBehaviour.Push1_push1:
+					return 2;
+			}
+			return -1;
+		}
+
+		private static int GetPopCount(InstInfo inst)
+		{
+			var code = inst.OpCode.Code;
+			if (code == Code.Call || code == Code.Callvirt || code == Code.Newobj)
+			{
+				MethodX metX = (MethodX)inst.Operand;
+				return metX.ParamTypes.Count - (code == Code.Newobj ? 1 : 0);
+			}
+
+			switch (inst.OpCode.StackBehaviourPop)
+			{
+				case StackBehaviour.Pop0:
+					return 0;
+				case StackBehaviour.Pop1:
+				case StackBehaviour.Popi:
+				case StackBehaviour.Popref:
+					return 1;
+				case StackBehaviour.Pop1_pop1:
+				case StackBehaviour.Popi_pop1:
+				case StackBehaviour.Popi_popi:
+				case StackBehaviour.Popi_popi8:
+				case StackBehaviour.Popi_popr4:
+				case StackBehaviour.Popi_popr8:
+				case StackBehaviour.Popref_pop1:
+				case StackBehaviour.Popref_popi:
+					return 2;
+				case StackBehaviour.Popi_popi_popi:
+				case StackBehaviour.Popref_popi_popi:
+				case StackBehaviour.Popref_popi_popi8:
+				case StackBehaviour.Popref_popi_popr4:
+				case StackBehaviour.Popref_popi_popr8:
+				case StackBehaviour.Popref_popi_popref:
+					return 3;
+			}
+			return -1;
+		}
+
+		private static bool IsSZArrayAccessor(MethodX metX)
+		{
+			if (!metX.DeclType.IsArrayType || !metX.DeclType.ArrayInfo.IsSZArray)
+				return false;
+
+			string name = metX.Def.Name;
+			return name == "Get" || name == "Set" || name == "Address";
+		}
+
+		private static bool IsMDArrayAccessor(InstInfo inst, out MethodX metX)
+		{
+			metX = null;
+			var code = inst.OpCode.Code;
+			if (code != Code.Call && code != Code.Callvirt)
+				return false;
+
+			metX = (MethodX)inst.Operand;
+			if (!metX.DeclType.IsArrayType || metX.DeclType.ArrayInfo.IsSZArray)
+				return false;
+
+			string name = metX.Def.Name;
+			return name == "Get" || name == "Set" || name == "Address";
+		}
+
+		private static bool IsArrayMethod(InstInfo inst, string name)
+		{
+			var code = inst.OpCode.Code;
+			if (code != Code.Call && code != Code.Callvirt)
+				return false;
+
+			MethodX metX = (MethodX)inst.Operand;
+			return metX.Def.Name == name && metX.DeclType.GetNameKey() == "System.Array";
+		}
+
+		private static bool IsStringMethod(InstInfo inst, string name)
+		{
+			var code = inst.OpCode.Code;
+			if (code != Code.Call && code != Code.Callvirt)
+				return false;
+
+			MethodX metX = (MethodX)inst.Operand;
+			return metX.Def.Name == name && metX.DeclType.GetNameKey() == "String";
+		}
+
+		private static bool HasBrTarget(InstInfo[] instList, int start, int end)
+		{
+			for (int i = start; i <= end; ++i)
+			{
+				if (instList[i].IsBrTarget)
+					return true;
+			}
+			return false;
+		}
+
+		private static bool IsBranch(InstInfo inst)
+		{
+			switch (inst.OpCode.FlowControl)
+			{
+				case FlowControl.Branch:
+				case FlowControl.Cond_Branch:
+					return true;
+			}
+			return false;
+		}
+
+		internal static int NextInst(InstInfo[] instList, int ip)
+		{
+			for (++ip; ip < instList.Length; ++ip)
+			{
+				if (instList[ip].OpCode.Code != Code.Nop)
+					return ip;
+			}
+			return -1;
+		}
+
+		internal static int PrevInst(InstInfo[] instList, int ip)
+		{
+			for (--ip; ip >= 0; --ip)
+			{
+				if (instList[ip].OpCode.Code != Code.Nop)
+					return ip;
+			}
+			return -1;
+		}
+
+		internal static bool GetLdcI4(InstInfo inst, out int val)
+		{
+			switch (inst.OpCode.Code)
+			{
+				case Code.Ldc_I4_0: val = 0; return true;
+				case Code.Ldc_I4_1: val = 1; return true;
+				case Code.Ldc_I4_2: val = 2; return true;
+				case Code.Ldc_I4_3: val = 3; return true;
+				case Code.Ldc_I4_4: val = 4; return true;
+				case Code.Ldc_I4_5: val = 5; return true;
+				case Code.Ldc_I4_6: val = 6; return true;
+				case Code.Ldc_I4_7: val = 7; return true;
+				case Code.Ldc_I4_8: val = 8; return true;
+				case Code.Ldc_I4_M1: val = -1; return true;
+				case Code.Ldc_I4:
+					val = (int)inst.Operand;
+					return true;
+				case Code.Ldc_I4_S:
+					val = (sbyte)inst.Operand;
+					return true;
+			}
+			val = 0;
+			return false;
+		}
+
+		private static bool GetLoadVar(InstInfo inst, out VarRef v)
+		{
+			switch (inst.OpCode.Code)
+			{
+				case Code.Ldarg_0: v = new VarRef(true, 0); return true;
+				case Code.Ldarg_1: v = new VarRef(true, 1); return true;
+				case Code.Ldarg_2: v = new VarRef(true, 2); return true;
+				case Code.Ldarg_3: v = new VarRef(true, 3); return true;
+				case Code.Ldarg:
+				case Code.Ldarg_S:
+					v = new VarRef(true, ((Parameter)inst.Operand).Index);
+					return true;
+
+				case Code.Ldloc_0: v = new VarRef(false, 0); return true;
+				case Code.Ldloc_1: v = new VarRef(false, 1); return true;
+				case Code.Ldloc_2: v = new VarRef(false, 2); return true;
+				case Code.Ldloc_3: v = new VarRef(false, 3); return true;
+				case Code.Ldloc:
+				case Code.Ldloc_S:
+					v = new VarRef(false, ((Local)inst.Operand).Index);
+					return true;
+			}
+			v = default(VarRef);
+			return false;
+		}
+
+		private static bool GetStoreVar(InstInfo inst, out VarRef v)
+		{
+			switch (inst.OpCode.Code)
+			{
+				case Code.Starg:
+				case Code.Starg_S:
+					v = new VarRef(true, ((Parameter)inst.Operand).Index);
+					return true;
+
+				case Code.Stloc_0: v = new VarRef(false, 0); return true;
+				case Code.Stloc_1: v = new VarRef(false, 1); return true;
+				case Code.Stloc_2: v = new VarRef(false, 2); return true;
+				case Code.Stloc_3: v = new VarRef(false, 3); return true;
+				case Code.Stloc:
+				case Code.Stloc_S:
+					v = new VarRef(false, ((Local)inst.Operand).Index);
+					return true;
+			}
+			v = default(VarRef);
+			return false;
+		}
+
+		private static bool GetAddrVar(InstInfo inst, out VarRef v)
+		{
+			switch (inst.OpCode.Code)
+			{
+				case Code.Ldarga:
+				case Code.Ldarga_S:
+					v = new VarRef(true, ((Parameter)inst.Operand).Index);
+					return true;
+
+				case Code.Ldloca:
+				case Code.Ldloca_S:
+					v = new VarRef(false, ((Local)inst.Operand).Index);
+					return true;
+			}
+			v = default(VarRef);
+			return false;
+		}
+	}
+}
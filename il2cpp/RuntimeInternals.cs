@@ -1,10 +1,241 @@
-﻿using System.Diagnostics;
+﻿using System.Collections.Generic;
+using System.Diagnostics;
 using System.Linq;
+using System.Text;
+using dnlib.DotNet;
 
 namespace il2cpp
 {
 	internal static class RuntimeInternals
 	{
+		// 虽有 IL 实现但由运行时接管的方法
+		private static readonly HashSet<string> ReplacedMethods = new HashSet<string>
+		{
+			"String::EqualsHelper|Boolean(String,String)|0",
+			"String::CompareOrdinalHelper|Int32(String,String)|0",
+			"String::StartsWithOrdinalHelper|Boolean(String,String)|0",
+			"String::IndexOf|Int32(Char,Int32,Int32)|20",
+			"String::Intern|String(String)|0",
+			"String::IsInterned|String(String)|0",
+			"String::Concat|String(String[])|0",
+			"Int32::ToString|String()|20",
+			"UInt32::ToString|String()|20",
+			"Int64::ToString|String()|20",
+			"UInt64::ToString|String()|20",
+			"System.Text.UTF8Encoding::GetByteCount|Int32(Char[],Int32,Int32)|20",
+			"System.Text.UTF8Encoding::GetByteCount|Int32(String)|20",
+			"System.Text.UTF8Encoding::GetByteCount|Int32(Char*,Int32)|20",
+			"System.Text.UTF8Encoding::GetBytes|Int32(String,Int32,Int32,Byte[],Int32)|20",
+			"System.Text.UTF8Encoding::GetBytes|Int32(Char[],Int32,Int32,Byte[],Int32)|20",
+			"System.Text.UTF8Encoding::GetBytes|Int32(Char*,Int32,Byte*,Int32)|20",
+			"System.Text.UTF8Encoding::GetCharCount|Int32(Byte[],Int32,Int32)|20",
+			"System.Text.UTF8Encoding::GetCharCount|Int32(Byte*,Int32)|20",
+			"System.Text.UTF8Encoding::GetChars|Int32(Byte[],Int32,Int32,Char[],Int32)|20",
+			"System.Text.UTF8Encoding::GetChars|Int32(Byte*,Int32,Char*,Int32)|20",
+			"System.Text.UTF8Encoding::GetString|String(Byte[],Int32,Int32)|20",
+			"System.Exception::get_StackTrace|String()|20",
+			"System.Threading.Thread::SetStartHelper|Void(System.Delegate,Int32)|20",
+			"System.Threading.Thread::Start|Void(System.Threading.StackCrawlMark&)|20",
+			"System.Threading.Interlocked::Increment|Int32(Int32&)|0",
+			"System.Threading.Interlocked::Increment|Int64(Int64&)|0",
+			"System.Threading.Interlocked::Decrement|Int32(Int32&)|0",
+			"System.Threading.Interlocked::Decrement|Int64(Int64&)|0",
+			"System.Threading.Interlocked::Add|Int32(Int32&,Int32)|0",
+			"System.Threading.Interlocked::Add|Int64(Int64&,Int64)|0",
+			"System.Threading.Interlocked::MemoryBarrierProcessWide|Void()|0",
+			"System.Threading.ThreadPool::QueueUserWorkItem|Boolean(System.Threading.WaitCallback)|0",
+			"System.Threading.ThreadPool::QueueUserWorkItem|Boolean(System.Threading.WaitCallback,Object)|0",
+			"System.Threading.ThreadPool::QueueUserWorkItem|Boolean(System.Threading.WaitCallback,Object,Boolean)|0",
+			"System.Threading.ThreadPool::UnsafeQueueUserWorkItem|Boolean(System.Threading.WaitCallback,Object)|0",
+			"System.Threading.ThreadPool::UnsafeQueueCustomWorkItem|Void(System.Threading.IThreadPoolWorkItem,Boolean)|0",
+			"System.Threading.ThreadPool::TryPopCustomWorkItem|Boolean(System.Threading.IThreadPoolWorkItem)|0",
+			"System.Threading.TimerQueue::EnsureAppDomainTimerFiresBy|Boolean(UInt32)|20",
+			"System.Diagnostics.Tracing.EventSource::Finalize|Void()|20",
+			"System.Diagnostics.Tracing.EventSource::SetCurrentThreadActivityId|Void(System.Guid)|0",
+			"System.Diagnostics.Tracing.EventSource::SetCurrentThreadActivityId|Void(System.Guid,System.Guid&)|0",
+		};
+
+		// 由运行时批量内核接管的泛型数组方法, 任意元素类型均可按字节块处理
+		private static readonly HashSet<string> ReplacedArrayMethods = new HashSet<string>
+		{
+			"Fill|Void(!!0[],!!0)|10",
+			"Fill|Void(!!0[],!!0,Int32,Int32)|10",
+			"Reverse|Void(!!0[])|10",
+			"Reverse|Void(!!0[],Int32,Int32)|10",
+		};
+
+		// 仅当元素为整数类型时才接管, 此时按位比较与 Equals 语义一致
+		private static readonly HashSet<string> ReplacedArraySearchMethods = new HashSet<string>
+		{
+			"IndexOf|Int32(!!0[],!!0)|10",
+			"IndexOf|Int32(!!0[],!!0,Int32)|10",
+			"IndexOf|Int32(!!0[],!!0,Int32,Int32)|10",
+			"LastIndexOf|Int32(!!0[],!!0)|10",
+			"LastIndexOf|Int32(!!0[],!!0,Int32)|10",
+			"LastIndexOf|Int32(!!0[],!!0,Int32,Int32)|10",
+		};
+
+		// 仅当键为基础数值类型或其枚举时才接管
+		private static readonly HashSet<string> ReplacedArraySortMethods = new HashSet<string>
+		{
+			"Sort|Void(!!0[])|10",
+			"Sort|Void(!!0[],Int32,Int32)|10",
+			"Sort|Void(!!0[],!!1[])|10",
+			"Sort|Void(!!0[],!!1[],Int32,Int32)|10",
+		};
+
+		// 由运行时接管的方法可能抛出的异常, 需要预先解析抛出辅助方法
+		private static readonly Dictionary<string, string[]> ReplacedMethodExceptions = new Dictionary<string, string[]>
+		{
+			{ "String::IndexOf|Int32(Char,Int32,Int32)|20", new[] { "ArgumentOutOfRangeException" } },
+			{ "String::.ctor|Void(Char,Int32)|20", new[] { "ArgumentOutOfRangeException" } },
+			{ "String::.ctor|Void(Char[],Int32,Int32)|20", new[] { "ArgumentNullException", "ArgumentOutOfRangeException" } },
+		};
+
+		// UTF-8 编码方法校验参数时抛出的异常
+		private static readonly string[] UTF8EncodingExceptions = { "ArgumentNullException", "ArgumentOutOfRangeException" };
+
+		public static string[] GetReplacedMethodExceptions(MethodX metX)
+		{
+			string key = metX.DeclType.GetNameKey() + "::" + metX.GetNameKey();
+			if (ReplacedMethodExceptions.TryGetValue(key, out var exNames))
+				return exNames;
+
+			if (metX.DeclType.GetNameKey() == "System.Text.UTF8Encoding" && ReplacedMethods.Contains(key))
+				return UTF8EncodingExceptions;
+			return null;
+		}
+
+		public static bool IsReplacedMethod(MethodX metX)
+		{
+			if (ReplacedMethods.Contains(metX.DeclType.GetNameKey() + "::" + metX.GetNameKey()))
+				return true;
+
+			// ByReference<T> 的托管实现只抛出异常, 由运行时直接读写内部指针
+			string defName = metX.DeclType.Def.FullName;
+			if (defName == "System.ByReference`1" && !metX.Def.IsStaticConstructor)
+				return true;
+			if (defName == "System.Span`1" && metX.Def.Name == "Fill")
+				return true;
+
+			// 泛型 Exchange 经由 TypedReference 实现, 直接按引用原子交换
+			if (metX.HasGenArgs && metX.DeclType.GetNameKey() == "System.Threading.Interlocked" && metX.Def.Name == "Exchange")
+				return true;
+
+			// 运行时没有 ETW, TPL 事件源除静态构造外全部接管为空操作
+			if (metX.DeclType.GetNameKey() == "System.Threading.Tasks.TplEtwProvider" && !metX.Def.IsStaticConstructor)
+				return true;
+
+			if (metX.HasGenArgs && metX.DeclType.GetNameKey() == "System.Array")
+			{
+				string defKey = GetArrayMethodDefKey(metX);
+				if (ReplacedArrayMethods.Contains(defKey))
+					return true;
+				if (ReplacedArraySearchMethods.Contains(defKey))
+					return IsBitwiseEquatable(metX.GenArgs[0]);
+				if (ReplacedArraySortMethods.Contains(defKey))
+					return GetSortKeyKind(metX.GenArgs[0]) != null;
+			}
+			return false;
+		}
+
+		private static string GetArrayMethodDefKey(MethodX metX)
+		{
+			StringBuilder sb = new StringBuilder();
+			Helper.MethodNameKeyWithGen(sb, metX.Def.Name, null, metX.DefSig.RetType, metX.DefSig.Params, metX.DefSig.CallingConvention);
+			return sb.ToString();
+		}
+
+		private static string GetSortKeyKind(TypeSig tySig)
+		{
+			switch (tySig.ElementType)
+			{
+				case ElementType.I1:
+					return "IL2CPP_SORTKEY_I1";
+				case ElementType.Boolean:
+				case ElementType.U1:
+					return "IL2CPP_SORTKEY_U1";
+				case ElementType.I2:
+					return "IL2CPP_SORTKEY_I2";
+				case ElementType.Char:
+				case ElementType.U2:
+					return "IL2CPP_SORTKEY_U2";
+				case ElementType.I4:
+					return "IL2CPP_SORTKEY_I4";
+				case ElementType.U4:
+					return "IL2CPP_SORTKEY_U4";
+				case ElementType.I8:
+					return "IL2CPP_SORTKEY_I8";
+				case ElementType.U8:
+					return "IL2CPP_SORTKEY_U8";
+				case ElementType.R4:
+					return "IL2CPP_SORTKEY_R4";
+				case ElementType.R8:
+					return "IL2CPP_SORTKEY_R8";
+				case ElementType.I:
+					return "IL2CPP_SORTKEY_I";
+				case ElementType.U:
+					return "IL2CPP_SORTKEY_U";
+			}
+
+			// 枚举按其基础类型比较
+			if (tySig.IsValueType && Helper.IsEnumType(tySig, out var enumTySig))
+				return GetSortKeyKind(enumTySig);
+			return null;
+		}
+
+		private static bool IsBitwiseEquatable(TypeSig tySig)
+		{
+			switch (tySig.ElementType)
+			{
+				case ElementType.Boolean:
+				case ElementType.Char:
+				case ElementType.I1:
+				case ElementType.I2:
+				case ElementType.I4:
+				case ElementType.I8:
+				case ElementType.U1:
+				case ElementType.U2:
+				case ElementType.U4:
+				case ElementType.U8:
+				case ElementType.I:
+				case ElementType.U:
+					return true;
+			}
+			return false;
+		}
+
+		// Span 与 ReadOnlySpan 的长度字段
+		public static FieldX GetSpanLengthField(TypeX spanTyX)
+		{
+			return spanTyX.Fields.First(fld => fld.Def.Name == "_length");
+		}
+
+		// Span 与 ReadOnlySpan 的数据指针, ByReference<T> 只包含一个 IntPtr
+		public static string GenSpanPointer(GeneratorContext genContext, TypeX spanTyX, string spanExpr)
+		{
+			FieldX fldPtr = spanTyX.Fields.First(fld => fld.Def.Name == "_pointer");
+			TypeX byRefTyX = genContext.GetTypeBySig(fldPtr.FieldType);
+			FieldX fldValue = byRefTyX.Fields.First(fld => !fld.IsStatic);
+			return string.Format("{0}.{1}.{2}",
+				spanExpr,
+				genContext.GetFieldName(fldPtr),
+				genContext.GetFieldName(fldValue));
+		}
+
+		// 获得类型 ID 对应的唯一 RuntimeType 对象
+		public static string GenRuntimeTypeObject(MethodGenerator metGen, string typeID)
+		{
+			GeneratorContext genContext = metGen.GenContext;
+			TypeX rtTyX = genContext.TypeMgr.RTType;
+			Debug.Assert(rtTyX != null);
+			metGen.RefTypeImpl(rtTyX);
+			return string.Format("il2cpp_Type__FromTypeID({0}, sizeof({1}), {2})",
+				typeID,
+				genContext.GetTypeName(rtTyX),
+				genContext.GetTypeID(rtTyX));
+		}
+
 		public static bool GenInternalMethod(MethodGenerator metGen, CodePrinter prt)
 		{
 			MethodX metX = metGen.CurrMethod;
@@ -14,6 +245,37 @@ namespace il2cpp
 			string metName = metX.Def.Name;
 			string metSigName = metX.GetNameKey();
 
+			string defName = metX.DeclType.Def.FullName;
+			if (defName == "System.ByReference`1")
+			{
+				FieldX fldValue = metX.DeclType.Fields.First(fld => !fld.IsStatic);
+				if (metName == ".ctor")
+				{
+					prt.AppendFormatLine("arg_0->{0} = ({1})arg_1;",
+						genContext.GetFieldName(fldValue),
+						genContext.GetTypeName(fldValue.FieldType));
+					return true;
+				}
+				else if (metName == "get_Value")
+				{
+					prt.AppendFormatLine("return ({0})arg_0->{1};",
+						genContext.GetTypeName(metX.ReturnType),
+						genContext.GetFieldName(fldValue));
+					return true;
+				}
+			}
+			else if (defName == "System.Span`1" && metName == "Fill")
+			{
+				// 与 Array.Fill 共用按元素大小展开的填充
+				TypeSig elemSig = metX.DeclType.GenArgs[0];
+				metGen.RefValueTypeImpl(elemSig);
+				prt.AppendFormatLine("il2cpp_Array__Fill((void*){0}, sizeof({1}), &arg_1, (uint32_t)arg_0->{2});",
+					GenSpanPointer(genContext, metX.DeclType, "(*arg_0)"),
+					genContext.GetTypeName(elemSig),
+					genContext.GetFieldName(GetSpanLengthField(metX.DeclType)));
+				return true;
+			}
+
 			if (typeName == "Object")
 			{
 				if (metName == "GetInternalTypeID")
@@ -21,6 +283,40 @@ namespace il2cpp
 					prt.AppendLine("return (int32_t)arg_0->TypeID;");
 					return true;
 				}
+				else if (metName == "MemberwiseClone")
+				{
+					prt.AppendLine("return il2cpp_MemberwiseClone(arg_0);");
+					return true;
+				}
+				else if (metName == "GetType")
+				{
+					prt.AppendFormatLine("return ({0}){1};",
+						genContext.GetTypeName(metX.ReturnType),
+						GenRuntimeTypeObject(metGen, "arg_0->TypeID"));
+					return true;
+				}
+			}
+			else if (typeName == "System.Type")
+			{
+				// 每个类型只有一个类型对象, 直接比较引用
+				if (metName == "GetTypeFromHandle")
+				{
+					TypeX rthTyX = genContext.GetTypeBySig(metX.ParamTypes[0]);
+					prt.AppendFormatLine("return ({0})arg_0.{1};",
+						genContext.GetTypeName(metX.ReturnType),
+						genContext.GetFieldName(rthTyX.Fields.First(fld => !fld.IsStatic)));
+					return true;
+				}
+				else if (metName == "op_Equality")
+				{
+					prt.AppendLine("return arg_0 == arg_1;");
+					return true;
+				}
+				else if (metName == "op_Inequality")
+				{
+					prt.AppendLine("return arg_0 != arg_1;");
+					return true;
+				}
 			}
 			else if (typeName == "String")
 			{
@@ -38,8 +334,8 @@ namespace il2cpp
 				}
 				else if (metName == "get_Chars")
 				{
-					prt.AppendFormatLine("IL2CPP_CHECK_RANGE(0, arg_0->{0}, arg_1);",
-						genContext.GetFieldName(fldLen));
+					prt.AppendLine(metGen.GenCheckSZRange(
+						"arg_0->" + genContext.GetFieldName(fldLen), "arg_1"));
 					prt.AppendFormatLine("return ((uint16_t*)&arg_0->{0})[arg_1];",
 						genContext.GetFieldName(fldFirstChar));
 
@@ -47,12 +343,87 @@ namespace il2cpp
 				}
 				else if (metName == "InternalMarvin32HashString")
 				{
-					prt.AppendFormatLine("return il2cpp_HashString(&arg_0->{0}, arg_0->{1});",
+					prt.AppendLine("return il2cpp_String__GetHashCode((il2cppString*)arg_0);");
+					return true;
+				}
+				else if (metSigName == "Intern|String(String)|0")
+				{
+					prt.AppendLine("IL2CPP_ASSERT(arg_0);");
+					prt.AppendLine("return (cls_String*)il2cpp_String__Intern((il2cppString*)arg_0);");
+					return true;
+				}
+				else if (metSigName == "Concat|String(String[])|0")
+				{
+					prt.AppendLine("IL2CPP_ASSERT(arg_0);");
+					prt.AppendFormatLine("return (cls_String*)il2cpp_String__ConcatArray({0}, {1}, (il2cppString* const*)&arg_0[1], IL2CPP_SZARRAY_LEN(arg_0));",
+						genContext.GetStringTypeID(),
+						metGen.GenStringLiteral(""));
+					return true;
+				}
+				else if (metSigName == "IsInterned|String(String)|0")
+				{
+					prt.AppendLine("IL2CPP_ASSERT(arg_0);");
+					prt.AppendLine("return (cls_String*)il2cpp_String__IsInterned((il2cppString*)arg_0);");
+					return true;
+				}
+				else if (metSigName == "EqualsHelper|Boolean(String,String)|0")
+				{
+					prt.AppendFormatLine("if (arg_0->{0} != arg_1->{0})",
+						genContext.GetFieldName(fldLen));
+					++prt.Indents;
+					prt.AppendLine("return 0;");
+					--prt.Indents;
+					prt.AppendFormatLine("return il2cpp_String__Equals(&arg_0->{0}, &arg_1->{0}, arg_0->{1}) ? 1 : 0;",
+						genContext.GetFieldName(fldFirstChar),
+						genContext.GetFieldName(fldLen));
+
+					return true;
+				}
+				else if (metSigName == "CompareOrdinalHelper|Int32(String,String)|0")
+				{
+					prt.AppendFormatLine("return il2cpp_String__CompareOrdinal(&arg_0->{0}, arg_0->{1}, &arg_1->{0}, arg_1->{1});",
+						genContext.GetFieldName(fldFirstChar),
+						genContext.GetFieldName(fldLen));
+
+					return true;
+				}
+				else if (metSigName == "CompareOrdinalHelper|Int32(String,Int32,Int32,String,Int32,Int32)|0")
+				{
+					prt.AppendFormatLine("return il2cpp_String__CompareOrdinal(&arg_0->{0} + arg_1, arg_2, &arg_3->{0} + arg_4, arg_5);",
+						genContext.GetFieldName(fldFirstChar));
+
+					return true;
+				}
+				else if (metSigName == "StartsWithOrdinalHelper|Boolean(String,String)|0")
+				{
+					prt.AppendFormatLine("if (arg_1->{0} > arg_0->{0})",
+						genContext.GetFieldName(fldLen));
+					++prt.Indents;
+					prt.AppendLine("return 0;");
+					--prt.Indents;
+					prt.AppendFormatLine("return il2cpp_String__Equals(&arg_0->{0}, &arg_1->{0}, arg_1->{1}) ? 1 : 0;",
 						genContext.GetFieldName(fldFirstChar),
 						genContext.GetFieldName(fldLen));
 
 					return true;
 				}
+				else if (metSigName == "IndexOf|Int32(Char,Int32,Int32)|20")
+				{
+					// arg_1 为字符, arg_2 为起始位置, arg_3 为查找长度
+					prt.AppendFormatLine("if ((uint32_t)arg_2 > (uint32_t)arg_0->{0} || (uint32_t)arg_3 > (uint32_t)(arg_0->{0} - arg_2))",
+						genContext.GetFieldName(fldLen));
+					prt.AppendLine("{");
+					++prt.Indents;
+					prt.AppendLine("il2cpp_ThrowArgumentOutOfRange();");
+					prt.AppendLine("return -1;");
+					--prt.Indents;
+					prt.AppendLine("}");
+					prt.AppendFormatLine("int32_t idx = il2cpp_String__IndexOf(&arg_0->{0} + arg_2, arg_3, arg_1);",
+						genContext.GetFieldName(fldFirstChar));
+					prt.AppendLine("return idx < 0 ? -1 : idx + arg_2;");
+
+					return true;
+				}
 				else if (metName == "FastAllocateString")
 				{
 					prt.AppendFormatLine(
@@ -71,6 +442,159 @@ namespace il2cpp
 						genContext.GetFieldName(fldFirstChar));
 					return true;
 				}
+				else if (metSigName == ".ctor|Void(Char,Int32)|20")
+				{
+					prt.AppendLine("if (arg_2 < 0)");
+					prt.AppendLine("{");
+					++prt.Indents;
+					prt.AppendLine("il2cpp_ThrowArgumentOutOfRange();");
+					prt.AppendLine("return;");
+					--prt.Indents;
+					prt.AppendLine("}");
+					prt.AppendFormatLine("arg_0->{0} = arg_2;",
+						genContext.GetFieldName(fldLen));
+					prt.AppendFormatLine("uint16_t* dst = (uint16_t*)&arg_0->{0};",
+						genContext.GetFieldName(fldFirstChar));
+					prt.AppendLine("for (int32_t i = 0; i < arg_2; ++i)");
+					++prt.Indents;
+					prt.AppendLine("dst[i] = arg_1;");
+					--prt.Indents;
+					return true;
+				}
+				else if (metSigName == ".ctor|Void(Char[])|20")
+				{
+					// 空数组引用构造空字符串
+					prt.AppendLine("if (!arg_1)");
+					++prt.Indents;
+					prt.AppendLine("return;");
+					--prt.Indents;
+					prt.AppendFormatLine("arg_0->{0} = (int32_t)IL2CPP_SZARRAY_LEN(arg_1);",
+						genContext.GetFieldName(fldLen));
+					prt.AppendFormatLine("IL2CPP_MEMCPY(&arg_0->{0}, &arg_1[1], sizeof(uint16_t) * arg_0->{1});",
+						genContext.GetFieldName(fldFirstChar),
+						genContext.GetFieldName(fldLen));
+					return true;
+				}
+				else if (metSigName == ".ctor|Void(Char[],Int32,Int32)|20")
+				{
+					prt.AppendLine("if (!arg_1)");
+					prt.AppendLine("{");
+					++prt.Indents;
+					prt.AppendLine("il2cpp_ThrowArgumentNull();");
+					prt.AppendLine("return;");
+					--prt.Indents;
+					prt.AppendLine("}");
+					prt.AppendLine("if (arg_2 < 0 || arg_3 < 0 || arg_2 > (int32_t)IL2CPP_SZARRAY_LEN(arg_1) - arg_3)");
+					prt.AppendLine("{");
+					++prt.Indents;
+					prt.AppendLine("il2cpp_ThrowArgumentOutOfRange();");
+					prt.AppendLine("return;");
+					--prt.Indents;
+					prt.AppendLine("}");
+					prt.AppendFormatLine("arg_0->{0} = arg_3;",
+						genContext.GetFieldName(fldLen));
+					prt.AppendFormatLine("IL2CPP_MEMCPY(&arg_0->{0}, (const uint16_t*)&arg_1[1] + arg_2, sizeof(uint16_t) * arg_3);",
+						genContext.GetFieldName(fldFirstChar));
+					return true;
+				}
+				else if (metSigName == ".ctor|Void(Char*)|20")
+				{
+					// 空指针构造空字符串
+					prt.AppendLine("if (!arg_1)");
+					++prt.Indents;
+					prt.AppendLine("return;");
+					--prt.Indents;
+					prt.AppendFormatLine("arg_0->{0} = IL2CPP_STRLEN16(arg_1);",
+						genContext.GetFieldName(fldLen));
+					prt.AppendFormatLine("IL2CPP_MEMCPY(&arg_0->{0}, arg_1, sizeof(uint16_t) * arg_0->{1});",
+						genContext.GetFieldName(fldFirstChar),
+						genContext.GetFieldName(fldLen));
+					return true;
+				}
+				else if (metSigName == ".ctor|Void(System.ReadOnlySpan`1<Char>)|20")
+				{
+					// 对象大小已由跨度长度算出
+					TypeX spanTyX = genContext.GetTypeBySig(metX.ParamTypes[1]);
+					prt.AppendFormatLine("arg_0->{0} = arg_1.{1};",
+						genContext.GetFieldName(fldLen),
+						genContext.GetFieldName(GetSpanLengthField(spanTyX)));
+					prt.AppendFormatLine("IL2CPP_MEMCPY(&arg_0->{0}, (const void*){1}, sizeof(uint16_t) * arg_0->{2});",
+						genContext.GetFieldName(fldFirstChar),
+						GenSpanPointer(genContext, spanTyX, "arg_1"),
+						genContext.GetFieldName(fldLen));
+					return true;
+				}
+				else if (metSigName == ".ctor|Void(SByte*)|20")
+				{
+					// 对象大小已由 IL2CPP_TOUTF16LEN 算出, 这里直接解码
+					prt.AppendLine("int32_t srcLen = (int32_t)IL2CPP_STRLEN((const char*)arg_1);");
+					prt.AppendFormatLine("arg_0->{0} = il2cpp_UTF8__GetChars((const uint8_t*)arg_1, srcLen, &arg_0->{1}, il2cpp_UTF8__GetCharCount((const uint8_t*)arg_1, srcLen, false), false);",
+						genContext.GetFieldName(fldLen),
+						genContext.GetFieldName(fldFirstChar));
+					return true;
+				}
+				else if (metSigName == ".ctor|Void(SByte*,Int32,Int32)|20")
+				{
+					prt.AppendLine("IL2CPP_ASSERT(arg_2 >= 0 && arg_3 >= 0);");
+					prt.AppendLine("const uint8_t* src = (const uint8_t*)arg_1 + arg_2;");
+					prt.AppendFormatLine("arg_0->{0} = il2cpp_UTF8__GetChars(src, arg_3, &arg_0->{1}, il2cpp_UTF8__GetCharCount(src, arg_3, false), false);",
+						genContext.GetFieldName(fldLen),
+						genContext.GetFieldName(fldFirstChar));
+					return true;
+				}
+			}
+			else if (typeName == "Int32" || typeName == "Int64")
+			{
+				// 十进制格式化不依赖区域设置
+				if (metSigName == "ToString|String()|20")
+				{
+					prt.AppendFormatLine("return (cls_String*)il2cpp_String__FromInt64(*arg_0, {0});",
+						genContext.GetStringTypeID());
+					return true;
+				}
+			}
+			else if (typeName == "UInt32" || typeName == "UInt64")
+			{
+				if (metSigName == "ToString|String()|20")
+				{
+					prt.AppendFormatLine("return (cls_String*)il2cpp_String__FromUInt64(*arg_0, {0});",
+						genContext.GetStringTypeID());
+					return true;
+				}
+			}
+			else if (typeName == "System.Exception")
+			{
+				// 由抛出时记录的返回地址延迟生成
+				if (metSigName == "get_StackTrace|String()|20")
+				{
+					prt.AppendFormatLine("return (cls_String*)il2cpp_Exception__GetStackTrace((cls_Object*)arg_0, {0});",
+						genContext.GetStringTypeID());
+					return true;
+				}
+				// 没有可复制的原生栈信息, 重新抛出时保留原异常对象即可
+				else if (metName == "GetStackTracesDeepCopy")
+				{
+					prt.AppendLine("*arg_1 = nullptr;");
+					prt.AppendLine("*arg_2 = nullptr;");
+					return true;
+				}
+				else if (metName == "SaveStackTracesFromDeepCopy" ||
+						 metName == "PrepareForForeignExceptionRaise")
+				{
+					return true;
+				}
+				else if (metName == "CopyStackTrace" ||
+						 metName == "CopyDynamicMethods" ||
+						 metName == "IsImmutableAgileException")
+				{
+					prt.AppendLine("return 0;");
+					return true;
+				}
+			}
+			else if (typeName == "System.Text.UTF8Encoding")
+			{
+				if (GenUTF8EncodingMethod(metGen, metSigName, prt))
+					return true;
 			}
 			else if (typeName == "System.Array")
 			{
@@ -118,6 +642,20 @@ namespace il2cpp
 					prt.AppendLine("return il2cpp_Array__Clear(arg_0, arg_1, arg_2);");
 					return true;
 				}
+				else if (metName == "TrySZReverse")
+				{
+					prt.AppendLine("if (arg_0->Rank != 0)");
+					++prt.Indents;
+					prt.AppendLine("return 0;");
+					--prt.Indents;
+					prt.AppendLine("il2cpp_Array__Reverse((uint8_t*)&arg_0[1] + arg_1 * arg_0->ElemSize, arg_0->ElemSize, arg_2);");
+					prt.AppendLine("return 1;");
+					return true;
+				}
+				else if (metX.HasGenArgs && GenArrayBulkMethod(metGen, metName, prt))
+				{
+					return true;
+				}
 			}
 			else if (typeName == "System.Runtime.CompilerServices.RuntimeHelpers")
 			{
@@ -201,10 +739,21 @@ namespace il2cpp
 			}
 			else if (typeName == "Internal.Runtime.CompilerServices.Unsafe")
 			{
-				if (metName == "As")
+				if (GenUnsafeMethod(metGen, metName, prt))
+					return true;
+			}
+			else if (typeName == "System.Delegate")
+			{
+				if (metName == "InternalEqualTypes")
+				{
+					prt.AppendLine("return arg_0->TypeID == arg_1->TypeID ? 1 : 0;");
+					return true;
+				}
+				else if (metName == "InternalEqualMethodHandles")
 				{
-					prt.AppendFormatLine("return ({0})arg_0;",
-						genContext.GetTypeName(metX.ReturnType));
+					// 委托只记录函数地址, 地址相同即为同一方法
+					prt.AppendFormatLine("return arg_0->{0} == arg_1->{0} ? 1 : 0;",
+						genContext.GetFieldName(metX.DeclType.Fields.First(fld => fld.Def.Name == "_methodPtr")));
 					return true;
 				}
 			}
@@ -262,24 +811,794 @@ namespace il2cpp
 					prt.AppendLine("il2cpp_SpinUnlock(arg_0->Flags[0]);");
 					return true;
 				}
+				else if (metName == "ObjWait")
+				{
+					prt.AppendLine("return il2cpp_Monitor__Wait(arg_2, arg_2->Flags[0], arg_1);");
+					return true;
+				}
+				else if (metName == "ObjPulse")
+				{
+					prt.AppendLine("il2cpp_Monitor__Pulse(arg_0, 0);");
+					return true;
+				}
+				else if (metName == "ObjPulseAll")
+				{
+					prt.AppendLine("il2cpp_Monitor__Pulse(arg_0, 1);");
+					return true;
+				}
 			}
-			else if (typeName == "System.Threading.Interlocked")
+			else if (typeName == "System.Threading.ThreadPool")
+			{
+				if (GenThreadPoolMethod(metGen, metSigName, prt))
+					return true;
+			}
+			else if (typeName == TypeManager.NsIl2cppRT + ".ParallelHelper")
 			{
-				if (metName == "CompareExchange")
+				if (metName == "For")
 				{
-					prt.AppendLine("return il2cpp_CompareExchange(arg_0, arg_1, arg_2);");
+					// 由 Parallel.For 降级而来, arg_3 为分段方法的地址
+					prt.AppendLine("il2cpp_ParallelFor(arg_0, arg_1, 0, (IL2CPP_PARALLELFOR_FUNC)arg_3, arg_2);");
 					return true;
 				}
 			}
-			else if (typeName == "System.GC")
+			else if (typeName == "System.Threading.TimerQueue")
 			{
-				if (metName == "_Collect")
+				if (metName == "EnsureAppDomainTimerFiresBy")
 				{
-					prt.AppendLine("il2cpp_GC_Collect();");
+					GenTimerQueueSchedule(metGen, prt);
 					return true;
 				}
 			}
-
+			else if (typeName == "System.Threading.Tasks.TplEtwProvider")
+			{
+				// 不初始化 EventSource, 各事件的 IsEnabled 检查均为假
+				if (metX.ReturnType.ElementType != dnlib.DotNet.ElementType.Void)
+					prt.AppendLine("return {};");
+				return true;
+			}
+			else if (typeName == "System.Diagnostics.Tracing.EventSource")
+			{
+				if (metName == "Finalize")
+				{
+					// 没有需要释放的原生事件提供者
+					return true;
+				}
+				else if (metSigName == "SetCurrentThreadActivityId|Void(System.Guid)|0")
+				{
+					return true;
+				}
+				else if (metSigName == "SetCurrentThreadActivityId|Void(System.Guid,System.Guid&)|0")
+				{
+					prt.AppendLine("*arg_1 = {};");
+					return true;
+				}
+			}
+			else if (typeName == "System.Diagnostics.Debugger")
+			{
+				if (metName == "get_IsAttached" || metName == "IsLogging" || metName == "LaunchInternal")
+				{
+					prt.AppendLine("return 0;");
+					return true;
+				}
+				else if (metName == "Log" || metName == "CustomNotification")
+				{
+					return true;
+				}
+				else if (metName == "BreakInternal")
+				{
+					prt.AppendLine("IL2CPP_TRAP;");
+					return true;
+				}
+			}
+			else if (typeName == "System.Environment")
+			{
+				if (metName == "GetProcessorCount")
+				{
+					prt.AppendLine("return il2cpp_ProcessorCount();");
+					return true;
+				}
+				else if (metName == "get_TickCount")
+				{
+					prt.AppendLine("return il2cpp_TickCount();");
+					return true;
+				}
+				else if (metName == "get_CurrentProcessorNumber")
+				{
+					// 返回 -1 表示不支持, 调用方会退回到按线程分配
+					prt.AppendLine("return -1;");
+					return true;
+				}
+			}
+			else if (typeName == "System.Diagnostics.Tracing.XplatEventLogger" ||
+					 typeName == "System.Diagnostics.Tracing.EventPipeInternal")
+			{
+				// 运行时没有事件跟踪, 报告未启用并忽略写入
+				if (metX.ReturnType.ElementType == ElementType.Void)
+					return true;
+				prt.AppendLine("return 0;");
+				return true;
+			}
+			else if (typeName == "System.Threading.Interlocked")
+			{
+				int numArgs = metX.ParamTypes.Count;
+				if (metName == "CompareExchange" && numArgs == 3)
+				{
+					prt.AppendLine("return il2cpp_CompareExchange(arg_0, arg_1, arg_2);");
+					return true;
+				}
+				else if (metName == "CompareExchange" && numArgs == 4)
+				{
+					prt.AppendLine("int32_t ret = il2cpp_CompareExchange(arg_0, arg_1, arg_2);");
+					prt.AppendLine("*arg_3 = ret == arg_2 ? 1 : 0;");
+					prt.AppendLine("return ret;");
+					return true;
+				}
+				else if (metName == "Exchange" && numArgs == 2)
+				{
+					prt.AppendLine("return il2cpp_Exchange(arg_0, arg_1);");
+					return true;
+				}
+				else if (metName == "ExchangeAdd")
+				{
+					prt.AppendLine("return il2cpp_ExchangeAdd(arg_0, arg_1);");
+					return true;
+				}
+				else if (metName == "Add")
+				{
+					prt.AppendLine("return il2cpp_InterlockedAdd(arg_0, arg_1);");
+					return true;
+				}
+				else if (metName == "Increment" || metName == "Decrement")
+				{
+					prt.AppendFormatLine("return il2cpp_InterlockedAdd(arg_0, ({0})({1}));",
+						genContext.GetTypeName(metX.ReturnType),
+						metName == "Increment" ? "1" : "-1");
+					return true;
+				}
+				else if (metName == "MemoryBarrier" ||
+						 metName == "MemoryBarrierProcessWide" ||
+						 metName == "_MemoryBarrierProcessWide")
+				{
+					prt.AppendLine("IL2CPP_MEMORY_BARRIER();");
+					return true;
+				}
+			}
+			else if (typeName == "System.GC")
+			{
+				if (metName == "_Collect")
+				{
+					prt.AppendLine("il2cpp_GC_Collect();");
+					return true;
+				}
+				else if (metName == "_SuppressFinalize")
+				{
+					prt.AppendLine("il2cpp_SuppressFinalize(arg_0);");
+					return true;
+				}
+				else if (metName == "_ReRegisterForFinalize")
+				{
+					prt.AppendLine("il2cpp_ReRegisterForFinalize(arg_0);");
+					return true;
+				}
+			}
+			else if (typeName == "System.Threading.Thread" ||
+					 typeName == "Internal.Runtime.Augments.RuntimeThread")
+			{
+				if (GenThreadMethod(metGen, metName, prt))
+					return true;
+			}
+
+			return false;
+		}
+
+		private static bool GenUnsafeMethod(MethodGenerator metGen, string metName, CodePrinter prt)
+		{
+			MethodX metX = metGen.CurrMethod;
+			GeneratorContext genContext = metGen.GenContext;
+			string retType = metX.ReturnType.ElementType == ElementType.Void ? null : genContext.GetTypeName(metX.ReturnType);
+
+			// 泛型实参 T 的类型名
+			string ElemType()
+			{
+				TypeSig elemSig = metX.GenArgs[0];
+				metGen.RefValueTypeImpl(elemSig);
+				return genContext.GetTypeName(elemSig);
+			}
+
+			switch (metName)
+			{
+				case "As":
+				case "AsPointer":
+					prt.AppendFormatLine("return ({0})arg_0;", retType);
+					return true;
+
+				case "SizeOf":
+					prt.AppendFormatLine("return (int32_t)sizeof({0});", ElemType());
+					return true;
+
+				case "Add":
+					// void* 版本按元素大小偏移, 引用版本直接做指针运算
+					if (metX.ParamTypes[0].ElementType == ElementType.Ptr)
+						prt.AppendFormatLine("return (uint8_t*)arg_0 + (intptr_t)arg_1 * (intptr_t)sizeof({0});", ElemType());
+					else
+						prt.AppendLine("return arg_0 + (intptr_t)arg_1;");
+					return true;
+
+				case "AddByteOffset":
+					prt.AppendFormatLine("return ({0})((uint8_t*)arg_0 + (intptr_t)arg_1);", retType);
+					return true;
+
+				case "AreSame":
+					prt.AppendLine("return arg_0 == arg_1 ? 1 : 0;");
+					return true;
+
+				case "ByteOffset":
+					prt.AppendLine("return (intptr_t)((uint8_t*)arg_1 - (uint8_t*)arg_0);");
+					return true;
+
+				case "ReadUnaligned":
+					prt.AppendFormatLine("{0} val;", retType);
+					prt.AppendLine("IL2CPP_MEMCPY(&val, (const void*)arg_0, sizeof(val));");
+					prt.AppendLine("return val;");
+					return true;
+
+				case "WriteUnaligned":
+					prt.AppendLine("IL2CPP_MEMCPY((void*)arg_0, &arg_1, sizeof(arg_1));");
+					return true;
+			}
+			return false;
+		}
+
+		private static bool GenThreadPoolMethod(MethodGenerator metGen, string metSigName, CodePrinter prt)
+		{
+			GeneratorContext genContext = metGen.GenContext;
+
+			string GetDispatcher(string name)
+			{
+				TypeX hlpTyX = genContext.GetTypeByName(TypeManager.NsIl2cppRT + ".ThreadPoolHelper");
+				metGen.RefTypeImpl(hlpTyX);
+				return genContext.GetMethodName(hlpTyX.Methods.First(met => met.Def.Name == name), MethodGenerator.PrefixMet);
+			}
+
+			switch (metSigName)
+			{
+				case "QueueUserWorkItem|Boolean(System.Threading.WaitCallback)|0":
+				case "QueueUserWorkItem|Boolean(System.Threading.WaitCallback,Object)|0":
+				case "QueueUserWorkItem|Boolean(System.Threading.WaitCallback,Object,Boolean)|0":
+				case "UnsafeQueueUserWorkItem|Boolean(System.Threading.WaitCallback,Object)|0":
+					// 不捕获执行上下文, 直接在工作线程上调用委托
+					prt.AppendLine("IL2CPP_ASSERT(arg_0);");
+					prt.AppendFormatLine("il2cpp_ThreadPool__Queue((IL2CPP_WORKITEM_FUNC)&{0}, (cls_Object*)arg_0, {1}, {2});",
+						GetDispatcher("InvokeWaitCallback"),
+						metSigName.Contains(",Object") ? "(cls_Object*)arg_1" : "nullptr",
+						metSigName.Contains(",Boolean") ? "arg_2" : "0");
+					prt.AppendLine("return 1;");
+					return true;
+
+				case "UnsafeQueueCustomWorkItem|Void(System.Threading.IThreadPoolWorkItem,Boolean)|0":
+					prt.AppendLine("IL2CPP_ASSERT(arg_0);");
+					prt.AppendFormatLine("il2cpp_ThreadPool__Queue((IL2CPP_WORKITEM_FUNC)&{0}, (cls_Object*)arg_0, nullptr, !arg_1);",
+						GetDispatcher("ExecuteWorkItem"));
+					return true;
+
+				case "TryPopCustomWorkItem|Boolean(System.Threading.IThreadPoolWorkItem)|0":
+					prt.AppendLine("return il2cpp_ThreadPool__TryPop((cls_Object*)arg_0);");
+					return true;
+
+				case "GetMinThreadsNative|Void(Int32&,Int32&)|0":
+				case "GetMaxThreadsNative|Void(Int32&,Int32&)|0":
+					prt.AppendLine("*arg_0 = il2cpp_ThreadPool__GetWorkerCount();");
+					prt.AppendLine("*arg_1 = 0;");
+					return true;
+
+				case "GetAvailableThreadsNative|Void(Int32&,Int32&)|0":
+					prt.AppendLine("*arg_0 = il2cpp_ThreadPool__GetWorkerCount() - il2cpp_ThreadPool__GetBusyCount();");
+					prt.AppendLine("*arg_1 = 0;");
+					return true;
+
+				case "SetMinThreadsNative|Boolean(Int32,Int32)|0":
+				case "SetMaxThreadsNative|Boolean(Int32,Int32)|0":
+					// 工作线程数固定, 只能在首次排队前设置
+					prt.AppendLine("return il2cpp_ThreadPool__SetWorkerCount(arg_0);");
+					return true;
+			}
+			return false;
+		}
+
+		private static void GenTimerQueueSchedule(MethodGenerator metGen, CodePrinter prt)
+		{
+			GeneratorContext genContext = metGen.GenContext;
+			TypeX tqTyX = metGen.CurrMethod.DeclType;
+
+			string Field(string name)
+			{
+				return "arg_0->" + genContext.GetFieldName(tqTyX.Fields.First(fld => fld.Def.Name == name));
+			}
+
+			string fldScheduled = Field("m_isAppDomainTimerScheduled");
+			string fldStartTicks = Field("m_currentAppDomainTimerStartTicks");
+			string fldDuration = Field("m_currentAppDomainTimerDuration");
+
+			// 与原实现相同的提前返回判断, 原生的 AppDomain 计时器由运行时计时线程代替
+			prt.AppendLine("uint32_t duration = IL2CPP_MIN(arg_1, 0x0FFFFFFFu);");
+			prt.AppendFormatLine("if ({0})", fldScheduled);
+			prt.AppendLine("{");
+			++prt.Indents;
+			prt.AppendFormatLine("uint32_t elapsed = (uint32_t)(il2cpp_TickCount() - {0});", fldStartTicks);
+			prt.AppendFormatLine("if (elapsed >= {0} || duration >= {0} - elapsed)", fldDuration);
+			++prt.Indents;
+			prt.AppendLine("return 1;");
+			--prt.Indents;
+			--prt.Indents;
+			prt.AppendLine("}");
+			prt.AppendFormatLine("if ({0} != 0)", Field("m_pauseTicks"));
+			++prt.Indents;
+			prt.AppendLine("return 1;");
+			--prt.Indents;
+
+			MethodX cbMetX = tqTyX.Methods.First(met => met.Def.Name == "AppDomainTimerCallback");
+			prt.AppendFormatLine("il2cpp_Timer__Schedule({0}, duration, &{1});",
+				Field("m_id"),
+				genContext.GetMethodName(cbMetX, MethodGenerator.PrefixMet));
+			prt.AppendFormatLine("{0} = 1;", fldScheduled);
+			prt.AppendFormatLine("{0} = il2cpp_TickCount();", fldStartTicks);
+			prt.AppendFormatLine("{0} = duration;", fldDuration);
+			prt.AppendLine("return 1;");
+		}
+
+		private static bool GenThreadMethod(MethodGenerator metGen, string metName, CodePrinter prt)
+		{
+			GeneratorContext genContext = metGen.GenContext;
+
+			// 原生线程状态保存在 Thread.DONT_USE_InternalThread 中
+			TypeX thTyX = genContext.GetTypeByName("System.Threading.Thread");
+			if (thTyX == null)
+				return false;
+			metGen.RefTypeImpl(thTyX);
+
+			string thName = genContext.GetTypeName(thTyX);
+			string fldNative = genContext.GetFieldName(thTyX.Fields.First(
+				fld => fld.Def.Name == "DONT_USE_InternalThread"));
+			string thNative = string.Format("((il2cppThread*)(({0}*)arg_0)->{1})", thName, fldNative);
+
+			switch (metName)
+			{
+				case "SetStartHelper":
+					{
+						// 直接保存委托, 不经过 ThreadHelper 与执行上下文
+						TypeX paramTyX = genContext.GetTypeByName("System.Threading.ParameterizedThreadStart");
+						prt.AppendFormatLine("arg_0->{0} = arg_1;",
+							genContext.GetFieldName(thTyX.Fields.First(fld => fld.Def.Name == "m_Delegate")));
+						prt.AppendFormatLine("arg_0->{0} = (intptr_t)il2cpp_Thread__Create({1}, arg_2);",
+							fldNative,
+							paramTyX != null ? string.Format("arg_1->TypeID == {0}", genContext.GetTypeID(paramTyX)) : "0");
+					}
+					return true;
+
+				case "Start":
+				case "StartInternal":
+					{
+						TypeX dlgTyX = genContext.GetTypeByName("System.Delegate");
+						metGen.RefTypeImpl(dlgTyX);
+						FieldX fldArg = thTyX.Fields.First(fld => fld.Def.Name == "m_ThreadStartArg");
+
+						prt.AppendFormatLine("{0}* dlg = ({0}*)arg_0->{1};",
+							genContext.GetTypeName(dlgTyX),
+							genContext.GetFieldName(thTyX.Fields.First(fld => fld.Def.Name == "m_Delegate")));
+						prt.AppendLine("IL2CPP_ASSERT(dlg);");
+						prt.AppendFormatLine("il2cpp_Thread__Start({0}, (cls_Object*)arg_0, (cls_Object*)dlg->{1}, (void*)dlg->{2}, (cls_Object*)arg_0->{3});",
+							thNative,
+							genContext.GetFieldName(dlgTyX.Fields.First(fld => fld.Def.Name == "_target")),
+							genContext.GetFieldName(dlgTyX.Fields.First(fld => fld.Def.Name == "_methodPtr")),
+							genContext.GetFieldName(fldArg));
+						prt.AppendFormatLine("arg_0->{0} = nullptr;",
+							genContext.GetFieldName(fldArg));
+					}
+					return true;
+
+				case "GetCurrentThreadNative":
+					// 首次访问时为未经 Start 创建的线程附加托管对象
+					prt.AppendLine("cls_Object* cur = il2cpp_Thread__GetCurrent();");
+					prt.AppendLine("if (IL2CPP_LIKELY(cur != nullptr))");
+					++prt.Indents;
+					prt.AppendFormatLine("return ({0}*)cur;", thName);
+					--prt.Indents;
+					prt.AppendFormatLine("{0}* th = ({0}*)IL2CPP_NEW(sizeof({0}), {1}, 0);",
+						thName,
+						genContext.GetTypeID(thTyX));
+					prt.AppendFormatLine("th->{0} = (intptr_t)il2cpp_Thread__Attach((cls_Object*)th);",
+						fldNative);
+					prt.AppendLine("return th;");
+					return true;
+
+				case "InternalFinalize":
+					prt.AppendFormatLine("il2cpp_Thread__Finalize({0});", thNative);
+					prt.AppendFormatLine("arg_0->{0} = 0;", fldNative);
+					return true;
+
+				case "get_ManagedThreadId":
+					prt.AppendFormatLine("return il2cpp_Thread__GetManagedID({0});", thNative);
+					return true;
+
+				case "JoinInternal":
+					prt.AppendFormatLine("return il2cpp_Thread__Join({0}, arg_1);", thNative);
+					return true;
+
+				case "get_IsAlive":
+					prt.AppendFormatLine("return (il2cpp_Thread__GetState({0}) & (8 | 16)) == 0;", thNative);
+					return true;
+
+				case "IsBackgroundNative":
+					prt.AppendFormatLine("return il2cpp_Thread__IsBackground({0});", thNative);
+					return true;
+
+				case "SetBackgroundNative":
+					prt.AppendFormatLine("il2cpp_Thread__SetBackground({0}, arg_1);", thNative);
+					return true;
+
+				case "GetThreadStateNative":
+					prt.AppendFormatLine("return il2cpp_Thread__GetState({0});", thNative);
+					return true;
+
+				case "get_IsThreadPoolThread":
+					prt.AppendLine("return 0;");
+					return true;
+
+				case "GetPriorityNative":
+					// 不调整系统线程优先级, 始终为 Normal
+					prt.AppendLine("return 2;");
+					return true;
+
+				case "SetPriorityNative":
+				case "InformThreadNameChange":
+					return true;
+
+				case "GetFastDomainInternal":
+				case "GetDomainInternal":
+					{
+						// 只有一个默认域, 不经过构造函数创建
+						TypeX adTyX = genContext.GetTypeByName("System.AppDomain");
+						metGen.RefTypeImpl(adTyX);
+						prt.AppendFormatLine("return ({0}*)il2cpp_AppDomain__Get(sizeof({0}), {1});",
+							genContext.GetTypeName(adTyX),
+							genContext.GetTypeID(adTyX));
+					}
+					return true;
+
+				case "SleepInternal":
+					prt.AppendLine("il2cpp_Thread__Sleep(arg_0);");
+					return true;
+
+				case "SpinWaitInternal":
+					prt.AppendLine("il2cpp_Thread__SpinWait(arg_0);");
+					return true;
+
+				case "YieldInternal":
+					prt.AppendLine("il2cpp_Yield();");
+					prt.AppendLine("return 1;");
+					return true;
+			}
+			return false;
+		}
+
+		private static bool GenUTF8EncodingMethod(MethodGenerator metGen, string metSigName, CodePrinter prt)
+		{
+			// 快速路径只处理合法输入, 非法序列和目标空间不足时交给托管实现,
+			// 由其按编码的回退策略替换或抛出异常
+			GeneratorContext genContext = metGen.GenContext;
+			TypeX strTyX = genContext.GetTypeByName("String");
+			string strLen = genContext.GetFieldName(strTyX.Fields.First(
+				fld => fld.FieldType.ElementType == dnlib.DotNet.ElementType.I4));
+			string strFirstChar = genContext.GetFieldName(strTyX.Fields.First(
+				fld => fld.FieldType.ElementType == dnlib.DotNet.ElementType.Char));
+			string retFail = metSigName.StartsWith("GetString") ? "return nullptr;" : "return 0;";
+
+			string Managed(string sigName)
+			{
+				return genContext.GetMethodName(
+					metGen.CurrMethod.DeclType.Methods.First(met => met.GetNameKey() == sigName),
+					MethodGenerator.PrefixMet);
+			}
+
+			void CheckArg(string cond, string throwFunc)
+			{
+				prt.AppendFormatLine("if ({0})", cond);
+				prt.AppendLine("{");
+				++prt.Indents;
+				prt.AppendFormatLine("{0}();", throwFunc);
+				prt.AppendLine(retFail);
+				--prt.Indents;
+				prt.AppendLine("}");
+			}
+
+			void CheckNull(string cond)
+			{
+				CheckArg(cond, "il2cpp_ThrowArgumentNull");
+			}
+
+			void CheckSlice(string length, string index, string count)
+			{
+				CheckArg(string.Format("{1} < 0 || {2} < 0 || {1} > (int32_t){0} - {2}", length, index, count),
+					"il2cpp_ThrowArgumentOutOfRange");
+			}
+
+			void CheckDest(string length, string index)
+			{
+				CheckArg(string.Format("{1} < 0 || {1} > (int32_t){0}", length, index),
+					"il2cpp_ThrowArgumentOutOfRange");
+			}
+
+			void ReturnOrFallback(string fastCall, string managedSig, string managedArgs)
+			{
+				prt.AppendFormatLine("int32_t result = {0};", fastCall);
+				prt.AppendLine("if (IL2CPP_UNLIKELY(result < 0))");
+				++prt.Indents;
+				prt.AppendFormatLine("result = {0}(arg_0, {1}, nullptr);", Managed(managedSig), managedArgs);
+				--prt.Indents;
+				prt.AppendLine("return result;");
+			}
+
+			const string sigByteCount = "GetByteCount|Int32(Char*,Int32,System.Text.EncoderNLS)|20";
+			const string sigBytes = "GetBytes|Int32(Char*,Int32,Byte*,Int32,System.Text.EncoderNLS)|20";
+			const string sigCharCount = "GetCharCount|Int32(Byte*,Int32,System.Text.DecoderNLS)|20";
+			const string sigChars = "GetChars|Int32(Byte*,Int32,Char*,Int32,System.Text.DecoderNLS)|20";
+
+			switch (metSigName)
+			{
+				case "GetByteCount|Int32(Char[],Int32,Int32)|20":
+					CheckNull("!arg_1");
+					CheckSlice("IL2CPP_SZARRAY_LEN(arg_1)", "arg_2", "arg_3");
+					prt.AppendLine("uint16_t* src = (uint16_t*)&arg_1[1] + arg_2;");
+					ReturnOrFallback("il2cpp_UTF8__GetByteCount(src, arg_3, true)",
+						sigByteCount, "src, arg_3");
+					return true;
+
+				case "GetByteCount|Int32(String)|20":
+					CheckNull("!arg_1");
+					prt.AppendFormatLine("uint16_t* src = (uint16_t*)&arg_1->{0};", strFirstChar);
+					ReturnOrFallback(string.Format("il2cpp_UTF8__GetByteCount(src, arg_1->{0}, true)", strLen),
+						sigByteCount, "src, arg_1->" + strLen);
+					return true;
+
+				case "GetByteCount|Int32(Char*,Int32)|20":
+					CheckNull("!arg_1");
+					CheckArg("arg_2 < 0", "il2cpp_ThrowArgumentOutOfRange");
+					ReturnOrFallback("il2cpp_UTF8__GetByteCount(arg_1, arg_2, true)",
+						sigByteCount, "arg_1, arg_2");
+					return true;
+
+				case "GetBytes|Int32(String,Int32,Int32,Byte[],Int32)|20":
+					CheckNull("!arg_1 || !arg_4");
+					CheckSlice("arg_1->" + strLen, "arg_2", "arg_3");
+					prt.AppendLine("int32_t dstLen = (int32_t)IL2CPP_SZARRAY_LEN(arg_4);");
+					CheckDest("dstLen", "arg_5");
+					prt.AppendFormatLine("uint16_t* src = (uint16_t*)&arg_1->{0} + arg_2;", strFirstChar);
+					prt.AppendLine("uint8_t* dst = (uint8_t*)&arg_4[1] + arg_5;");
+					ReturnOrFallback("il2cpp_UTF8__GetBytes(src, arg_3, dst, dstLen - arg_5, true)",
+						sigBytes, "src, arg_3, dst, dstLen - arg_5");
+					return true;
+
+				case "GetBytes|Int32(Char[],Int32,Int32,Byte[],Int32)|20":
+					CheckNull("!arg_1 || !arg_4");
+					CheckSlice("IL2CPP_SZARRAY_LEN(arg_1)", "arg_2", "arg_3");
+					prt.AppendLine("int32_t dstLen = (int32_t)IL2CPP_SZARRAY_LEN(arg_4);");
+					CheckDest("dstLen", "arg_5");
+					prt.AppendLine("uint16_t* src = (uint16_t*)&arg_1[1] + arg_2;");
+					prt.AppendLine("uint8_t* dst = (uint8_t*)&arg_4[1] + arg_5;");
+					ReturnOrFallback("il2cpp_UTF8__GetBytes(src, arg_3, dst, dstLen - arg_5, true)",
+						sigBytes, "src, arg_3, dst, dstLen - arg_5");
+					return true;
+
+				case "GetBytes|Int32(Char*,Int32,Byte*,Int32)|20":
+					CheckNull("!arg_1 || !arg_3");
+					CheckArg("arg_2 < 0 || arg_4 < 0", "il2cpp_ThrowArgumentOutOfRange");
+					ReturnOrFallback("il2cpp_UTF8__GetBytes(arg_1, arg_2, arg_3, arg_4, true)",
+						sigBytes, "arg_1, arg_2, arg_3, arg_4");
+					return true;
+
+				case "GetCharCount|Int32(Byte[],Int32,Int32)|20":
+					CheckNull("!arg_1");
+					CheckSlice("IL2CPP_SZARRAY_LEN(arg_1)", "arg_2", "arg_3");
+					prt.AppendLine("uint8_t* src = (uint8_t*)&arg_1[1] + arg_2;");
+					ReturnOrFallback("il2cpp_UTF8__GetCharCount(src, arg_3, true)",
+						sigCharCount, "src, arg_3");
+					return true;
+
+				case "GetCharCount|Int32(Byte*,Int32)|20":
+					CheckNull("!arg_1");
+					CheckArg("arg_2 < 0", "il2cpp_ThrowArgumentOutOfRange");
+					ReturnOrFallback("il2cpp_UTF8__GetCharCount(arg_1, arg_2, true)",
+						sigCharCount, "arg_1, arg_2");
+					return true;
+
+				case "GetChars|Int32(Byte[],Int32,Int32,Char[],Int32)|20":
+					CheckNull("!arg_1 || !arg_4");
+					CheckSlice("IL2CPP_SZARRAY_LEN(arg_1)", "arg_2", "arg_3");
+					prt.AppendLine("int32_t dstLen = (int32_t)IL2CPP_SZARRAY_LEN(arg_4);");
+					CheckDest("dstLen", "arg_5");
+					prt.AppendLine("uint8_t* src = (uint8_t*)&arg_1[1] + arg_2;");
+					prt.AppendLine("uint16_t* dst = (uint16_t*)&arg_4[1] + arg_5;");
+					ReturnOrFallback("il2cpp_UTF8__GetChars(src, arg_3, dst, dstLen - arg_5, true)",
+						sigChars, "src, arg_3, dst, dstLen - arg_5");
+					return true;
+
+				case "GetChars|Int32(Byte*,Int32,Char*,Int32)|20":
+					CheckNull("!arg_1 || !arg_3");
+					CheckArg("arg_2 < 0 || arg_4 < 0", "il2cpp_ThrowArgumentOutOfRange");
+					ReturnOrFallback("il2cpp_UTF8__GetChars(arg_1, arg_2, arg_3, arg_4, true)",
+						sigChars, "arg_1, arg_2, arg_3, arg_4");
+					return true;
+
+				case "GetString|String(Byte[],Int32,Int32)|20":
+					CheckNull("!arg_1");
+					CheckSlice("IL2CPP_SZARRAY_LEN(arg_1)", "arg_2", "arg_3");
+					prt.AppendLine("uint8_t* src = (uint8_t*)&arg_1[1] + arg_2;");
+					prt.AppendLine("int32_t len = il2cpp_UTF8__GetCharCount(src, arg_3, true);");
+					prt.AppendLine("bool isValid = len >= 0;");
+					prt.AppendLine("if (IL2CPP_UNLIKELY(!isValid))");
+					prt.AppendLine("{");
+					++prt.Indents;
+					prt.AppendFormatLine("len = {0}(arg_0, src, arg_3, nullptr);", Managed(sigCharCount));
+					if (genContext.IsStatusException)
+					{
+						prt.AppendLine("if (IL2CPP_PENDING_EXCEPTION)");
+						++prt.Indents;
+						prt.AppendLine(retFail);
+						--prt.Indents;
+					}
+					--prt.Indents;
+					prt.AppendLine("}");
+					prt.AppendFormatLine(
+						"cls_String* str = (cls_String*)IL2CPP_NEW(sizeof(cls_String) + sizeof(uint16_t) * len, {0}, 1);",
+						genContext.GetStringTypeID());
+					prt.AppendLine("if (IL2CPP_LIKELY(isValid))");
+					++prt.Indents;
+					prt.AppendFormatLine("str->{0} = il2cpp_UTF8__GetChars(src, arg_3, &str->{1}, len, true);",
+						strLen,
+						strFirstChar);
+					--prt.Indents;
+					prt.AppendLine("else");
+					++prt.Indents;
+					prt.AppendFormatLine("str->{0} = {1}(arg_0, src, arg_3, &str->{2}, len, nullptr);",
+						strLen,
+						Managed(sigChars),
+						strFirstChar);
+					--prt.Indents;
+					prt.AppendLine("return str;");
+					return true;
+			}
+			return false;
+		}
+
+		private static bool GenArrayBulkMethod(MethodGenerator metGen, string metName, CodePrinter prt)
+		{
+			MethodX metX = metGen.CurrMethod;
+			int paramCount = metX.DefSig.Params.Count;
+			TypeSig elemSig = metX.GenArgs[0];
+			metGen.RefValueTypeImpl(elemSig);
+			string elemPtr = string.Format("(({0}*)&arg_0[1])", metGen.GenContext.GetTypeName(elemSig));
+
+			// 参数校验失败时与切片检查一致地陷入
+			if (metName == "Fill")
+			{
+				prt.AppendLine("IL2CPP_ASSERT(arg_0);");
+				if (paramCount == 2)
+					prt.AppendLine("il2cpp_Array__Fill(&arg_0[1], sizeof(arg_1), &arg_1, arg_0->Length);");
+				else
+				{
+					prt.AppendLine("IL2CPP_CHECK_SLICE(arg_0->Length, arg_2, arg_3);");
+					prt.AppendFormatLine("il2cpp_Array__Fill({0} + arg_2, sizeof(arg_1), &arg_1, arg_3);", elemPtr);
+				}
+				return true;
+			}
+			else if (metName == "Reverse")
+			{
+				prt.AppendLine("IL2CPP_ASSERT(arg_0);");
+				if (paramCount == 1)
+					prt.AppendLine("il2cpp_Array__Reverse(&arg_0[1], arg_0->ElemSize, arg_0->Length);");
+				else
+				{
+					prt.AppendLine("IL2CPP_CHECK_SLICE(arg_0->Length, arg_1, arg_2);");
+					prt.AppendFormatLine("il2cpp_Array__Reverse({0} + arg_1, arg_0->ElemSize, arg_2);", elemPtr);
+				}
+				return true;
+			}
+			else if (metName == "IndexOf")
+			{
+				prt.AppendLine("IL2CPP_ASSERT(arg_0);");
+				if (paramCount == 2)
+				{
+					prt.AppendLine("return il2cpp_Array__IndexOf(&arg_0[1], sizeof(arg_1), &arg_1, arg_0->Length);");
+					return true;
+				}
+
+				if (paramCount == 3)
+				{
+					prt.AppendLine("IL2CPP_CHECK_SLICE(arg_0->Length, arg_2, 0);");
+					prt.AppendLine("int32_t count = (int32_t)arg_0->Length - arg_2;");
+				}
+				else
+				{
+					prt.AppendLine("IL2CPP_CHECK_SLICE(arg_0->Length, arg_2, arg_3);");
+					prt.AppendLine("int32_t count = arg_3;");
+				}
+				prt.AppendFormatLine("int32_t idx = il2cpp_Array__IndexOf({0} + arg_2, sizeof(arg_1), &arg_1, count);", elemPtr);
+				prt.AppendLine("return idx < 0 ? -1 : idx + arg_2;");
+				return true;
+			}
+			else if (metName == "LastIndexOf")
+			{
+				prt.AppendLine("IL2CPP_ASSERT(arg_0);");
+				if (paramCount == 2)
+				{
+					prt.AppendLine("return il2cpp_Array__LastIndexOf(&arg_0[1], sizeof(arg_1), &arg_1, arg_0->Length);");
+					return true;
+				}
+
+				// 空数组时任何起始位置都返回 -1
+				prt.AppendLine("if (arg_0->Length == 0)");
+				++prt.Indents;
+				prt.AppendLine("return -1;");
+				--prt.Indents;
+				prt.AppendLine(metGen.GenCheckSZRange("arg_0->Length", "arg_2"));
+				if (paramCount == 3)
+					prt.AppendLine("int32_t count = arg_2 + 1;");
+				else
+				{
+					prt.AppendLine("IL2CPP_CHECK_SLICE(arg_0->Length, (int64_t)arg_2 - arg_3 + 1, arg_3);");
+					prt.AppendLine("int32_t count = arg_3;");
+				}
+				prt.AppendLine("int32_t first = arg_2 - count + 1;");
+				prt.AppendFormatLine("int32_t idx = il2cpp_Array__LastIndexOf({0} + first, sizeof(arg_1), &arg_1, count);", elemPtr);
+				prt.AppendLine("return idx < 0 ? -1 : idx + first;");
+				return true;
+			}
+			else if (metName == "Sort")
+			{
+				string keyKind = GetSortKeyKind(elemSig);
+				Debug.Assert(keyKind != null);
+
+				prt.AppendLine("IL2CPP_ASSERT(arg_0);");
+				if (metX.GenArgs.Count == 1)
+				{
+					if (paramCount == 1)
+						prt.AppendFormatLine("il2cpp_Array__Sort(&arg_0[1], {0}, arg_0->Length);", keyKind);
+					else
+					{
+						prt.AppendLine("IL2CPP_CHECK_SLICE(arg_0->Length, arg_1, arg_2);");
+						prt.AppendFormatLine("il2cpp_Array__Sort({0} + arg_1, {1}, arg_2);", elemPtr, keyKind);
+					}
+					return true;
+				}
+
+				TypeSig itemSig = metX.GenArgs[1];
+				metGen.RefValueTypeImpl(itemSig);
+				string itemPtr = string.Format("(({0}*)&arg_1[1])", metGen.GenContext.GetTypeName(itemSig));
+
+				string index = "0";
+				string length = "arg_0->Length";
+				if (paramCount == 4)
+				{
+					index = "arg_2";
+					length = "arg_3";
+					prt.AppendLine("IL2CPP_CHECK_SLICE(arg_0->Length, arg_2, arg_3);");
+				}
+
+				// 值数组为空时只排序键
+				prt.AppendLine("if (arg_1 == nullptr)");
+				++prt.Indents;
+				prt.AppendFormatLine("il2cpp_Array__Sort({0} + {1}, {2}, {3});", elemPtr, index, keyKind, length);
+				--prt.Indents;
+				prt.AppendLine("else");
+				prt.AppendLine("{");
+				++prt.Indents;
+				prt.AppendFormatLine("IL2CPP_CHECK_SLICE(arg_1->Length, {0}, {1});", index, length);
+				prt.AppendFormatLine("il2cpp_Array__SortItems({0} + {1}, {2}, {3} + {1}, arg_1->ElemSize, {4});",
+					elemPtr, index, keyKind, itemPtr, length);
+				--prt.Indents;
+				prt.AppendLine("}");
+				return true;
+			}
 			return false;
 		}
 
@@ -0,0 +1,217 @@
+﻿using System.Collections.Generic;
+using dnlib.DotNet;
+using dnlib.DotNet.Emit;
+
+namespace il2cpp
+{
+	// 编译期构造的只读数组对象
+	internal class StaticArrayInfo
+	{
+		public FieldX Field;
+		public TypeX ArrayType;
+		public int Length;
+		public byte[] Data;
+
+		// 初始化序列中的 newobj 与 InitializeArray 调用
+		public InstInfo NewInst;
+		public InstInfo InitInst;
+	}
+
+	// 查找只在静态构造中由 RVA 数据初始化, 且之后从不写入的静态数组字段
+	internal static class StaticArrayAnalyzer
+	{
+		public static void Analyze(IEnumerable<TypeX> types)
+		{
+			var metList = new List<MethodX>();
+			foreach (var tyX in types)
+			{
+				foreach (var metX in tyX.Methods)
+				{
+					if (metX.InstList != null)
+						metList.Add(metX);
+				}
+			}
+
+			// 收集静态构造中的初始化序列
+			Dictionary<FieldX, StaticArrayInfo> inits = null;
+			HashSet<FieldX> rejected = null;
+			foreach (var metX in metList)
+			{
+				if (!metX.Def.IsStaticConstructor)
+					continue;
+
+				var instList = metX.InstList;
+				for (int i = 0; i < instList.Length; ++i)
+				{
+					var info = MatchInit(metX, instList, i);
+					if (info == null)
+						continue;
+
+					if (inits == null)
+						inits = new Dictionary<FieldX, StaticArrayInfo>();
+					if (inits.ContainsKey(info.Field))
+						Reject(ref rejected, info.Field);
+					else
+						inits.Add(info.Field, info);
+				}
+			}
+
+			if (inits == null)
+				return;
+
+			// 任何写入, 取地址或无法证明只读的加载都会使字段失去资格
+			foreach (var metX in metList)
+			{
+				var instList = metX.InstList;
+				for (int i = 0; i < instList.Length; ++i)
+				{
+					var inst = instList[i];
+					if (!(inst.Operand is FieldX fldX) || !inits.TryGetValue(fldX, out var info))
+						continue;
+
+					switch (inst.OpCode.Code)
+					{
+						case Code.Ldsfld:
+							if (!IsReadOnlyUse(instList, i, info.ArrayType))
+								Reject(ref rejected, fldX);
+							break;
+
+						case Code.Stsfld:
+							{
+								int prev = RangeCheckAnalyzer.PrevInst(instList, i);
+								if (prev < 0 || instList[prev] != info.InitInst)
+									Reject(ref rejected, fldX);
+							}
+							break;
+
+						default:
+							Reject(ref rejected, fldX);
+							break;
+					}
+				}
+			}
+
+			foreach (var info in inits.Values)
+			{
+				if (rejected != null && rejected.Contains(info.Field))
+					continue;
+
+				info.NewInst.StaticArray = info;
+				info.InitInst.StaticArray = info;
+			}
+		}
+
+		private static void Reject(ref HashSet<FieldX> rejected, FieldX fldX)
+		{
+			if (rejected == null)
+				rejected = new HashSet<FieldX>();
+			rejected.Add(fldX);
+		}
+
+		// ldc.i4 N; newobj T[]::.ctor(int32); dup; ldtoken F; call InitializeArray; stsfld X
+		private static StaticArrayInfo MatchInit(MethodX metX, InstInfo[] instList, int store)
+		{
+			var stInst = instList[store];
+			if (stInst.OpCode.Code != Code.Stsfld || stInst.IsBrTarget)
+				return null;
+
+			FieldX fldX = (FieldX)stInst.Operand;
+			if (fldX.DeclType != metX.DeclType || !fldX.Def.IsInitOnly || fldX.IsThreadStatic)
+				return null;
+
+			int call = RangeCheckAnalyzer.PrevInst(instList, store);
+			if (call < 0 || instList[call].IsBrTarget || instList[call].OpCode.Code != Code.Call)
+				return null;
+			MethodX initMetX = (MethodX)instList[call].Operand;
+			if (initMetX.Def.Name != "InitializeArray" ||
+				initMetX.DeclType.GetNameKey() != "System.Runtime.CompilerServices.RuntimeHelpers")
+				return null;
+
+			int token = RangeCheckAnalyzer.PrevInst(instList, call);
+			if (token < 0 || instList[token].IsBrTarget || instList[token].OpCode.Code != Code.Ldtoken ||
+				!(instList[token].Operand is FieldX dataFldX))
+				return null;
+
+			int dup = RangeCheckAnalyzer.PrevInst(instList, token);
+			if (dup < 0 || instList[dup].IsBrTarget || instList[dup].OpCode.Code != Code.Dup)
+				return null;
+
+			int newobj = RangeCheckAnalyzer.PrevInst(instList, dup);
+			if (newobj < 0 || instList[newobj].OpCode.Code != Code.Newobj)
+				return null;
+			MethodX ctorMetX = (MethodX)instList[newobj].Operand;
+			TypeX aryType = ctorMetX.DeclType;
+			if (aryType.ArrayInfo == null || !aryType.ArrayInfo.IsSZArray)
+				return null;
+
+			int len = RangeCheckAnalyzer.PrevInst(instList, newobj);
+			if (len < 0 || !RangeCheckAnalyzer.GetLdcI4(instList[len], out int length) || length <= 0)
+				return null;
+
+			int elemSize = GetElemSize(aryType.GenArgs[0]);
+			byte[] initValue = dataFldX.Def.InitialValue;
+			if (elemSize == 0 || initValue == null || initValue.Length < (long)length * elemSize)
+				return null;
+
+			byte[] data = new byte[length * elemSize];
+			System.Array.Copy(initValue, data, data.Length);
+
+			return new StaticArrayInfo
+			{
+				Field = fldX,
+				ArrayType = aryType,
+				Length = length,
+				Data = data,
+				NewInst = instList[newobj],
+				InitInst = instList[call]
+			};
+		}
+
+		// ldsfld X 之后只能是 ldlen 或者 T[]::Get(int32) 的数组参数
+		private static bool IsReadOnlyUse(InstInfo[] instList, int load, TypeX aryType)
+		{
+			int next = RangeCheckAnalyzer.NextInst(instList, load);
+			if (next < 0 || instList[next].IsBrTarget)
+				return false;
+			if (instList[next].OpCode.Code == Code.Ldlen)
+				return true;
+
+			for (int i = next, end = System.Math.Min(instList.Length, next + 32); i < end; ++i)
+			{
+				var code = instList[i].OpCode.Code;
+				if (code != Code.Call && code != Code.Callvirt)
+					continue;
+
+				MethodX metX = (MethodX)instList[i].Operand;
+				if (metX.DeclType == aryType && metX.Def.Name == "Get" &&
+					RangeCheckAnalyzer.SkipValueExpr(instList, RangeCheckAnalyzer.PrevInst(instList, i), next) == load)
+					return true;
+			}
+			return false;
+		}
+
+		private static int GetElemSize(TypeSig elemType)
+		{
+			switch (elemType.ElementType)
+			{
+				case ElementType.Boolean:
+				case ElementType.I1:
+				case ElementType.U1:
+					return 1;
+				case ElementType.Char:
+				case ElementType.I2:
+				case ElementType.U2:
+					return 2;
+				case ElementType.I4:
+				case ElementType.U4:
+				case ElementType.R4:
+					return 4;
+				case ElementType.I8:
+				case ElementType.U8:
+				case ElementType.R8:
+					return 8;
+			}
+			return 0;
+		}
+	}
+}
@@ -1,4 +1,5 @@
 ﻿using System.Collections.Generic;
+using System.Linq;
 using System.Text;
 
 namespace il2cpp
@@ -8,14 +9,16 @@ namespace il2cpp
 		private class StringProp
 		{
 			public int ConstIndex;
-			public int UnitIndex;
+			public uint Hash;
+			// 对象头在字符串数据块中的偏移 (以 uint16_t 为单位)
+			public uint Offset;
 		}
 
+		public const string BlobUnitName = "il2cppStringBlob";
+
 		private readonly Dictionary<string, StringProp> StringMap = new Dictionary<string, StringProp>();
 
 		private int CurrConstIndex;
-		private int CurrUnitIndex = 1;
-		private int CurrAccLength;
 
 		public bool HasStrings { get; private set; }
 
@@ -26,6 +29,7 @@ namespace il2cpp
 			{
 				prop = new StringProp();
 				prop.ConstIndex = ++CurrConstIndex;
+				prop.Hash = HashString(str);
 
 				StringMap.Add(str, prop);
 			}
@@ -36,73 +40,222 @@ namespace il2cpp
 		{
 			foreach (var unit in unitMap.Values)
 			{
-				foreach (string strDep in unit.StringDepends)
-				{
-					unit.ImplDepends.Add(StringToUnitName(strDep));
-				}
+				if (unit.StringDepends.Count > 0)
+					unit.ImplDepends.Add(BlobUnitName);
 			}
 
-			Dictionary<int, List<string>> unitStrMap = new Dictionary<int, List<string>>();
-			foreach (var kv in StringMap)
+			var unitBlob = new CompileUnit();
+			unitBlob.Name = BlobUnitName;
+
+			var strList = StringMap.OrderBy(kv => kv.Value.ConstIndex).ToList();
+			unitBlob.ImplCode = GenBlobCode(strList, strTypeID) + GenLiteralTable(strList);
+			unitBlob.DeclCode = GenBlobDecl(strList);
+
+			unitMap[unitBlob.Name] = unitBlob;
+		}
+
+		private string GenBlobCode(List<KeyValuePair<string, StringProp>> strList, uint strTypeID)
+		{
+			// 每个字面量: hash, TypeID, Flags, len, 字符, 结尾 0, 按 4 字节对齐
+			CodePrinter prt = new CodePrinter();
+			prt.AppendLine("alignas(8) const uint16_t il2cpp_StringBlob[] =\n{");
+			++prt.Indents;
+
+			uint offset = 0;
+			foreach (var kv in strList)
 			{
-				int unitIdx = kv.Value.UnitIndex;
-				if (!unitStrMap.TryGetValue(unitIdx, out var strList))
+				string str = kv.Key;
+				StringProp prop = kv.Value;
+				prop.Offset = offset + 2;
+
+				prt.AppendFormatLine("// {0} ", Helper.EscapeString(str));
+				prt.AppendFormat("IL2CPP_STR_U32(0x{0:X8}), IL2CPP_STR_U32({1}), IL2CPP_STR_U32(IL2CPP_OBJFLAG_LITERAL << 8), IL2CPP_STR_U32({2}),",
+					prop.Hash,
+					strTypeID,
+					str.Length);
+
+				uint recLen = 8 + (uint)str.Length + 1;
+				foreach (char c in str)
+					prt.AppendFormat(" {0},", (ushort)c);
+				prt.Append(" 0,");
+				if ((recLen & 1) != 0)
 				{
-					strList = new List<string>();
-					unitStrMap.Add(unitIdx, strList);
+					prt.Append(" 0,");
+					++recLen;
 				}
-				strList.Add(kv.Key);
+				prt.AppendLine();
+
+				offset += recLen;
 			}
 
-			foreach (var kv in unitStrMap)
-			{
-				var unit = new CompileUnit();
+			--prt.Indents;
+			prt.AppendLine("};");
+			return prt.ToString();
+		}
 
-				unit.Name = GetUnitName(kv.Key);
-				unit.DeclCode = GenStringCode(kv.Value, strTypeID);
+		private string GenBlobDecl(List<KeyValuePair<string, StringProp>> strList)
+		{
+			CodePrinter prt = new CodePrinter();
+			prt.AppendLine("extern const uint16_t il2cpp_StringBlob[];");
+			prt.AppendLine("extern const il2cppLiteralTable il2cpp_LiteralTable;");
 
-				unitMap[unit.Name] = unit;
+			foreach (var kv in strList)
+			{
+				prt.AppendFormatLine("#define {0} IL2CPP_STR_LITERAL({1})",
+					GetConstName(kv.Value.ConstIndex),
+					kv.Value.Offset);
 			}
+			return prt.ToString();
 		}
 
-		private string StringToUnitName(string str)
+		private string GenLiteralTable(List<KeyValuePair<string, StringProp>> strList)
 		{
-			StringProp prop = StringMap[str];
-			if (prop.UnitIndex == 0)
+			// 哈希值相同的字面量放入溢出表
+			var hashSet = new HashSet<uint>();
+			var keys = new List<KeyValuePair<string, StringProp>>();
+			var overflows = new List<KeyValuePair<string, StringProp>>();
+			foreach (var kv in strList)
 			{
-				prop.UnitIndex = CurrUnitIndex;
-				CurrAccLength += str.Length;
+				if (hashSet.Add(kv.Value.Hash))
+					keys.Add(kv);
+				else
+					overflows.Add(kv);
+			}
+
+			// 构建完美哈希表 (hash and displace)
+			uint slotCount = (uint)(keys.Count + keys.Count / 4 + 1);
+			uint bucketCount = (uint)(keys.Count / 4 + 1);
+
+			var buckets = new List<KeyValuePair<string, StringProp>>[bucketCount];
+			for (int i = 0; i < bucketCount; ++i)
+				buckets[i] = new List<KeyValuePair<string, StringProp>>();
+			foreach (var kv in keys)
+				buckets[kv.Value.Hash % bucketCount].Add(kv);
 
-				if (CurrAccLength > 3000)
+			var slots = new KeyValuePair<string, StringProp>[slotCount];
+			var disps = new uint[bucketCount];
+			var placed = new List<uint>();
+			foreach (int b in Enumerable.Range(0, (int)bucketCount).OrderByDescending(b => buckets[b].Count))
+			{
+				var bucket = buckets[b];
+				if (bucket.Count == 0)
+					break;
+
+				for (uint disp = 0; ; ++disp)
 				{
-					CurrAccLength = 0;
-					++CurrUnitIndex;
+					placed.Clear();
+					foreach (var kv in bucket)
+					{
+						uint slot = LiteralSlot(kv.Value.Hash, disp) % slotCount;
+						if (slots[slot].Key != null || placed.Contains(slot))
+							break;
+						placed.Add(slot);
+					}
+
+					if (placed.Count == bucket.Count)
+					{
+						for (int i = 0; i < placed.Count; ++i)
+							slots[placed[i]] = bucket[i];
+						disps[b] = disp;
+						break;
+					}
 				}
 			}
 
-			return GetUnitName(prop.UnitIndex);
+			CodePrinter prt = new CodePrinter();
+			prt.AppendLine("static const il2cppString* const s_LiteralSlots[] =\n{");
+			++prt.Indents;
+			foreach (var kv in slots)
+			{
+				if (kv.Key != null)
+					prt.AppendFormatLine("{0},", GetConstName(kv.Value.ConstIndex));
+				else
+					prt.AppendLine("nullptr,");
+			}
+			--prt.Indents;
+			prt.AppendLine("};");
+
+			prt.AppendLine("static const uint32_t s_LiteralDisps[] =\n{");
+			++prt.Indents;
+			prt.AppendLine(string.Join(",", disps));
+			--prt.Indents;
+			prt.AppendLine("};");
+
+			if (overflows.Count > 0)
+			{
+				prt.AppendLine("static const il2cppString* const s_LiteralOverflows[] =\n{");
+				++prt.Indents;
+				foreach (var kv in overflows)
+					prt.AppendFormatLine("{0},", GetConstName(kv.Value.ConstIndex));
+				--prt.Indents;
+				prt.AppendLine("};");
+			}
+
+			prt.AppendFormatLine("const il2cppLiteralTable il2cpp_LiteralTable {{ s_LiteralSlots, s_LiteralDisps, {0}, {1}, {2}, {3} }};",
+				overflows.Count > 0 ? "s_LiteralOverflows" : "nullptr",
+				slotCount,
+				bucketCount,
+				overflows.Count);
+
+			return prt.ToString();
 		}
 
-		private string GenStringCode(List<string> strList, uint strTypeID)
+		// 与运行时 il2cpp_HashString 的算法保持一致
+		public static uint HashString(string str)
 		{
-			CodePrinter prt = new CodePrinter();
+			const uint seed = 0x14AE055C;
+			const uint laneMul = 0x9E3779B9;
+			const uint tailMul = 0x85EBCA6B;
 
-			foreach (string str in strList)
+			int len = str.Length;
+			int blocks = len / 16;
+
+			uint[] lanes = new uint[8];
+			for (uint i = 0; i < 8; ++i)
+				lanes[i] = seed ^ (i * laneMul);
+
+			for (int b = 0; b < blocks; ++b)
 			{
-				StringProp prop = StringMap[str];
+				int p = b * 16;
+				for (int i = 0; i < 8; ++i)
+				{
+					uint w = str[p + i * 2] | ((uint)str[p + i * 2 + 1] << 16);
+					lanes[i] = (lanes[i] + (lanes[i] << 5)) ^ w;
+				}
+			}
 
-				string strAry = StringToArrayOrRaw(str, out bool isRaw);
+			uint h = seed ^ (uint)len;
+			if (blocks != 0)
+			{
+				for (int i = 0; i < 8; ++i)
+					h = (h ^ lanes[i]) * laneMul;
+			}
 
-				prt.AppendFormatLine("// {0} ", Helper.EscapeString(str));
-				prt.AppendFormatLine("static const struct {{ cls_Object obj; uint32_t len; {5} str[{0}]; }} {1} {{ {{{2}}}, {3}, {4} }};",
-					str.Length + 1,
-					GetConstName(prop.ConstIndex),
-					strTypeID,
-					str.Length,
-					strAry,
-					isRaw ? "char16_t" : "uint16_t");
+			int pos = blocks * 16;
+			for (; pos + 2 <= len; pos += 2)
+			{
+				uint w = str[pos] | ((uint)str[pos + 1] << 16);
+				h = (h ^ w) * tailMul;
 			}
-			return prt.ToString();
+			if (pos < len)
+				h = (h ^ str[pos]) * tailMul;
+
+			return HashFinalize(h);
+		}
+
+		private static uint HashFinalize(uint h)
+		{
+			h ^= h >> 16;
+			h *= 0x85EBCA6B;
+			h ^= h >> 13;
+			h *= 0xC2B2AE35;
+			h ^= h >> 16;
+			return h;
+		}
+
+		private static uint LiteralSlot(uint hash, uint disp)
+		{
+			return HashFinalize(hash ^ (disp * 0x9E3779B9));
 		}
 
 		public static string StringToArrayOrRaw(string str, out bool isRaw)
@@ -156,10 +309,5 @@ namespace il2cpp
 		{
 			return "il2cppStr_" + idx;
 		}
-
-		private static string GetUnitName(int idx)
-		{
-			return "il2cppString_" + idx;
-		}
 	}
 }
@@ -184,10 +184,17 @@ namespace il2cpp
 			CodePrinter prtImpl = new CodePrinter();
 
 			// 生成静态字段
+			List<FieldX> tlsFields = new List<FieldX>();
 			foreach (var sfldX in sfields)
 			{
 				RefValueTypeDecl(unit, sfldX.FieldType);
 
+				if (sfldX.IsThreadStatic)
+				{
+					tlsFields.Add(sfldX);
+					continue;
+				}
+
 				string sfldName = GenContext.GetFieldName(sfldX);
 				string fldDecl = string.Format("{0} {1};",
 					GenContext.GetTypeName(sfldX.FieldType),
@@ -196,13 +203,36 @@ namespace il2cpp
 				prtDecl.AppendFormatLine("// {0} -> {1}",
 					Helper.EscapeString(sfldX.DeclType.GetNameKey()),
 					Helper.EscapeString(sfldX.GetReplacedNameKey()));
+
+				if (sfldX.IsRVAData)
+				{
+					// 直接引用只读段中的数据, 无需运行时初始化
+					string dataName = RVADataName(sfldX);
+					prtDecl.AppendFormatLine("extern const uint8_t {0}[];", dataName);
+					prtDecl.AppendFormatLine("#define {0} (*({1}*){2})",
+						sfldName,
+						GenContext.GetTypeName(sfldX.FieldType),
+						dataName);
+					prtImpl.AppendFormatLine("alignas(8) const uint8_t {0}[] = {1};",
+						dataName,
+						Helper.ByteArrayToCode(PadRVAData(sfldX.Def.InitialValue)));
+					continue;
+				}
+
 				prtDecl.AppendLine("extern " + fldDecl);
 				prtImpl.AppendLine(fldDecl);
 
 				bool hasRef = GenContext.IsRefOrContainsRef(GenContext.GetTypeBySig(sfldX.FieldType));
-				GenContext.AddStaticField(strTypeName, sfldName, hasRef);
+				// String.Empty 由运行时初始化为驻留的空字符串
+				string initValue = null;
+				if (sfldX.Def.Name == "Empty" && sfldX.DeclType.GetNameKey() == "String")
+					initValue = "(cls_String*)" + GenContext.StrGen.AddString("");
+				GenContext.AddStaticField(strTypeName, sfldName, hasRef, initValue);
 			}
 
+			if (tlsFields.Count != 0)
+				GenThreadStaticBlock(strTypeName, tlsFields, prtDecl, prtImpl);
+
 			// 生成类型判断函数
 			GenIsTypeFunc(prtDecl, prtImpl, currIsObject);
 
@@ -237,6 +267,45 @@ namespace il2cpp
 			return unit;
 		}
 
+		private void GenThreadStaticBlock(string strTypeName, List<FieldX> tlsFields, CodePrinter prtDecl, CodePrinter prtImpl)
+		{
+			// 线程静态字段合并为每线程一个 TLS 块, 字段名定义为块成员的别名
+			string blockType = strTypeName + "_ThreadStatics";
+			string blockName = blockType + "_TLS";
+
+			prtDecl.AppendFormatLine("// {0} -> [ThreadStatic]",
+				Helper.EscapeString(CurrType.GetNameKey()));
+			prtDecl.AppendFormatLine("struct {0}\n{{", blockType);
+			++prtDecl.Indents;
+
+			bool hasRef = false;
+			foreach (var sfldX in tlsFields)
+			{
+				prtDecl.AppendLine("// " + Helper.EscapeString(sfldX.GetReplacedNameKey()));
+				prtDecl.AppendFormatLine("{0} {1};",
+					GenContext.GetTypeName(sfldX.FieldType),
+					GenContext.GetFieldName(sfldX));
+
+				hasRef |= GenContext.IsRefOrContainsRef(GenContext.GetTypeBySig(sfldX.FieldType));
+			}
+
+			--prtDecl.Indents;
+			prtDecl.AppendLine("};");
+
+			prtDecl.AppendFormatLine("extern IL2CPP_THREAD_STATIC {0} {1};", blockType, blockName);
+			foreach (var sfldX in tlsFields)
+			{
+				string sfldName = GenContext.GetFieldName(sfldX);
+				prtDecl.AppendFormatLine("#define {0} ({1}.{0})", sfldName, blockName);
+			}
+
+			prtImpl.AppendFormatLine("IL2CPP_THREAD_STATIC {0} {1};", blockType, blockName);
+
+			// 含引用的块需要在每个线程上注册为 GC 根
+			if (hasRef)
+				GenContext.AddThreadStaticBlock(strTypeName, blockName);
+		}
+
 		private void GenIsTypeFunc(CodePrinter prtDecl, CodePrinter prtImpl, bool currIsObject)
 		{
 			if (CurrType.IsValueType || !CurrType.NeedGenIsType)
@@ -365,6 +434,10 @@ namespace il2cpp
 			{
 				prt.AppendFormatLine("#define IL2CPP_BRIDGE_HAS_{0}",
 					GenContext.GetMethodName(metX, null));
+				// 运行时可按原名引用, 无需知道名字中的哈希
+				prt.AppendFormatLine("#define IL2CPP_BRIDGE_{0} {1}",
+					metX.Def.Name,
+					GenContext.GetMethodName(metX, MethodGenerator.PrefixMet));
 			}
 		}
 
@@ -426,7 +499,10 @@ namespace il2cpp
 					string varInitData = null;
 					if (hasInitValue)
 					{
-						varInitData = GenMetaBytesLiteral(prtImpl, "InitData", initValue, strMDataName);
+						if (fldX.IsRVAData)
+							varInitData = RVADataName(fldX);
+						else
+							varInitData = GenMetaBytesLiteral(prtImpl, "InitData", initValue, strMDataName);
 					}
 
 					prtImpl.AppendFormatLine("{0} =", strDecl);
@@ -487,6 +563,23 @@ namespace il2cpp
 			return varName;
 		}
 
+		private string RVADataName(FieldX fldX)
+		{
+			return GenContext.GetFieldName(fldX) + "_RVA";
+		}
+
+		private static byte[] PadRVAData(byte[] data)
+		{
+			// 补齐到 8 字节, 按字段类型读取时不越过数组末尾
+			int len = (data.Length + 7) & ~7;
+			if (len == data.Length)
+				return data;
+
+			byte[] result = new byte[len];
+			System.Array.Copy(data, result, data.Length);
+			return result;
+		}
+
 		private static string GenMetaBytesLiteral(CodePrinter prt, string postfix, byte[] data, string mdataName)
 		{
 			string varName = string.Format("{0}_{1}",
@@ -37,6 +37,9 @@ namespace il2cpp
 		private readonly Dictionary<TypeDef, VarianceGroup> VarianceMap = new Dictionary<TypeDef, VarianceGroup>();
 
 		private TypeDef ThrowHelperType;
+		private TypeDef ThreadPoolHelperType;
+		private TypeDef ParallelHelperType;
+		private readonly Dictionary<MethodDef, MethodDef> ParallelChunkMap = new Dictionary<MethodDef, MethodDef>();
 		private readonly HashSet<string> ResolvedExceptions = new HashSet<string>();
 
 		// 运行时装箱类型原型
@@ -49,6 +52,7 @@ namespace il2cpp
 		private DelegateProperty DelegateType;
 
 		public TypeX RTTypeHandle;
+		public TypeX RTType;
 		public TypeX RTMethodHandle;
 		public TypeX RTFieldHandle;
 		public TypeX RTTypedRef;
@@ -110,6 +114,10 @@ namespace il2cpp
 		// 解析所有引用
 		public void ResolveAll()
 		{
+			// 运行时的信号处理需要抛出空引用异常
+			if (Context.UseImplicitNullCheck && !Context.UseStatusException)
+				ResolveExceptionType("NullReferenceException");
+
 			while (PendingMethods.Count > 0)
 			{
 				do
@@ -143,11 +151,25 @@ namespace il2cpp
 		{
 			Debug.Assert(metX.InstList == null);
 
+			// 由运行时实现的方法 (包括外部方法) 可能抛出的异常
+			var exNames = RuntimeInternals.GetReplacedMethodExceptions(metX);
+			if (exNames != null)
+			{
+				foreach (string exName in exNames)
+					ResolveExceptionType(exName);
+			}
+
 			if (!metX.Def.HasBody || !metX.Def.Body.HasInstructions)
 				return;
 
+			// 由运行时接管的方法无需展开指令
+			if (RuntimeInternals.IsReplacedMethod(metX))
+				return;
+
 			RecordResolvingMethod(metX);
 
+			LowerParallelFor(metX.Def);
+
 			IGenericReplacer replacer = new GenericReplacer(metX.DeclType, metX);
 
 			var defInstList = metX.Def.Body.Instructions;
@@ -273,9 +295,68 @@ namespace il2cpp
 				metX.ExHandlerList = handlers;
 			}
 
+			FoldTypeEquality(instList);
+
 			metX.InstList = instList;
 		}
 
+		// 折叠 typeof(A) == typeof(B) 为常量, 泛型实例中的类型分派无需反射支持
+		private static void FoldTypeEquality(InstInfo[] instList)
+		{
+			for (int ip = 0; ip + 4 < instList.Length; ++ip)
+			{
+				if (!(instList[ip].OpCode.Code == Code.Ldtoken && instList[ip].Operand is TypeX lhsTyX) ||
+					!IsGetTypeFromHandle(instList[ip + 1]) ||
+					!(instList[ip + 2].OpCode.Code == Code.Ldtoken && instList[ip + 2].Operand is TypeX rhsTyX) ||
+					!IsGetTypeFromHandle(instList[ip + 3]))
+					continue;
+
+				var cmpInst = instList[ip + 4];
+				if (cmpInst.OpCode.Code != Code.Call ||
+					!(cmpInst.Operand is MethodX cmpMetX) ||
+					cmpMetX.DeclType.GetNameKey() != "System.Type")
+					continue;
+
+				bool result;
+				if (cmpMetX.Def.Name == "op_Equality")
+					result = lhsTyX == rhsTyX;
+				else if (cmpMetX.Def.Name == "op_Inequality")
+					result = lhsTyX != rhsTyX;
+				else
+					continue;
+
+				// 中间的指令不能是跳转目标
+				bool hasTarget = false;
+				for (int i = ip + 1; i <= ip + 4; ++i)
+				{
+					if (instList[i].IsBrTarget)
+					{
+						hasTarget = true;
+						break;
+					}
+				}
+				if (hasTarget)
+					continue;
+
+				for (int i = ip; i < ip + 4; ++i)
+				{
+					instList[i].OpCode = OpCodes.Nop;
+					instList[i].Operand = null;
+				}
+				cmpInst.OpCode = OpCodes.Ldc_I4;
+				cmpInst.Operand = result ? 1 : 0;
+				ip += 4;
+			}
+		}
+
+		private static bool IsGetTypeFromHandle(InstInfo inst)
+		{
+			return inst.OpCode.Code == Code.Call &&
+				   inst.Operand is MethodX metX &&
+				   metX.Def.Name == "GetTypeFromHandle" &&
+				   metX.DeclType.GetNameKey() == "System.Type";
+		}
+
 		private void ResolveOpCodeException(Code opCode)
 		{
 			switch (opCode)
@@ -318,11 +399,38 @@ namespace il2cpp
 				case Code.Castclass:
 					ResolveExceptionType("InvalidCastException");
 					return;
+
+				case Code.Ldelema:
+				case Code.Ldelem_I1:
+				case Code.Ldelem_U1:
+				case Code.Ldelem_I2:
+				case Code.Ldelem_U2:
+				case Code.Ldelem_I4:
+				case Code.Ldelem_U4:
+				case Code.Ldelem_I8:
+				case Code.Ldelem_I:
+				case Code.Ldelem_R4:
+				case Code.Ldelem_R8:
+				case Code.Ldelem_Ref:
+				case Code.Ldelem:
+				case Code.Stelem_I1:
+				case Code.Stelem_I2:
+				case Code.Stelem_I4:
+				case Code.Stelem_I8:
+				case Code.Stelem_I:
+				case Code.Stelem_R4:
+				case Code.Stelem_R8:
+				case Code.Stelem_Ref:
+				case Code.Stelem:
+					ResolveExceptionType("IndexOutOfRangeException");
+					return;
 			}
 		}
 
 		private void ResolveOperand(InstInfo inst, IGenericReplacer replacer)
 		{
+			ResolveOpCodeException(inst.OpCode.Code);
+
 			// 预处理指令
 			switch (inst.OpCode.Code)
 			{
@@ -589,6 +697,26 @@ namespace il2cpp
 						if (isLdtoken)
 							resMetX.NeedGenMetadata = true;
 
+						if (inst.OpCode.Code == Code.Ldftn ||
+							inst.OpCode.Code == Code.Ldvirtftn)
+						{
+							resMetX.IsAddressTaken = true;
+						}
+
+						if (resMetX.Def.Name == "GetType" &&
+							!resMetX.Def.HasBody &&
+							resMetX.DeclType.GetNameKey() == "Object")
+						{
+							ResolveRuntimeType();
+						}
+
+						// 运行时实现的数组与字符串下标访问会抛出越界异常
+						if (resMetX.DeclType.IsArrayType ||
+							resMetX.Def.Name == "get_Chars" && resMetX.DeclType.GetNameKey() == "String")
+						{
+							ResolveExceptionType("IndexOutOfRangeException");
+						}
+
 						inst.Operand = resMetX;
 					}
 					break;
@@ -749,6 +877,7 @@ namespace il2cpp
 									RTTypeHandle = ResolveTypeDefOrRef(CorLibTypes.GetTypeRef("System", "RuntimeTypeHandle").Resolve(), null);
 									ResolveAllFields(RTTypeHandle);
 								}
+								ResolveRuntimeType();
 							}
 							break;
 						case OperandType.InlineMethod:
@@ -776,8 +905,6 @@ namespace il2cpp
 					}
 					break;
 			}
-
-			ResolveOpCodeException(inst.OpCode.Code);
 		}
 
 		private void GenStaticCctor(TypeX tyX)
@@ -845,6 +972,9 @@ namespace il2cpp
 
 			// 关联实现方法到虚方法
 			virtMetX.AddOverrideImpl(implMetX, derivedTyX);
+			// 虚方法的地址被取用时, 绑定的实现都可能成为委托目标
+			if (virtMetX.IsAddressTaken)
+				implMetX.IsAddressTaken = true;
 
 			// 处理该方法
 			implMetX.IsSkipProcessing = false;
@@ -1060,6 +1190,41 @@ namespace il2cpp
 				// 解析委托类
 				ResolveDelegateType();
 			}
+			else if (tyX.Def.FullName == "System.Span`1" ||
+					 tyX.Def.FullName == "System.ReadOnlySpan`1")
+			{
+				// 运行时直接读写跨度的指针与长度
+				ResolveAllFields(tyX, true);
+			}
+			else if (typeName == "System.Threading.Thread")
+			{
+				// 运行时通过字段保存委托与原生线程状态
+				ResolveAllFields(tyX);
+			}
+			else if (typeName == "System.Threading.ThreadPool")
+			{
+				// 解析运行时线程池的分派方法
+				ResolveThreadPoolHelper();
+			}
+			else if (typeName == "System.Text.UTF8Encoding")
+			{
+				// 运行时遇到非法序列或目标空间不足时回到托管实现
+				foreach (var metDef in tyX.Def.Methods)
+				{
+					if (metDef.Parameters.Count != 0 &&
+						metDef.Parameters[metDef.Parameters.Count - 1].Type.TypeName.EndsWith("NLS") &&
+						(metDef.Name.StartsWith("GetByte") || metDef.Name.StartsWith("GetChar")))
+					{
+						ResolveMethodDef(metDef);
+					}
+				}
+			}
+			else if (typeName == "System.Threading.TimerQueue")
+			{
+				// 计时器到期时由运行时回调
+				ResolveAllFields(tyX);
+				ResolveMethodDef(tyX.Def.FindMethod("AppDomainTimerCallback"));
+			}
 		}
 
 		private void TryAddGetHashCode(TypeX tyX)
@@ -1684,8 +1849,8 @@ namespace il2cpp
 				if (fldDef.IsStatic)
 					continue;
 
-				FieldX fldX = new FieldX(tyX, fldDef);
-				AddField(fldX);
+				// 字段可能已被解析过, 需使用已展开字段类型的实例
+				FieldX fldX = AddField(new FieldX(tyX, fldDef));
 
 				// 递归解析值类型字段
 				if (isRecursive &&
@@ -1711,6 +1876,13 @@ namespace il2cpp
 			}
 		}
 
+		private void ResolveRuntimeType()
+		{
+			// 类型对象由运行时按类型 ID 创建, 只用于比较引用, 不展开反射相关的虚方法
+			if (RTType == null)
+				RTType = ResolveTypeDefOrRef(CorLibTypes.GetTypeRef("System", "RuntimeType").Resolve(), null);
+		}
+
 		private void ResolveBoxedType(TypeX valueTyX)
 		{
 			if (!valueTyX.IsValueType)
@@ -2140,6 +2312,273 @@ namespace il2cpp
 			ResolveMethodDef(metDef);
 		}
 
+		private void ResolveThreadPoolHelper()
+		{
+			if (ThreadPoolHelperType != null)
+				return;
+
+			string typeName = "ThreadPoolHelper";
+			var findedDef = CorLibTypes.GetTypeRef(NsIl2cppRT, typeName).Resolve();
+			if (findedDef != null)
+			{
+				ThreadPoolHelperType = findedDef;
+			}
+			else
+			{
+				TypeDef tyDef = new TypeDefUser(
+					NsIl2cppRT,
+					typeName,
+					CorLibTypes.Object.TypeRef);
+				Context.CorLibModule.Types.Add(tyDef);
+				ThreadPoolHelperType = tyDef;
+			}
+
+			// 运行时以 void(object, object) 的形式调用工作项
+			TypeDef workItemDef = CorLibTypes.GetTypeRef("System.Threading", "IThreadPoolWorkItem").Resolve();
+			TypeDef waitCallbackDef = CorLibTypes.GetTypeRef("System.Threading", "WaitCallback").Resolve();
+			Debug.Assert(workItemDef != null && waitCallbackDef != null);
+
+			ResolveThreadPoolDispatcher("ExecuteWorkItem", workItemDef, workItemDef.FindMethod("ExecuteWorkItem"), false);
+			ResolveThreadPoolDispatcher("InvokeWaitCallback", waitCallbackDef, waitCallbackDef.FindMethod("Invoke"), true);
+		}
+
+		private void ResolveThreadPoolDispatcher(string metName, TypeDef targetDef, MethodDef invokeDef, bool hasState)
+		{
+			Debug.Assert(invokeDef != null);
+
+			MethodDef metDef = ThreadPoolHelperType.FindMethod(metName);
+			if (metDef == null)
+			{
+				metDef = new MethodDefUser(
+					metName,
+					MethodSig.CreateStatic(CorLibTypes.Void, targetDef.ToTypeSig(), CorLibTypes.Object),
+					MethodAttributes.Public | MethodAttributes.Static);
+				ThreadPoolHelperType.Methods.Add(metDef);
+
+				var body = metDef.Body = new CilBody();
+				var insts = body.Instructions;
+				insts.Add(OpCodes.Ldarg_0.ToInstruction());
+				if (hasState)
+					insts.Add(OpCodes.Ldarg_1.ToInstruction());
+				insts.Add(OpCodes.Callvirt.ToInstruction(invokeDef));
+				insts.Add(OpCodes.Ret.ToInstruction());
+				body.UpdateInstructionOffsets();
+			}
+			ResolveMethodDef(metDef);
+		}
+
+		// 把 Parallel.For(int, int, Action<int>) 降级为运行时的分段循环, 在分段内直接调用闭包方法
+		private void LowerParallelFor(MethodDef metDef)
+		{
+			var insts = metDef.Body.Instructions;
+			Dictionary<Instruction, int> targetRefs = null;
+
+			for (int i = 0; i < insts.Count - 1; ++i)
+			{
+				if (insts[i].OpCode.Code != Code.Call ||
+					!IsParallelFor(insts[i].Operand as IMethod) ||
+					insts[i + 1].OpCode.Code != Code.Pop)
+					continue;
+
+				if (targetRefs == null)
+					targetRefs = CountTargetRefs(metDef.Body);
+
+				int RefCount(int idx)
+				{
+					targetRefs.TryGetValue(insts[idx], out int count);
+					return count;
+				}
+
+				// ldftn M; newobj Action<int>::.ctor; call For; pop
+				if (i >= 2 &&
+					insts[i - 2].OpCode.Code == Code.Ldftn &&
+					IsActionInt32Ctor(insts[i - 1]) &&
+					RefCount(i - 1) == 0 && RefCount(i) == 0 && RefCount(i + 1) == 0 &&
+					insts[i - 2].Operand is MethodDef closureMet &&
+					IsParallelBody(closureMet))
+				{
+					insts[i - 2].Operand = GetParallelChunk(closureMet);
+					SetNop(insts[i - 1]);
+				}
+				// 缓存委托的形式:
+				// ldsfld cache; dup; brtrue L; pop; ldsfld <>9; ldftn M; newobj; dup; stsfld cache; L: call For; pop
+				else if (i >= 9 &&
+					insts[i - 9].OpCode.Code == Code.Ldsfld &&
+					insts[i - 8].OpCode.Code == Code.Dup &&
+					(insts[i - 7].OpCode.Code == Code.Brtrue || insts[i - 7].OpCode.Code == Code.Brtrue_S) &&
+					insts[i - 7].Operand == insts[i] &&
+					insts[i - 6].OpCode.Code == Code.Pop &&
+					insts[i - 5].OpCode.Code == Code.Ldsfld &&
+					insts[i - 4].OpCode.Code == Code.Ldftn &&
+					IsActionInt32Ctor(insts[i - 3]) &&
+					insts[i - 2].OpCode.Code == Code.Dup &&
+					insts[i - 1].OpCode.Code == Code.Stsfld &&
+					insts[i - 1].Operand == insts[i - 9].Operand &&
+					RefCount(i) == 1 && RefCount(i + 1) == 0 &&
+					Enumerable.Range(i - 8, 8).All(idx => RefCount(idx) == 0) &&
+					insts[i - 4].Operand is MethodDef cachedMet &&
+					!cachedMet.IsStatic &&
+					IsParallelBody(cachedMet))
+				{
+					insts[i - 9].Operand = insts[i - 5].Operand;
+					insts[i - 8].OpCode = OpCodes.Ldftn;
+					insts[i - 8].Operand = GetParallelChunk(cachedMet);
+					for (int idx = i - 7; idx < i; ++idx)
+						SetNop(insts[idx]);
+				}
+				else
+					continue;
+
+				insts[i].Operand = ParallelHelperType.FindMethod("For");
+				SetNop(insts[i + 1]);
+			}
+		}
+
+		private static bool IsParallelFor(IMethod met)
+		{
+			if (met == null || met.Name != "For" ||
+				met.DeclaringType?.FullName != "System.Threading.Tasks.Parallel")
+				return false;
+
+			var sig = met.MethodSig;
+			return sig != null && !sig.HasThis && sig.Params.Count == 3 &&
+				   sig.Params[0].ElementType == ElementType.I4 &&
+				   sig.Params[1].ElementType == ElementType.I4 &&
+				   sig.Params[2].FullName == "System.Action`1<System.Int32>";
+		}
+
+		private static bool IsActionInt32Ctor(Instruction inst)
+		{
+			return inst.OpCode.Code == Code.Newobj &&
+				   inst.Operand is IMethod ctor &&
+				   ctor.Name == ".ctor" &&
+				   ctor.DeclaringType?.FullName == "System.Action`1<System.Int32>";
+		}
+
+		private static bool IsParallelBody(MethodDef metDef)
+		{
+			// 只处理非泛型的 void(int) 闭包方法
+			return !metDef.HasGenericParameters &&
+				   !metDef.DeclaringType.HasGenericParameters &&
+				   !metDef.IsVirtual &&
+				   metDef.ReturnType.ElementType == ElementType.Void &&
+				   metDef.MethodSig.Params.Count == 1 &&
+				   metDef.MethodSig.Params[0].ElementType == ElementType.I4;
+		}
+
+		private static Dictionary<Instruction, int> CountTargetRefs(CilBody body)
+		{
+			var refs = new Dictionary<Instruction, int>();
+			void AddRef(Instruction inst)
+			{
+				if (inst == null)
+					return;
+				refs.TryGetValue(inst, out int count);
+				refs[inst] = count + 1;
+			}
+
+			foreach (var inst in body.Instructions)
+			{
+				if (inst.Operand is Instruction target)
+					AddRef(target);
+				else if (inst.Operand is Instruction[] targets)
+				{
+					foreach (var t in targets)
+						AddRef(t);
+				}
+			}
+
+			// 异常块边界同样不能改写
+			foreach (var eh in body.ExceptionHandlers)
+			{
+				AddRef(eh.TryStart);
+				AddRef(eh.TryEnd);
+				AddRef(eh.HandlerStart);
+				AddRef(eh.HandlerEnd);
+				AddRef(eh.FilterStart);
+			}
+			return refs;
+		}
+
+		private static void SetNop(Instruction inst)
+		{
+			inst.OpCode = OpCodes.Nop;
+			inst.Operand = null;
+		}
+
+		private MethodDef GetParallelChunk(MethodDef closureMet)
+		{
+			ResolveParallelHelper();
+
+			if (ParallelChunkMap.TryGetValue(closureMet, out var chunkDef))
+				return chunkDef;
+
+			// static void ForChunk_N(Closure ctx, int lo, int hi)
+			// {
+			//     for (; lo < hi; ++lo)
+			//         ctx.M(lo);
+			// }
+			TypeSig ctxSig = closureMet.IsStatic ? CorLibTypes.Object : closureMet.DeclaringType.ToTypeSig();
+			chunkDef = new MethodDefUser(
+				"ForChunk_" + ParallelChunkMap.Count,
+				MethodSig.CreateStatic(CorLibTypes.Void, ctxSig, CorLibTypes.Int32, CorLibTypes.Int32),
+				MethodAttributes.Public | MethodAttributes.Static);
+			ParallelHelperType.Methods.Add(chunkDef);
+			ParallelChunkMap.Add(closureMet, chunkDef);
+
+			var body = chunkDef.Body = new CilBody();
+			var insts = body.Instructions;
+
+			Instruction instCond = OpCodes.Ldarg_1.ToInstruction();
+			Instruction instLoop = closureMet.IsStatic ? OpCodes.Ldarg_1.ToInstruction() : OpCodes.Ldarg_0.ToInstruction();
+
+			insts.Add(OpCodes.Br.ToInstruction(instCond));
+			insts.Add(instLoop);
+			if (!closureMet.IsStatic)
+				insts.Add(OpCodes.Ldarg_1.ToInstruction());
+			insts.Add(OpCodes.Call.ToInstruction(closureMet));
+			insts.Add(OpCodes.Ldarg_1.ToInstruction());
+			insts.Add(OpCodes.Ldc_I4_1.ToInstruction());
+			insts.Add(OpCodes.Add.ToInstruction());
+			insts.Add(OpCodes.Starg.ToInstruction(chunkDef.Parameters[1]));
+			insts.Add(instCond);
+			insts.Add(OpCodes.Ldarg_2.ToInstruction());
+			insts.Add(OpCodes.Blt.ToInstruction(instLoop));
+			insts.Add(OpCodes.Ret.ToInstruction());
+			body.UpdateInstructionOffsets();
+
+			return chunkDef;
+		}
+
+		private void ResolveParallelHelper()
+		{
+			if (ParallelHelperType != null)
+				return;
+
+			string typeName = "ParallelHelper";
+			var findedDef = CorLibTypes.GetTypeRef(NsIl2cppRT, typeName).Resolve();
+			if (findedDef != null)
+			{
+				ParallelHelperType = findedDef;
+				return;
+			}
+
+			TypeDef tyDef = new TypeDefUser(
+				NsIl2cppRT,
+				typeName,
+				CorLibTypes.Object.TypeRef);
+			Context.CorLibModule.Types.Add(tyDef);
+			ParallelHelperType = tyDef;
+
+			// static extern void For(int lo, int hi, object ctx, IntPtr chunk), 由运行时实现
+			MethodDef metDef = new MethodDefUser(
+				"For",
+				MethodSig.CreateStatic(CorLibTypes.Void, CorLibTypes.Int32, CorLibTypes.Int32, CorLibTypes.Object, CorLibTypes.IntPtr),
+				MethodImplAttributes.InternalCall | MethodImplAttributes.IL | MethodImplAttributes.Managed,
+				MethodAttributes.Public | MethodAttributes.Static | MethodAttributes.HideBySig);
+			tyDef.Methods.Add(metDef);
+		}
+
 		private void ResolveDelegateType()
 		{
 			if (DelegateType != null)
@@ -1,7 +1,11 @@
 ﻿#include "il2cpp.h"
 #include "il2cppBridge.h"
 #include <math.h>
+#include <stdio.h>
 #include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -9,13 +13,120 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <sched.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <ucontext.h>
 #endif
 
+#if defined(IL2CPP_X86) && defined(IL2CPP_GNUC_LIKE)
+#include <cpuid.h>
+#endif
+
+uint32_t il2cpp_CPUFeatures = 0;
+
+#if defined(IL2CPP_EXCEPTION_STATUS)
+thread_local cls_Object* il2cpp_PendingException = nullptr;
+#endif
+
+#if defined(IL2CPP_IMPLICIT_NULLCHECK)
+static struct sigaction g_PrevSegvAction;
+
+// 链接器生成的段边界, 段不存在时为空
+extern "C" __attribute__((weak)) const char __start_il2cpp_code[];
+extern "C" __attribute__((weak)) const char __stop_il2cpp_code[];
+
+// 生成代码以 -fnon-call-exceptions 编译, 出错指令带有展开信息,
+// 展开器能识别内核的信号栈帧并恢复出错时的全部寄存器, 因此直接在处理函数里抛出.
+// 只转换生成代码内的低地址访问, 此时出错位置不会在 malloc 等运行时函数内部
+static void il2cpp_NullCheck_Handler(int sig, siginfo_t* info, void* context)
+{
+	ucontext_t* uc = (ucontext_t*)context;
+#if defined(__x86_64__)
+	uintptr_t pc = (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+#else
+	uintptr_t pc = (uintptr_t)uc->uc_mcontext.pc;
+#endif
+	if ((uintptr_t)info->si_addr < IL2CPP_NULL_GUARD_SIZE &&
+		pc >= (uintptr_t)__start_il2cpp_code &&
+		pc < (uintptr_t)__stop_il2cpp_code)
+	{
+		il2cpp_ThrowNullReference();
+	}
+
+	// 其他访问错误交还原来的处理, 返回后重新执行出错指令
+	sigaction(sig, &g_PrevSegvAction, nullptr);
+}
+
+static void il2cpp_NullCheck_Init()
+{
+	struct sigaction sa = {};
+	sa.sa_sigaction = &il2cpp_NullCheck_Handler;
+	// 抛出后不经过 sigreturn, 不能在处理期间屏蔽信号
+	sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGSEGV, &sa, &g_PrevSegvAction);
+}
+#else
+#if defined(IL2CPP_IMPLICIT_NULLCHECK_UNSUPPORTED)
+#pragma message("IL2CPP_IMPLICIT_NULLCHECK is not supported by this toolchain, null references are not checked")
+#endif
+static void il2cpp_NullCheck_Init()
+{
+}
+#endif
+
+static void il2cpp_CPU_Init()
+{
+#if defined(IL2CPP_X86)
+	uint32_t regs[4] = {};
+#if defined(IL2CPP_GNUC_LIKE)
+	__cpuid_count(1, 0, regs[0], regs[1], regs[2], regs[3]);
+#else
+	__cpuidex((int*)regs, 1, 0);
+#endif
+	if (regs[3] & (1u << 26))
+		il2cpp_CPUFeatures |= IL2CPP_CPU_SSE2;
+	if (regs[2] & (1u << 19))
+		il2cpp_CPUFeatures |= IL2CPP_CPU_SSE41;
+
+	// AVX 需要操作系统保存 YMM 寄存器状态
+	const bool hasOSXSave = (regs[2] & (1u << 27)) != 0;
+	const bool hasAVX = (regs[2] & (1u << 28)) != 0;
+	if (hasOSXSave && hasAVX)
+	{
+#if defined(IL2CPP_GNUC_LIKE)
+		uint32_t xcrLo, xcrHi;
+		__asm__ volatile("xgetbv" : "=a"(xcrLo), "=d"(xcrHi) : "c"(0));
+		const uint64_t xcr0 = ((uint64_t)xcrHi << 32) | xcrLo;
+#else
+		const uint64_t xcr0 = _xgetbv(0);
+#endif
+		if ((xcr0 & 0x6) == 0x6)
+		{
+#if defined(IL2CPP_GNUC_LIKE)
+			__cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#else
+			__cpuidex((int*)regs, 7, 0);
+#endif
+			if (regs[1] & (1u << 5))
+				il2cpp_CPUFeatures |= IL2CPP_CPU_AVX2;
+		}
+	}
+#endif
+}
+
 void il2cpp_InitVariables();
 void il2cpp_Init()
 {
+	il2cpp_CPU_Init();
+	il2cpp_String__InitKernels();
+	il2cpp_Array__InitKernels();
 	il2cpp_GC_Init();
+	il2cpp_NullCheck_Init();
+	il2cpp_Thread__Init();
 	il2cpp_InitVariables();
+	// 主线程由 GC 初始化时注册, 这里补充它的线程静态块
+	il2cpp_ThreadStatics__Register(1);
 }
 
 void* il2cpp_New(uint32_t sz, uint32_t typeID, uint8_t isNoRef)
@@ -57,6 +168,82 @@ void* il2cpp_New(uint32_t sz, uint32_t typeID, uint8_t isNoRef, IL2CPP_FINALIZER
 	return obj;
 }
 
+cls_Object* il2cpp_AppDomain__Get(uint32_t sz, uint32_t typeID)
+{
+	// 默认域在首次访问时创建, 作为根对象常驻
+	static cls_Object* s_Domain = [sz, typeID]()
+	{
+		cls_Object* obj = (cls_Object*)il2cpp_GC_AllocUncollectable(sz);
+		IL2CPP_MEMSET(obj, 0, sz);
+		obj->TypeID = typeID;
+		return obj;
+	}();
+	return s_Domain;
+}
+
+cls_Object* il2cpp_Type__FromTypeID(uint32_t typeID, uint32_t sz, uint32_t rtTypeID)
+{
+	// 每个类型 ID 只创建一个类型对象, 比较类型时可直接比较引用
+	static std::mutex s_Mutex;
+	static std::unordered_map<uint32_t, cls_Object*> s_TypeMap;
+
+	std::lock_guard<std::mutex> lk(s_Mutex);
+	cls_Object*& obj = s_TypeMap[typeID];
+	if (!obj)
+	{
+		obj = (cls_Object*)il2cpp_GC_AllocUncollectable(sz);
+		IL2CPP_MEMSET(obj, 0, sz);
+		obj->TypeID = rtTypeID;
+	}
+	return obj;
+}
+
+// 同一类型的终结器相同, 记录撤销过的终结器以便重新注册
+static std::mutex g_FinalizerMutex;
+static std::unordered_map<uint32_t, IL2CPP_FINALIZER_FUNC> g_FinalizerMap;
+
+void il2cpp_SuppressFinalize(cls_Object* obj)
+{
+	IL2CPP_FINALIZER_FUNC finalizer = il2cpp_GC_UnregisterFinalizer(obj);
+	if (finalizer)
+	{
+		std::lock_guard<std::mutex> lk(g_FinalizerMutex);
+		g_FinalizerMap[obj->TypeID] = finalizer;
+	}
+}
+
+void il2cpp_ReRegisterForFinalize(cls_Object* obj)
+{
+	IL2CPP_FINALIZER_FUNC finalizer = nullptr;
+	{
+		std::lock_guard<std::mutex> lk(g_FinalizerMutex);
+		auto it = g_FinalizerMap.find(obj->TypeID);
+		if (it != g_FinalizerMap.end())
+			finalizer = it->second;
+	}
+	// 没有撤销过终结器的类型无需重新注册
+	if (finalizer)
+		il2cpp_GC_RegisterFinalizer(obj, finalizer);
+}
+
+cls_Object* il2cpp_MemberwiseClone(cls_Object* obj)
+{
+	// 按分配块大小整体复制, 对象头中的锁与字面量标记不随之复制.
+	// 不知道原对象是否包含引用, 一律分配为需要扫描的内存
+	uintptr_t sz = il2cpp_GC_GetSize(obj);
+	cls_Object* clone = (cls_Object*)il2cpp_GC_Alloc(sz);
+	IL2CPP_MEMCPY(clone, obj, sz);
+	IL2CPP_MEMSET(clone->Flags, 0, sizeof(clone->Flags));
+
+	IL2CPP_FINALIZER_FUNC finalizer = il2cpp_GC_UnregisterFinalizer(obj);
+	if (finalizer)
+	{
+		il2cpp_GC_RegisterFinalizer(obj, finalizer);
+		il2cpp_GC_RegisterFinalizer(clone, finalizer);
+	}
+	return clone;
+}
+
 void il2cpp_CommitRoots(il2cppRootItem* roots, uint32_t num)
 {
 	std::sort(roots, roots + num,
@@ -116,6 +303,29 @@ uintptr_t il2cpp_ThreadID()
 #endif
 }
 
+int32_t il2cpp_ProcessorCount()
+{
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int32_t)info.dwNumberOfProcessors;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (int32_t)count : 1;
+#endif
+}
+
+int32_t il2cpp_TickCount()
+{
+#if defined(_WIN32)
+	return (int32_t)GetTickCount();
+#else
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int32_t)((uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000);
+#endif
+}
+
 void il2cpp_CallOnce(uint8_t &onceFlag, uintptr_t &lockTid, void(*invokeFunc)())
 {
 	if (IL2CPP_UNLIKELY(onceFlag != 2))
@@ -157,29 +367,6 @@ void il2cpp_SpinUnlock(uint8_t &flag)
 	IL2CPP_ATOMIC_CAS_8(&flag, 1, 0);
 }
 
-int32_t il2cpp_HashString(const uint16_t* str, int32_t len)
-{
-	const size_t szLen = static_cast<size_t>(len);
-	const size_t unitSize = sizeof(uintptr_t) / sizeof(uint16_t);
-	const size_t step = szLen / unitSize;
-	const size_t remain = szLen % unitSize;
-
-	uintptr_t result = 0x14AE055C;
-	for (size_t i = 0; i < step; ++i)
-	{
-		result += result << 5;
-		result ^= reinterpret_cast<const uintptr_t*>(str)[i];
-	}
-
-	for (size_t i = szLen - remain; i < szLen; ++i)
-	{
-		result += result << 5;
-		result ^= str[i];
-	}
-
-	return static_cast<int32_t>(result & 0xFFFFFFFF) ^ ((result >> 32) & 0xFFFFFFFF);
-}
-
 double il2cpp_Abs(double n)
 {
 	return fabs(n);
@@ -216,26 +403,44 @@ double il2cpp_Pow(double n, double m)
 }
 
 #if defined(IL2CPP_DISABLE_CHECK_RANGE)
-void il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index)
+bool il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index)
 {
+	return true;
 }
-void il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index, int64_t rangeLen)
+bool il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index, int64_t rangeLen)
+{
+	return true;
+}
+void il2cpp_CheckSlice(int64_t length, int64_t index, int64_t count)
 {
 }
 #else
-void il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index)
+bool il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index)
 {
 	if (index < lowerBound || index >= IL2CPP_ADD(lowerBound, length))
-		IL2CPP_TRAP;
+	{
+		il2cpp_ThrowIndexOutOfRange();
+		return false;
+	}
+	return true;
 }
 
-void il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index, int64_t rangeLen)
+bool il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index, int64_t rangeLen)
 {
-	il2cpp_CheckRange(lowerBound, length, index);
+	if (!il2cpp_CheckRange(lowerBound, length, index))
+		return false;
 
 	index = IL2CPP_ADD(index, rangeLen);
 	if (index < lowerBound || index > IL2CPP_ADD(lowerBound, length))
 		IL2CPP_TRAP;
+	return true;
+}
+
+void il2cpp_CheckSlice(int64_t length, int64_t index, int64_t count)
+{
+	// 允许 index == length 且 count == 0 的空区间
+	if (index < 0 || count < 0 || index > length - count)
+		IL2CPP_TRAP;
 }
 #endif
 
@@ -297,44 +502,269 @@ inline bool il2cpp_IsFinite(double num)
 	return il2cpp_DTest(&num) <= 0;
 }
 
-#if defined(IL2CPP_BRIDGE_HAS_4ObKN3_ThrowHelper__Throw_ArithmeticException)
+// 运行时产生的异常按线程缓存, 只在首次抛出时分配
+enum
+{
+	CachedEx_Arithmetic,
+	CachedEx_InvalidCast,
+	CachedEx_Overflow,
+	CachedEx_IndexOutOfRange,
+	CachedEx_NullReference,
+	CachedEx_ArgumentOutOfRange,
+	CachedEx_ArgumentNull,
+	CachedEx_Count
+};
+
+static struct il2cppExceptionCache
+{
+	// 缓存槽位于不回收的 GC 内存中, 以便被扫描
+	cls_Object** Slots = nullptr;
+
+	~il2cppExceptionCache()
+	{
+		if (Slots)
+			il2cpp_GC_Free(Slots);
+	}
+} thread_local t_ExceptionCache;
+
+static IL2CPP_NOINLINE IL2CPP_COLD cls_Object* il2cpp_NewCachedException(void(*pfnThrow)())
+{
+	// 借助抛出辅助方法构造异常对象, 然后截获它
+#if defined(IL2CPP_EXCEPTION_STATUS)
+	pfnThrow();
+	return il2cpp_TakePendingException();
+#else
+	try
+	{
+		pfnThrow();
+	}
+	catch (il2cppException& ex)
+	{
+		return ex.ExceptionPtr;
+	}
+	IL2CPP_UNREACHABLE;
+#endif
+}
+
+static cls_Object* il2cpp_GetCachedException(uint32_t slot, void(*pfnThrow)())
+{
+	cls_Object**& slots = t_ExceptionCache.Slots;
+	if (IL2CPP_UNLIKELY(!slots))
+	{
+		slots = (cls_Object**)il2cpp_GC_AllocUncollectable(sizeof(cls_Object*) * CachedEx_Count);
+		IL2CPP_MEMSET(slots, 0, sizeof(cls_Object*) * CachedEx_Count);
+	}
+
+	cls_Object* ex = slots[slot];
+	if (IL2CPP_UNLIKELY(!ex))
+		slots[slot] = ex = il2cpp_NewCachedException(pfnThrow);
+	return ex;
+}
+
+#if defined(IL2CPP_BRIDGE_Throw_ArithmeticException)
+static IL2CPP_NOINLINE IL2CPP_COLD void il2cpp_ThrowArithmetic()
+{
+	IL2CPP_THROW(il2cpp_GetCachedException(CachedEx_Arithmetic, &IL2CPP_BRIDGE_Throw_ArithmeticException));
+}
+
 float il2cpp_Ckfinite(float num)
 {
 	if (IL2CPP_UNLIKELY(!il2cpp_IsFinite(num)))
-		met_4ObKN3_ThrowHelper__Throw_ArithmeticException();
+		il2cpp_ThrowArithmetic();
 	return num;
 }
 
 double il2cpp_Ckfinite(double num)
 {
 	if (IL2CPP_UNLIKELY(!il2cpp_IsFinite(num)))
-		met_4ObKN3_ThrowHelper__Throw_ArithmeticException();
+		il2cpp_ThrowArithmetic();
 	return num;
 }
 #endif
 
-#if defined(IL2CPP_BRIDGE_HAS_GJNRe4_ThrowHelper__Throw_InvalidCastException)
+#if defined(IL2CPP_BRIDGE_Throw_InvalidCastException)
 void il2cpp_ThrowInvalidCast()
 {
-	met_GJNRe4_ThrowHelper__Throw_InvalidCastException();
+	IL2CPP_THROW(il2cpp_GetCachedException(CachedEx_InvalidCast, &IL2CPP_BRIDGE_Throw_InvalidCastException));
 }
 #endif
 
-#if defined(IL2CPP_BRIDGE_HAS_aBjyT3_ThrowHelper__Throw_OverflowException)
+#if defined(IL2CPP_BRIDGE_Throw_OverflowException)
 void il2cpp_ThrowOverflow()
 {
-	met_aBjyT3_ThrowHelper__Throw_OverflowException();
+	IL2CPP_THROW(il2cpp_GetCachedException(CachedEx_Overflow, &IL2CPP_BRIDGE_Throw_OverflowException));
+}
+#endif
+
+void il2cpp_ThrowIndexOutOfRange()
+{
+#if defined(IL2CPP_BRIDGE_Throw_IndexOutOfRangeException)
+	// 状态返回模式下异常只被挂起, 由调用方检查
+	IL2CPP_THROW(il2cpp_GetCachedException(CachedEx_IndexOutOfRange, &IL2CPP_BRIDGE_Throw_IndexOutOfRangeException));
+#else
+	IL2CPP_TRAP;
+#endif
+}
+
+void il2cpp_ThrowNullReference()
+{
+#if defined(IL2CPP_BRIDGE_Throw_NullReferenceException)
+	IL2CPP_THROW(il2cpp_GetCachedException(CachedEx_NullReference, &IL2CPP_BRIDGE_Throw_NullReferenceException));
+#else
+	IL2CPP_TRAP;
+#endif
+}
+
+void il2cpp_MissingNative(const char* name)
+{
+	fprintf(stderr, "il2cpp: missing native method %s\n", name);
+	fflush(stderr);
+	abort();
+}
+
+void il2cpp_ThrowArgumentOutOfRange()
+{
+#if defined(IL2CPP_BRIDGE_Throw_ArgumentOutOfRangeException)
+	IL2CPP_THROW(il2cpp_GetCachedException(CachedEx_ArgumentOutOfRange, &IL2CPP_BRIDGE_Throw_ArgumentOutOfRangeException));
+#else
+	IL2CPP_TRAP;
+#endif
+}
+
+void il2cpp_ThrowArgumentNull()
+{
+#if defined(IL2CPP_BRIDGE_Throw_ArgumentNullException)
+	IL2CPP_THROW(il2cpp_GetCachedException(CachedEx_ArgumentNull, &IL2CPP_BRIDGE_Throw_ArgumentNullException));
+#else
+	IL2CPP_TRAP;
+#endif
+}
+
+#if !defined(IL2CPP_DISABLE_STACKTRACE)
+#define IL2CPP_STACKTRACE_DEPTH		32
+#define IL2CPP_THROW_RECORDS		8
+
+// 每个线程记录最近抛出的若干异常的返回地址
+struct il2cppThrowRecord
+{
+	cls_Object* Exception;
+	uint32_t Count;
+	void* Frames[IL2CPP_STACKTRACE_DEPTH];
+};
+
+static thread_local il2cppThrowRecord t_ThrowRecords[IL2CPP_THROW_RECORDS];
+static thread_local uint32_t t_ThrowRecordNext;
+
+// 地址到符号名的缓存, 所有线程共享
+static std::mutex g_SymbolMutex;
+static std::unordered_map<void*, std::string> g_SymbolCache;
+
+static uint32_t il2cpp_CaptureFrames(void** frames, uint32_t maxCount)
+{
+#if defined(_WIN32)
+	return RtlCaptureStackBackTrace(0, maxCount, frames, nullptr);
+#else
+	int count = backtrace(frames, (int)maxCount);
+	return count > 0 ? (uint32_t)count : 0;
+#endif
+}
+
+static const std::string& il2cpp_SymbolizeFrame(void* addr)
+{
+	auto it = g_SymbolCache.find(addr);
+	if (it != g_SymbolCache.end())
+		return it->second;
+
+	std::string name;
+#if !defined(_WIN32)
+	char** syms = backtrace_symbols(&addr, 1);
+	if (syms)
+	{
+		name = syms[0];
+		free(syms);
+	}
+#endif
+	if (name.empty())
+	{
+		char buf[32];
+		snprintf(buf, sizeof(buf), "0x%llx", (unsigned long long)(uintptr_t)addr);
+		name = buf;
+	}
+	return g_SymbolCache.emplace(addr, std::move(name)).first->second;
+}
+
+cls_Object* il2cpp_RecordThrow(cls_Object* ex)
+{
+	if (!ex)
+		return ex;
+
+	// 同一对象再次抛出时覆盖原记录
+	il2cppThrowRecord* rec = nullptr;
+	for (auto& item : t_ThrowRecords)
+	{
+		if (item.Exception == ex)
+		{
+			rec = &item;
+			break;
+		}
+	}
+	if (!rec)
+		rec = &t_ThrowRecords[t_ThrowRecordNext++ % IL2CPP_THROW_RECORDS];
+
+	rec->Exception = ex;
+	rec->Count = il2cpp_CaptureFrames(rec->Frames, IL2CPP_STACKTRACE_DEPTH);
+	return ex;
+}
+
+il2cppString* il2cpp_Exception__GetStackTrace(cls_Object* ex, uint32_t typeID)
+{
+	const il2cppThrowRecord* rec = nullptr;
+	for (auto& item : t_ThrowRecords)
+	{
+		if (item.Exception == ex)
+		{
+			rec = &item;
+			break;
+		}
+	}
+	if (!rec)
+		return nullptr;
+
+	std::string text;
+	{
+		std::lock_guard<std::mutex> lk(g_SymbolMutex);
+		// 跳过记录函数自身
+		for (uint32_t i = 1; i < rec->Count; ++i)
+		{
+			if (i != 1)
+				text += '\n';
+			text += "   at ";
+			text += il2cpp_SymbolizeFrame(rec->Frames[i]);
+		}
+	}
+
+	il2cppString* str = (il2cppString*)il2cpp_New(sizeof(il2cppString) + sizeof(uint16_t) * text.size(), typeID, 1);
+	str->Length = (int32_t)text.size();
+	for (size_t i = 0; i < text.size(); ++i)
+		str->Chars[i] = (uint8_t)text[i];
+	return str;
+}
+#else
+il2cppString* il2cpp_Exception__GetStackTrace(cls_Object* ex, uint32_t typeID)
+{
+	return nullptr;
 }
 #endif
 
 #if defined(IL2CPP_BRIDGE_HAS_cls_System_Array)
-uint32_t il2cpp_SZArray__LoadLength(cls_System_Array* ary)
+// 生成代码对数组长度的访问不做显式空检查
+IL2CPP_CODE_SECTION uint32_t il2cpp_SZArray__LoadLength(cls_System_Array* ary)
 {
 	IL2CPP_ASSERT(ary->Rank == 0);
 	return (uint32_t)ary->Length;
 }
 
-uint32_t il2cpp_Array__GetLength(cls_System_Array* ary)
+IL2CPP_CODE_SECTION uint32_t il2cpp_Array__GetLength(cls_System_Array* ary)
 {
 	return (uint32_t)ary->Length;
 }
@@ -348,12 +778,14 @@ uint32_t il2cpp_Array__GetLength(cls_System_Array* ary, uint32_t dim)
 {
 	if (IL2CPP_LIKELY(ary->Rank == 0))
 	{
-		IL2CPP_CHECK_RANGE(0, 1, dim);
+		if (!IL2CPP_CHECK_RANGE(0, 1, dim))
+			return 0;
 		return (uint32_t)ary->Length;
 	}
 	else
 	{
-		IL2CPP_CHECK_RANGE(0, ary->Rank, dim);
+		if (!IL2CPP_CHECK_RANGE(0, ary->Rank, dim))
+			return 0;
 		return ((uint32_t*)&ary[1])[dim * 2 + 1];
 	}
 }
@@ -362,12 +794,14 @@ int32_t il2cpp_Array__GetLowerBound(cls_System_Array* ary, uint32_t dim)
 {
 	if (IL2CPP_LIKELY(ary->Rank == 0))
 	{
-		IL2CPP_CHECK_RANGE(0, 1, dim);
+		if (!IL2CPP_CHECK_RANGE(0, 1, dim))
+			return 0;
 		return 0;
 	}
 	else
 	{
-		IL2CPP_CHECK_RANGE(0, ary->Rank, dim);
+		if (!IL2CPP_CHECK_RANGE(0, ary->Rank, dim))
+			return 0;
 		return ((int32_t*)&ary[1])[dim * 2];
 	}
 }
@@ -376,12 +810,14 @@ int32_t il2cpp_Array__GetUpperBound(cls_System_Array* ary, uint32_t dim)
 {
 	if (IL2CPP_LIKELY(ary->Rank == 0))
 	{
-		IL2CPP_CHECK_RANGE(0, 1, dim);
+		if (!IL2CPP_CHECK_RANGE(0, 1, dim))
+			return 0;
 		return (int32_t)(ary->Length - 1);
 	}
 	else
 	{
-		IL2CPP_CHECK_RANGE(0, ary->Rank, dim);
+		if (!IL2CPP_CHECK_RANGE(0, ary->Rank, dim))
+			return 0;
 		int32_t* pBound = (int32_t*)&ary[1];
 		return pBound[dim * 2] + (uint32_t)pBound[dim * 2 + 1] - 1;
 	}
@@ -396,14 +832,16 @@ void il2cpp_Array__Copy(cls_System_Array* srcAry, uint32_t srcIdx, cls_System_Ar
 
 	auto srcLen = srcAry->Length;
 	auto dstLen = dstAry->Length;
-	il2cpp_CheckRange(0, srcLen, srcIdx, copyLen);
-	il2cpp_CheckRange(0, dstLen, dstIdx, copyLen);
+	if (!il2cpp_CheckRange(0, srcLen, srcIdx, copyLen) ||
+		!il2cpp_CheckRange(0, dstLen, dstIdx, copyLen))
+		return;
 
 	uint32_t dataOffset = rank == 0 ? 0 : rank * sizeof(uint32_t) * 2;
 	uint8_t* srcPtr = (uint8_t*)&srcAry[1] + dataOffset + elemSize * srcIdx;
 	uint8_t* dstPtr = (uint8_t*)&dstAry[1] + dataOffset + elemSize * dstIdx;
 
-	IL2CPP_MEMCPY(dstPtr, srcPtr, elemSize * copyLen);
+	// 源和目标可能是同一数组的重叠区间
+	IL2CPP_MEMMOVE(dstPtr, srcPtr, elemSize * copyLen);
 }
 
 void il2cpp_Array__Clear(cls_System_Array* ary, uint32_t idx, uint32_t clearLen)
@@ -411,7 +849,8 @@ void il2cpp_Array__Clear(cls_System_Array* ary, uint32_t idx, uint32_t clearLen)
 	auto elemSize = ary->ElemSize;
 	auto rank = ary->Rank;
 	auto aryLen = ary->Length;
-	il2cpp_CheckRange(0, aryLen, idx, clearLen);
+	if (!il2cpp_CheckRange(0, aryLen, idx, clearLen))
+		return;
 
 	uint32_t dataOffset = rank == 0 ? 0 : rank * sizeof(uint32_t) * 2;
 	uint8_t* ptr = (uint8_t*)&ary[1] + dataOffset + elemSize * idx;
@@ -20,6 +20,10 @@
 #error Cannot detect your compiler environment!
 #endif
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define IL2CPP_X86
+#endif
+
 #if defined(IL2CPP_GNUC_LIKE)
 #define IL2CPP_TRAP								__builtin_trap()
 #define IL2CPP_UNREACHABLE						__builtin_unreachable()
@@ -27,9 +31,17 @@
 #define IL2CPP_ATOMIC_CAS_16(_dst, _cmp, _new)	__sync_val_compare_and_swap(_dst, _cmp, _new)
 #define IL2CPP_ATOMIC_CAS_32(_dst, _cmp, _new)	__sync_val_compare_and_swap(_dst, _cmp, _new)
 #define IL2CPP_ATOMIC_CAS_64(_dst, _cmp, _new)	__sync_val_compare_and_swap(_dst, _cmp, _new)
+#define IL2CPP_ATOMIC_XCHG_32(_dst, _new)		__atomic_exchange_n(_dst, _new, __ATOMIC_SEQ_CST)
+#define IL2CPP_ATOMIC_XCHG_64(_dst, _new)		__atomic_exchange_n(_dst, _new, __ATOMIC_SEQ_CST)
+#define IL2CPP_ATOMIC_XADD_32(_dst, _val)		__atomic_fetch_add(_dst, _val, __ATOMIC_SEQ_CST)
+#define IL2CPP_ATOMIC_XADD_64(_dst, _val)		__atomic_fetch_add(_dst, _val, __ATOMIC_SEQ_CST)
+#define IL2CPP_MEMORY_BARRIER()					__atomic_thread_fence(__ATOMIC_SEQ_CST)
 #define IL2CPP_LIKELY(_x)						__builtin_expect(!!(_x), 1)
 #define IL2CPP_UNLIKELY(_x)						__builtin_expect(!!(_x), 0)
 #define IL2CPP_PACKED_TAIL(_x)					__attribute__((packed, aligned(_x)))
+#define IL2CPP_TARGET(_x)						__attribute__((target(_x)))
+#define IL2CPP_NOINLINE							__attribute__((noinline))
+#define IL2CPP_COLD								__attribute__((cold))
 #else
 #define IL2CPP_TRAP								abort()
 #define IL2CPP_UNREACHABLE						abort()
@@ -37,9 +49,55 @@
 #define IL2CPP_ATOMIC_CAS_16(_dst, _cmp, _new)	_InterlockedCompareExchange16((volatile short*)_dst, (short)_new, (short)_cmp)
 #define IL2CPP_ATOMIC_CAS_32(_dst, _cmp, _new)	_InterlockedCompareExchange((volatile long*)_dst, (long)_new, (long)_cmp)
 #define IL2CPP_ATOMIC_CAS_64(_dst, _cmp, _new)	_InterlockedCompareExchange64((volatile __int64*)_dst, (__int64)_new, (__int64)_cmp)
+#define IL2CPP_ATOMIC_XCHG_32(_dst, _new)		_InterlockedExchange((volatile long*)_dst, (long)_new)
+#define IL2CPP_ATOMIC_XCHG_64(_dst, _new)		_InterlockedExchange64((volatile __int64*)_dst, (__int64)_new)
+#define IL2CPP_ATOMIC_XADD_32(_dst, _val)		_InterlockedExchangeAdd((volatile long*)_dst, (long)_val)
+#define IL2CPP_ATOMIC_XADD_64(_dst, _val)		_InterlockedExchangeAdd64((volatile __int64*)_dst, (__int64)_val)
+#define IL2CPP_MEMORY_BARRIER()					_mm_mfence()
 #define IL2CPP_LIKELY(_x)						_x
 #define IL2CPP_UNLIKELY(_x)						_x
 #define IL2CPP_PACKED_TAIL(_x)
+#define IL2CPP_TARGET(_x)
+#define IL2CPP_NOINLINE							__declspec(noinline)
+#define IL2CPP_COLD
+#endif
+
+// 未实现的外部方法生成弱定义的占位实现, 用户提供的同名实现可将其覆盖
+#if defined(IL2CPP_GNUC_LIKE)
+#define IL2CPP_NATIVE_STUB						__attribute__((weak))
+#endif
+
+// 标记冷路径的语句标签, 只有 GCC 支持标签上的 cold 属性
+// clang 忽略标签属性, 冷路径由进入时的 IL2CPP_UNLIKELY 分支与路径上的冷函数调用推断
+#if defined(IL2CPP_GNUC_LIKE) && !defined(__clang__)
+#define IL2CPP_COLD_LABEL						__attribute__((cold, unused))
+#else
+#define IL2CPP_COLD_LABEL
+#endif
+
+// 隐式空检查依赖信号处理直接抛出异常, 只有 GCC 在 -fnon-call-exceptions 下为访存指令生成展开信息.
+// 其他工具链 (clang, MSVC, Windows) 不安装信号处理, 空引用访问与默认模式一样直接崩溃
+#if defined(IL2CPP_IMPLICIT_NULLCHECK) && \
+	!(defined(__GNUC__) && !defined(__clang__) && defined(__ELF__) && (defined(__x86_64__) || defined(__aarch64__)))
+#undef IL2CPP_IMPLICIT_NULLCHECK
+#define IL2CPP_IMPLICIT_NULLCHECK_UNSUPPORTED
+#endif
+
+// 生成代码所在的段, 信号处理只转换此段内的访问错误
+#if defined(IL2CPP_IMPLICIT_NULLCHECK)
+#define IL2CPP_CODE_SECTION						__attribute__((section("il2cpp_code")))
+#else
+#define IL2CPP_CODE_SECTION
+#endif
+
+// 线程静态字段块. 使用 __thread 而非 thread_local, 跨单元访问时不会插入动态初始化检查
+// 默认 initial-exec 模型, 只链接为可执行文件时可定义 IL2CPP_TLS_LOCAL_EXEC 使访问成为单条 %fs 相对读取
+#if defined(IL2CPP_MSVC_LIKE)
+#define IL2CPP_THREAD_STATIC					__declspec(thread)
+#elif defined(IL2CPP_TLS_LOCAL_EXEC)
+#define IL2CPP_THREAD_STATIC					__thread __attribute__((tls_model("local-exec")))
+#else
+#define IL2CPP_THREAD_STATIC					__thread __attribute__((tls_model("initial-exec")))
 #endif
 
 #define IL2CPP_ASSERT(_x)				do { if (!(_x)) IL2CPP_TRAP; } while(0)
@@ -47,11 +105,22 @@
 #define IL2CPP_MEMMOVE					memmove
 #define IL2CPP_MEMSET					memset
 #define IL2CPP_MEMCMP					memcmp
+#define IL2CPP_STRLEN					strlen
 #define IL2CPP_ALLOCA					alloca
 #define IL2CPP_NEW						il2cpp_New
 #define IL2CPP_ADD_ROOT(_x)				il2cppRootItem(&(_x), sizeof(_x))
-#define IL2CPP_THROW(_ex)				throw il2cppException(_ex)
+#if defined(IL2CPP_EXCEPTION_STATUS)
+// 抛出只设置待处理异常, 由生成代码在可能抛出的指令之后检查并跳转
+#define IL2CPP_THROW(_ex)				(il2cpp_PendingException = il2cpp_RecordThrow((cls_Object*)(_ex)))
+#define IL2CPP_THROW_INVALIDCAST		il2cpp_ThrowInvalidCast()
+#define IL2CPP_PENDING_EXCEPTION		IL2CPP_UNLIKELY(il2cpp_PendingException != nullptr)
+#define IL2CPP_THROW_METHOD				IL2CPP_NOINLINE IL2CPP_COLD
+#else
+#define IL2CPP_THROW(_ex)				throw il2cppException(il2cpp_RecordThrow((cls_Object*)(_ex)))
 #define IL2CPP_THROW_INVALIDCAST		do { il2cpp_ThrowInvalidCast(); IL2CPP_UNREACHABLE; } while(0)
+// 只会抛出异常的方法
+#define IL2CPP_THROW_METHOD				[[noreturn]] IL2CPP_NOINLINE IL2CPP_COLD
+#endif
 
 #define IL2CPP_MIN(_x, _y)				il2cpp_Min(_x, _y)
 #define IL2CPP_MAX(_x, _y)				il2cpp_Max(_x, _y)
@@ -62,6 +131,30 @@
 #define IL2CPP_NEG_INF					(-IL2CPP_POS_INF)
 
 #define IL2CPP_CHECK_RANGE				il2cpp_CheckRange
+#define IL2CPP_CHECK_SZRANGE			il2cpp_CheckSZRange
+#define IL2CPP_CHECK_SLICE				il2cpp_CheckSlice
+// 低于此地址的访问由信号处理转为空引用异常
+#define IL2CPP_NULL_GUARD_SIZE			4096
+#define IL2CPP_CHECK_NULL(_obj) \
+	do { if (IL2CPP_UNLIKELY(!(_obj))) il2cpp_ThrowNullReference(); } while (0)
+#define IL2CPP_CHECK_NULL_FIELD(_obj, _fld) \
+	do { if (IL2CPP_OFFSETOF(_fld) >= IL2CPP_NULL_GUARD_SIZE) IL2CPP_CHECK_NULL(_obj); } while (0)
+#if defined(IL2CPP_DISABLE_CHECK_RANGE)
+#define IL2CPP_CHECK_SZRANGE_OR(_len, _idx, _exit)	((void)0)
+#else
+#define IL2CPP_CHECK_SZRANGE_OR(_len, _idx, _exit) \
+	do { if (IL2CPP_UNLIKELY((uint32_t)(int32_t)(_idx) >= (uint32_t)(_len))) { il2cpp_ThrowIndexOutOfRange(); _exit; } } while (0)
+#endif
+// 托管线程未指定 maxStackSize 时使用的栈大小, 0 表示系统默认
+#if !defined(IL2CPP_THREAD_STACK_SIZE)
+#define IL2CPP_THREAD_STACK_SIZE		0
+#endif
+// 线程池工作线程数, 0 表示与处理器数一致
+#if !defined(IL2CPP_THREADPOOL_WORKERS)
+#define IL2CPP_THREADPOOL_WORKERS		0
+#endif
+#define IL2CPP_STRLEN16					il2cpp_StrLen16
+#define IL2CPP_TOUTF16LEN				il2cpp_ToUTF16Len
 #define IL2CPP_REMAINDER				il2cpp_Remainder
 #define IL2CPP_CKFINITE					il2cpp_Ckfinite
 
@@ -72,6 +165,27 @@
 #define IL2CPP_MUL_OVF					il2cpp_MulOverflow
 #define IL2CPP_CONV_OVF(_t, _s, _val)	il2cpp_ConvOverflow<_t, _s>((_s)_val)
 
+#define IL2CPP_CPU_SSE2					0x1
+#define IL2CPP_CPU_SSE41				0x2
+#define IL2CPP_CPU_AVX2					0x4
+
+#define IL2CPP_SORTKEY_I1				0
+#define IL2CPP_SORTKEY_U1				1
+#define IL2CPP_SORTKEY_I2				2
+#define IL2CPP_SORTKEY_U2				3
+#define IL2CPP_SORTKEY_I4				4
+#define IL2CPP_SORTKEY_U4				5
+#define IL2CPP_SORTKEY_I8				6
+#define IL2CPP_SORTKEY_U8				7
+#define IL2CPP_SORTKEY_R4				8
+#define IL2CPP_SORTKEY_R8				9
+#define IL2CPP_SORTKEY_I				(sizeof(intptr_t) == 8 ? IL2CPP_SORTKEY_I8 : IL2CPP_SORTKEY_I4)
+#define IL2CPP_SORTKEY_U				(sizeof(uintptr_t) == 8 ? IL2CPP_SORTKEY_U8 : IL2CPP_SORTKEY_U4)
+
+#define IL2CPP_OBJFLAG_LITERAL			0x1
+#define IL2CPP_STR_U32(_x)				(uint16_t)((uint32_t)(_x) & 0xFFFF), (uint16_t)((uint32_t)(_x) >> 16)
+#define IL2CPP_STR_LITERAL(_off)		((il2cppString*)(il2cpp_StringBlob + (_off)))
+
 #define IL2CPP_SZARRAY_LEN(_x)			il2cpp_SZArray__LoadLength((cls_System_Array*)(_x))
 
 #if defined(IL2CPP_DISABLE_THREADSAFE_CALL_CCTOR)
@@ -153,6 +267,25 @@ struct il2cppException
 	il2cppException(cls_Object* ptr) : ExceptionPtr(ptr) {}
 };
 
+// 抛出时只记录返回地址, 读取 StackTrace 时才符号化
+#if defined(IL2CPP_DISABLE_STACKTRACE)
+inline cls_Object* il2cpp_RecordThrow(cls_Object* ex) { return ex; }
+#else
+// 冷函数调用使抛出所在的基本块被视为冷路径
+IL2CPP_NOINLINE IL2CPP_COLD cls_Object* il2cpp_RecordThrow(cls_Object* ex);
+#endif
+
+#if defined(IL2CPP_EXCEPTION_STATUS)
+extern thread_local cls_Object* il2cpp_PendingException;
+
+inline cls_Object* il2cpp_TakePendingException()
+{
+	cls_Object* ex = il2cpp_PendingException;
+	il2cpp_PendingException = nullptr;
+	return ex;
+}
+#endif
+
 struct il2cppMetaBuffer
 {
 	const uint8_t* Data;
@@ -187,6 +320,26 @@ struct il2cppFieldInfo
 	uint32_t Offset;
 };
 
+// 与 cls_String 的布局一致
+struct il2cppString
+{
+	uint32_t TypeID;
+	uint8_t Flags[4];
+	int32_t Length;
+	uint16_t Chars[1];
+};
+
+// 编译期生成的字面量完美哈希表
+struct il2cppLiteralTable
+{
+	const il2cppString* const* Slots;
+	const uint32_t* Disps;
+	const il2cppString* const* Overflows;
+	uint32_t SlotCount;
+	uint32_t BucketCount;
+	uint32_t OverflowCount;
+};
+
 struct il2cppRootItem
 {
 	uint8_t* Ptr;
@@ -203,23 +356,93 @@ using IL2CPP_FINALIZER_FUNC = void(*)(cls_Object*);
 void il2cpp_GC_Init();
 void* il2cpp_GC_Alloc(uintptr_t sz);
 void* il2cpp_GC_AllocAtomic(uintptr_t sz);
+void* il2cpp_GC_AllocUncollectable(uintptr_t sz);
+void il2cpp_GC_Free(void* ptr);
 void il2cpp_GC_AddRoots(void* low, void* high);
+void il2cpp_GC_RemoveRoots(void* low, void* high);
 bool il2cpp_GC_RegisterThread();
 bool il2cpp_GC_UnregisterThread();
 void il2cpp_GC_RegisterFinalizer(cls_Object* obj, IL2CPP_FINALIZER_FUNC finalizer);
+IL2CPP_FINALIZER_FUNC il2cpp_GC_UnregisterFinalizer(cls_Object* obj);
+uintptr_t il2cpp_GC_GetSize(void* ptr);
 void il2cpp_GC_Collect();
+void il2cpp_ThreadStatics__Register(uint8_t isAdd);
+
+extern uint32_t il2cpp_CPUFeatures;
 
 void il2cpp_Init();
 void* il2cpp_New(uint32_t sz, uint32_t typeID, uint8_t isNoRef);
 void* il2cpp_New(uint32_t sz, uint32_t typeID, uint8_t isNoRef, IL2CPP_FINALIZER_FUNC finalizer);
+cls_Object* il2cpp_AppDomain__Get(uint32_t sz, uint32_t typeID);
+cls_Object* il2cpp_Type__FromTypeID(uint32_t typeID, uint32_t sz, uint32_t rtTypeID);
+void il2cpp_SuppressFinalize(cls_Object* obj);
+void il2cpp_ReRegisterForFinalize(cls_Object* obj);
+cls_Object* il2cpp_MemberwiseClone(cls_Object* obj);
 void il2cpp_CommitRoots(il2cppRootItem* roots, uint32_t num);
 void il2cpp_Yield();
 void il2cpp_SleepMS(uint32_t ms);
 uintptr_t il2cpp_ThreadID();
+int32_t il2cpp_ProcessorCount();
+int32_t il2cpp_TickCount();
 void il2cpp_CallOnce(uint8_t &onceFlag, uintptr_t &lockTid, void(*invokeFunc)());
 void il2cpp_SpinLock(uint8_t &flag);
 void il2cpp_SpinUnlock(uint8_t &flag);
+void il2cpp_String__InitKernels();
 int32_t il2cpp_HashString(const uint16_t* str, int32_t len);
+bool il2cpp_String__Equals(const uint16_t* lhs, const uint16_t* rhs, int32_t len);
+int32_t il2cpp_String__CompareOrdinal(const uint16_t* lhs, int32_t lhsLen, const uint16_t* rhs, int32_t rhsLen);
+int32_t il2cpp_String__IndexOf(const uint16_t* str, int32_t len, uint16_t ch);
+void il2cpp_String__RegisterLiterals(const il2cppLiteralTable* table);
+il2cppString* il2cpp_String__Intern(il2cppString* str);
+il2cppString* il2cpp_String__IsInterned(il2cppString* str);
+void il2cpp_Array__InitKernels();
+void il2cpp_Array__Fill(void* data, uint32_t elemSize, const void* value, uint32_t count);
+int32_t il2cpp_Array__IndexOf(const void* data, uint32_t elemSize, const void* value, uint32_t count);
+int32_t il2cpp_Array__LastIndexOf(const void* data, uint32_t elemSize, const void* value, uint32_t count);
+void il2cpp_Array__Reverse(void* data, uint32_t elemSize, uint32_t count);
+void il2cpp_Array__Sort(void* keys, uint32_t keyKind, uint32_t count);
+void il2cpp_Array__SortItems(void* keys, uint32_t keyKind, void* items, uint32_t itemSize, uint32_t count);
+// 目标空间不足时返回 -1, 严格模式下遇到非法序列也返回 -1
+int32_t il2cpp_UTF8__GetCharCount(const uint8_t* src, int32_t len, bool isStrict);
+int32_t il2cpp_UTF8__GetChars(const uint8_t* src, int32_t len, uint16_t* dst, int32_t dstLen, bool isStrict);
+int32_t il2cpp_UTF8__GetByteCount(const uint16_t* src, int32_t len, bool isStrict);
+int32_t il2cpp_UTF8__GetBytes(const uint16_t* src, int32_t len, uint8_t* dst, int32_t dstLen, bool isStrict);
+int32_t il2cpp_StrLen16(const uint16_t* str);
+int32_t il2cpp_ToUTF16Len(const int8_t* str);
+int32_t il2cpp_ToUTF16Len(const int8_t* str, int32_t len);
+il2cppString* il2cpp_String__Concat(uint32_t typeID, il2cppString* empty, il2cppString* s0, il2cppString* s1);
+il2cppString* il2cpp_String__Concat(uint32_t typeID, il2cppString* empty, il2cppString* s0, il2cppString* s1, il2cppString* s2);
+il2cppString* il2cpp_String__Concat(uint32_t typeID, il2cppString* empty, il2cppString* s0, il2cppString* s1, il2cppString* s2, il2cppString* s3);
+il2cppString* il2cpp_String__ConcatArray(uint32_t typeID, il2cppString* empty, il2cppString* const* strs, uint32_t count);
+il2cppString* il2cpp_String__FromInt64(int64_t val, uint32_t typeID);
+il2cppString* il2cpp_String__FromUInt64(uint64_t val, uint32_t typeID);
+il2cppString* il2cpp_Exception__GetStackTrace(cls_Object* ex, uint32_t typeID);
+struct il2cppThread;
+void il2cpp_Thread__Init();
+il2cppThread* il2cpp_Thread__Create(uint8_t hasParam, int32_t maxStackSize);
+il2cppThread* il2cpp_Thread__Attach(cls_Object* managedThread);
+cls_Object* il2cpp_Thread__GetCurrent();
+void il2cpp_Thread__Start(il2cppThread* th, cls_Object* managedThread, cls_Object* target, void* methodPtr, cls_Object* startArg);
+uint8_t il2cpp_Thread__Join(il2cppThread* th, int32_t timeoutMS);
+void il2cpp_Thread__Sleep(int32_t ms);
+void il2cpp_Thread__SpinWait(int32_t iterations);
+int32_t il2cpp_Thread__GetManagedID(il2cppThread* th);
+uint8_t il2cpp_Thread__IsBackground(il2cppThread* th);
+void il2cpp_Thread__SetBackground(il2cppThread* th, uint8_t isBackground);
+int32_t il2cpp_Thread__GetState(il2cppThread* th);
+void il2cpp_Thread__Finalize(il2cppThread* th);
+uint8_t il2cpp_Monitor__Wait(void* obj, uint8_t& lockFlag, int32_t timeoutMS);
+void il2cpp_Monitor__Pulse(void* obj, uint8_t isAll);
+using IL2CPP_WORKITEM_FUNC = void(*)(cls_Object*, cls_Object*);
+void il2cpp_ThreadPool__Queue(IL2CPP_WORKITEM_FUNC func, cls_Object* obj, cls_Object* state, uint8_t preferLocal);
+uint8_t il2cpp_ThreadPool__TryPop(cls_Object* obj);
+int32_t il2cpp_ThreadPool__GetWorkerCount();
+int32_t il2cpp_ThreadPool__GetBusyCount();
+uint8_t il2cpp_ThreadPool__SetWorkerCount(int32_t count);
+using IL2CPP_TIMER_FUNC = void(*)(int32_t);
+void il2cpp_Timer__Schedule(int32_t id, uint32_t dueMS, IL2CPP_TIMER_FUNC callback);
+using IL2CPP_PARALLELFOR_FUNC = void(*)(cls_Object*, int32_t, int32_t);
+void il2cpp_ParallelFor(int32_t lo, int32_t hi, int32_t grain, IL2CPP_PARALLELFOR_FUNC func, cls_Object* ctx);
 double il2cpp_Abs(double n);
 double il2cpp_Sqrt(double n);
 double il2cpp_Sin(double n);
@@ -240,6 +463,36 @@ inline T il2cpp_Max(T lhs, T rhs)
 	return lhs > rhs ? lhs : rhs;
 }
 
+inline int32_t il2cpp_String__GetHashCode(const il2cppString* str)
+{
+	// 字面量的哈希值在编译期已算好, 存放在对象头之前
+	if (str->Flags[1] & IL2CPP_OBJFLAG_LITERAL)
+		return reinterpret_cast<const int32_t*>(str)[-1];
+	return il2cpp_HashString(str->Chars, str->Length);
+}
+
+inline uint32_t il2cpp_Ctz32(uint32_t n)
+{
+#if defined(IL2CPP_GNUC_LIKE)
+	return (uint32_t)__builtin_ctz(n);
+#else
+	unsigned long idx;
+	_BitScanForward(&idx, n);
+	return (uint32_t)idx;
+#endif
+}
+
+inline uint32_t il2cpp_Clz32(uint32_t n)
+{
+#if defined(IL2CPP_GNUC_LIKE)
+	return (uint32_t)__builtin_clz(n);
+#else
+	unsigned long idx;
+	_BitScanReverse(&idx, n);
+	return (uint32_t)(31 - idx);
+#endif
+}
+
 template <typename TField, typename TCls>
 constexpr uintptr_t il2cpp_OffsetOf(TField TCls::*member)
 {
@@ -469,34 +722,104 @@ T il2cpp_ConvOverflow(S s)
 	return static_cast<T>(s);
 }
 
+// 原子操作按同宽整数进行, 浮点数与指针按位重新解释
 template <class T>
 T il2cpp_CompareExchange(T* dst, T value, T comparand)
 {
 	switch (sizeof(T))
 	{
 	case 1:
-		return (T)IL2CPP_ATOMIC_CAS_8(dst, comparand, value);
-
+		{
+			uint8_t ret = (uint8_t)IL2CPP_ATOMIC_CAS_8((uint8_t*)dst, *(uint8_t*)&comparand, *(uint8_t*)&value);
+			return *(T*)&ret;
+		}
 	case 2:
-		return (T)IL2CPP_ATOMIC_CAS_16(dst, comparand, value);
+		{
+			uint16_t ret = (uint16_t)IL2CPP_ATOMIC_CAS_16((uint16_t*)dst, *(uint16_t*)&comparand, *(uint16_t*)&value);
+			return *(T*)&ret;
+		}
+	case 4:
+		{
+			uint32_t ret = (uint32_t)IL2CPP_ATOMIC_CAS_32((uint32_t*)dst, *(uint32_t*)&comparand, *(uint32_t*)&value);
+			return *(T*)&ret;
+		}
+	case 8:
+		{
+			uint64_t ret = (uint64_t)IL2CPP_ATOMIC_CAS_64((uint64_t*)dst, *(uint64_t*)&comparand, *(uint64_t*)&value);
+			return *(T*)&ret;
+		}
+	}
+	IL2CPP_TRAP;
+}
 
+template <class T>
+T il2cpp_Exchange(T* dst, T value)
+{
+	switch (sizeof(T))
+	{
 	case 4:
-		return (T)IL2CPP_ATOMIC_CAS_32(dst, comparand, value);
+		{
+			uint32_t ret = (uint32_t)IL2CPP_ATOMIC_XCHG_32((uint32_t*)dst, *(uint32_t*)&value);
+			return *(T*)&ret;
+		}
+	case 8:
+		{
+			uint64_t ret = (uint64_t)IL2CPP_ATOMIC_XCHG_64((uint64_t*)dst, *(uint64_t*)&value);
+			return *(T*)&ret;
+		}
+	}
+	IL2CPP_TRAP;
+}
 
+// 返回相加前的值, 按无符号数回绕
+template <class T>
+T il2cpp_ExchangeAdd(T* dst, T value)
+{
+	static_assert(std::is_integral<T>::value, "");
+	switch (sizeof(T))
+	{
+	case 4:
+		return (T)IL2CPP_ATOMIC_XADD_32((uint32_t*)dst, (uint32_t)value);
 	case 8:
-		return (T)IL2CPP_ATOMIC_CAS_64(dst, comparand, value);
+		return (T)IL2CPP_ATOMIC_XADD_64((uint64_t*)dst, (uint64_t)value);
 	}
 	IL2CPP_TRAP;
 }
 
-void il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index);
-void il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index, int64_t rangeLen);
+// 返回相加后的值
+template <class T>
+T il2cpp_InterlockedAdd(T* dst, T value)
+{
+	typedef typename std::make_unsigned<T>::type U;
+	return (T)((U)il2cpp_ExchangeAdd(dst, value) + (U)value);
+}
+
+IL2CPP_NOINLINE IL2CPP_COLD void il2cpp_ThrowIndexOutOfRange();
+IL2CPP_NOINLINE IL2CPP_COLD void il2cpp_ThrowNullReference();
+// 调用了没有实现的外部方法
+[[noreturn]] IL2CPP_NOINLINE IL2CPP_COLD void il2cpp_MissingNative(const char* name);
+// 由运行时接管的方法校验参数失败时抛出, 状态返回模式下调用方需随后返回
+IL2CPP_NOINLINE IL2CPP_COLD void il2cpp_ThrowArgumentOutOfRange();
+IL2CPP_NOINLINE IL2CPP_COLD void il2cpp_ThrowArgumentNull();
+// 越界时抛出异常并返回 false, 状态返回模式下调用方需据此提前返回
+bool il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index);
+bool il2cpp_CheckRange(int64_t lowerBound, int64_t length, int64_t index, int64_t rangeLen);
+void il2cpp_CheckSlice(int64_t length, int64_t index, int64_t count);
+
+// 一维数组与字符串的下标检查, 负数转为无符号后必然越界
+inline void il2cpp_CheckSZRange(uint32_t length, int32_t index)
+{
+#if !defined(IL2CPP_DISABLE_CHECK_RANGE)
+	if (IL2CPP_UNLIKELY((uint32_t)index >= length))
+		il2cpp_ThrowIndexOutOfRange();
+#endif
+}
 float il2cpp_Remainder(float numer, float denom);
 double il2cpp_Remainder(double numer, double denom);
 float il2cpp_Ckfinite(float num);
 double il2cpp_Ckfinite(double num);
-void il2cpp_ThrowInvalidCast();
-void il2cpp_ThrowOverflow();
+IL2CPP_NOINLINE IL2CPP_COLD void il2cpp_ThrowInvalidCast();
+IL2CPP_NOINLINE IL2CPP_COLD void il2cpp_ThrowOverflow();
 
 struct cls_System_Array;
 
@@ -0,0 +1,1090 @@
+﻿#include "il2cpp.h"
+#include <string.h>
+#include <algorithm>
+
+#if defined(IL2CPP_ENABLE_PARALLEL_SORT)
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+#endif
+
+#if defined(IL2CPP_X86)
+#include <immintrin.h>
+#endif
+
+// 批量数组操作的向量化内核. 查找/翻转按元素大小 1/2/4/8 分派, 其他大小走通用实现
+template <uint32_t Size> struct ElemOf;
+template <> struct ElemOf<1> { typedef uint8_t Type; };
+template <> struct ElemOf<2> { typedef uint16_t Type; };
+template <> struct ElemOf<4> { typedef uint32_t Type; };
+template <> struct ElemOf<8> { typedef uint64_t Type; };
+
+static inline int32_t SizeClass(uint32_t elemSize)
+{
+	switch (elemSize)
+	{
+	case 1: return 0;
+	case 2: return 1;
+	case 4: return 2;
+	case 8: return 3;
+	default: return -1;
+	}
+}
+
+static inline uint64_t LoadValue(const void* value, uint32_t elemSize)
+{
+	uint64_t val = 0;
+	IL2CPP_MEMCPY(&val, value, elemSize);
+	return val;
+}
+
+template <uint32_t Size>
+static intptr_t IndexOf_Scalar(const uint8_t* data, size_t count, uint64_t value)
+{
+	typedef typename ElemOf<Size>::Type T;
+	const T* p = (const T*)data;
+	const T val = (T)value;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (p[i] == val)
+			return (intptr_t)i;
+	}
+	return -1;
+}
+
+template <uint32_t Size>
+static intptr_t LastIndexOf_Scalar(const uint8_t* data, size_t count, uint64_t value)
+{
+	typedef typename ElemOf<Size>::Type T;
+	const T* p = (const T*)data;
+	const T val = (T)value;
+	for (size_t i = count; i > 0; --i)
+	{
+		if (p[i - 1] == val)
+			return (intptr_t)(i - 1);
+	}
+	return -1;
+}
+
+template <uint32_t Size>
+static void Reverse_Scalar(uint8_t* data, size_t count)
+{
+	typedef typename ElemOf<Size>::Type T;
+	T* lo = (T*)data;
+	T* hi = lo + count;
+	while (lo + 1 < hi)
+	{
+		--hi;
+		T tmp = *lo;
+		*lo = *hi;
+		*hi = tmp;
+		++lo;
+	}
+}
+
+// pattern 为 32 字节的元素重复序列
+static void FillPattern_Scalar(uint8_t* dst, size_t bytes, const uint8_t* pattern)
+{
+	size_t i = 0;
+	for (; i + 32 <= bytes; i += 32)
+		IL2CPP_MEMCPY(dst + i, pattern, 32);
+	IL2CPP_MEMCPY(dst + i, pattern, bytes - i);
+}
+
+#if defined(IL2CPP_X86)
+// 逐元素比较, 返回每字节一位的掩码
+template <uint32_t Size>
+IL2CPP_TARGET("sse2")
+static inline uint32_t EqMask_SSE2(__m128i x, __m128i v)
+{
+	__m128i eq;
+	if (Size == 1)
+		eq = _mm_cmpeq_epi8(x, v);
+	else if (Size == 2)
+		eq = _mm_cmpeq_epi16(x, v);
+	else if (Size == 4)
+		eq = _mm_cmpeq_epi32(x, v);
+	else
+	{
+		// SSE2 没有 64 位比较, 两个 32 位半部都相等才算相等
+		eq = _mm_cmpeq_epi32(x, v);
+		eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, 0xB1));
+	}
+	return (uint32_t)_mm_movemask_epi8(eq);
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("sse2")
+static inline __m128i Broadcast_SSE2(uint64_t value)
+{
+	if (Size == 1)
+		return _mm_set1_epi8((char)value);
+	else if (Size == 2)
+		return _mm_set1_epi16((short)value);
+	else if (Size == 4)
+		return _mm_set1_epi32((int)value);
+	else
+		return _mm_set_epi32((int)(value >> 32), (int)value, (int)(value >> 32), (int)value);
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("sse2")
+static inline __m128i ReverseVec_SSE2(__m128i x)
+{
+	if (Size == 8)
+		return _mm_shuffle_epi32(x, 0x4E);
+	if (Size == 4)
+		return _mm_shuffle_epi32(x, 0x1B);
+	if (Size == 1)
+		x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+	x = _mm_shufflelo_epi16(x, 0x1B);
+	x = _mm_shufflehi_epi16(x, 0x1B);
+	return _mm_shuffle_epi32(x, 0x4E);
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("sse2")
+static intptr_t IndexOf_SSE2(const uint8_t* data, size_t count, uint64_t value)
+{
+	const size_t bytes = count * Size;
+	if (bytes < 16)
+		return IndexOf_Scalar<Size>(data, count, value);
+
+	const __m128i v = Broadcast_SSE2<Size>(value);
+	const size_t last = bytes - 16;
+	for (size_t i = 0; i < last; i += 16)
+	{
+		uint32_t mask = EqMask_SSE2<Size>(_mm_loadu_si128((const __m128i*)(data + i)), v);
+		if (mask)
+			return (intptr_t)((i + il2cpp_Ctz32(mask)) / Size);
+	}
+	// 重叠部分已确认不包含目标元素
+	uint32_t mask = EqMask_SSE2<Size>(_mm_loadu_si128((const __m128i*)(data + last)), v);
+	if (mask)
+		return (intptr_t)((last + il2cpp_Ctz32(mask)) / Size);
+	return -1;
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("sse2")
+static intptr_t LastIndexOf_SSE2(const uint8_t* data, size_t count, uint64_t value)
+{
+	const size_t bytes = count * Size;
+	if (bytes < 16)
+		return LastIndexOf_Scalar<Size>(data, count, value);
+
+	const __m128i v = Broadcast_SSE2<Size>(value);
+	size_t i = bytes;
+	for (; i > 16; i -= 16)
+	{
+		uint32_t mask = EqMask_SSE2<Size>(_mm_loadu_si128((const __m128i*)(data + i - 16)), v);
+		if (mask)
+			return (intptr_t)((i - 16 + 31 - il2cpp_Clz32(mask)) / Size);
+	}
+	uint32_t mask = EqMask_SSE2<Size>(_mm_loadu_si128((const __m128i*)data), v);
+	if (mask)
+		return (intptr_t)((31 - il2cpp_Clz32(mask)) / Size);
+	return -1;
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("sse2")
+static void Reverse_SSE2(uint8_t* data, size_t count)
+{
+	uint8_t* lo = data;
+	uint8_t* hi = data + count * Size;
+	while (hi - lo >= 32)
+	{
+		hi -= 16;
+		__m128i a = _mm_loadu_si128((const __m128i*)lo);
+		__m128i b = _mm_loadu_si128((const __m128i*)hi);
+		_mm_storeu_si128((__m128i*)lo, ReverseVec_SSE2<Size>(b));
+		_mm_storeu_si128((__m128i*)hi, ReverseVec_SSE2<Size>(a));
+		lo += 16;
+	}
+	Reverse_Scalar<Size>(lo, (size_t)(hi - lo) / Size);
+}
+
+IL2CPP_TARGET("sse2")
+static void FillPattern_SSE2(uint8_t* dst, size_t bytes, const uint8_t* pattern)
+{
+	const __m128i v0 = _mm_loadu_si128((const __m128i*)pattern);
+	const __m128i v1 = _mm_loadu_si128((const __m128i*)(pattern + 16));
+	size_t i = 0;
+	for (; i + 32 <= bytes; i += 32)
+	{
+		_mm_storeu_si128((__m128i*)(dst + i), v0);
+		_mm_storeu_si128((__m128i*)(dst + i + 16), v1);
+	}
+	IL2CPP_MEMCPY(dst + i, pattern, bytes - i);
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("avx2")
+static inline uint32_t EqMask_AVX2(__m256i x, __m256i v)
+{
+	__m256i eq;
+	if (Size == 1)
+		eq = _mm256_cmpeq_epi8(x, v);
+	else if (Size == 2)
+		eq = _mm256_cmpeq_epi16(x, v);
+	else if (Size == 4)
+		eq = _mm256_cmpeq_epi32(x, v);
+	else
+		eq = _mm256_cmpeq_epi64(x, v);
+	return (uint32_t)_mm256_movemask_epi8(eq);
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("avx2")
+static inline __m256i Broadcast_AVX2(uint64_t value)
+{
+	if (Size == 1)
+		return _mm256_set1_epi8((char)value);
+	else if (Size == 2)
+		return _mm256_set1_epi16((short)value);
+	else if (Size == 4)
+		return _mm256_set1_epi32((int)value);
+	else
+		return _mm256_set1_epi64x((long long)value);
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("avx2")
+static inline __m256i ReverseVec_AVX2(__m256i x)
+{
+	if (Size == 8)
+		return _mm256_permute4x64_epi64(x, 0x1B);
+	if (Size == 4)
+		return _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+	// 先在 128 位通道内翻转, 再交换两个通道
+	const __m256i shuf = Size == 1 ?
+		_mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0) :
+		_mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+			14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+	return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(x, shuf), 0x4E);
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("avx2")
+static intptr_t IndexOf_AVX2(const uint8_t* data, size_t count, uint64_t value)
+{
+	const size_t bytes = count * Size;
+	if (bytes < 32)
+		return IndexOf_SSE2<Size>(data, count, value);
+
+	const __m256i v = Broadcast_AVX2<Size>(value);
+	const size_t last = bytes - 32;
+	for (size_t i = 0; i < last; i += 32)
+	{
+		uint32_t mask = EqMask_AVX2<Size>(_mm256_loadu_si256((const __m256i*)(data + i)), v);
+		if (mask)
+			return (intptr_t)((i + il2cpp_Ctz32(mask)) / Size);
+	}
+	uint32_t mask = EqMask_AVX2<Size>(_mm256_loadu_si256((const __m256i*)(data + last)), v);
+	if (mask)
+		return (intptr_t)((last + il2cpp_Ctz32(mask)) / Size);
+	return -1;
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("avx2")
+static intptr_t LastIndexOf_AVX2(const uint8_t* data, size_t count, uint64_t value)
+{
+	const size_t bytes = count * Size;
+	if (bytes < 32)
+		return LastIndexOf_SSE2<Size>(data, count, value);
+
+	const __m256i v = Broadcast_AVX2<Size>(value);
+	size_t i = bytes;
+	for (; i > 32; i -= 32)
+	{
+		uint32_t mask = EqMask_AVX2<Size>(_mm256_loadu_si256((const __m256i*)(data + i - 32)), v);
+		if (mask)
+			return (intptr_t)((i - 32 + 31 - il2cpp_Clz32(mask)) / Size);
+	}
+	uint32_t mask = EqMask_AVX2<Size>(_mm256_loadu_si256((const __m256i*)data), v);
+	if (mask)
+		return (intptr_t)((31 - il2cpp_Clz32(mask)) / Size);
+	return -1;
+}
+
+template <uint32_t Size>
+IL2CPP_TARGET("avx2")
+static void Reverse_AVX2(uint8_t* data, size_t count)
+{
+	uint8_t* lo = data;
+	uint8_t* hi = data + count * Size;
+	while (hi - lo >= 64)
+	{
+		hi -= 32;
+		__m256i a = _mm256_loadu_si256((const __m256i*)lo);
+		__m256i b = _mm256_loadu_si256((const __m256i*)hi);
+		_mm256_storeu_si256((__m256i*)lo, ReverseVec_AVX2<Size>(b));
+		_mm256_storeu_si256((__m256i*)hi, ReverseVec_AVX2<Size>(a));
+		lo += 32;
+	}
+	Reverse_SSE2<Size>(lo, (size_t)(hi - lo) / Size);
+}
+
+IL2CPP_TARGET("avx2")
+static void FillPattern_AVX2(uint8_t* dst, size_t bytes, const uint8_t* pattern)
+{
+	const __m256i v = _mm256_loadu_si256((const __m256i*)pattern);
+	size_t i = 0;
+	for (; i + 32 <= bytes; i += 32)
+		_mm256_storeu_si256((__m256i*)(dst + i), v);
+	IL2CPP_MEMCPY(dst + i, pattern, bytes - i);
+}
+#endif
+
+typedef intptr_t(*ArraySearchFunc)(const uint8_t*, size_t, uint64_t);
+typedef void(*ArrayReverseFunc)(uint8_t*, size_t);
+
+static ArraySearchFunc s_IndexOf[4] =
+{
+	&IndexOf_Scalar<1>, &IndexOf_Scalar<2>, &IndexOf_Scalar<4>, &IndexOf_Scalar<8>
+};
+static ArraySearchFunc s_LastIndexOf[4] =
+{
+	&LastIndexOf_Scalar<1>, &LastIndexOf_Scalar<2>, &LastIndexOf_Scalar<4>, &LastIndexOf_Scalar<8>
+};
+static ArrayReverseFunc s_Reverse[4] =
+{
+	&Reverse_Scalar<1>, &Reverse_Scalar<2>, &Reverse_Scalar<4>, &Reverse_Scalar<8>
+};
+static void(*s_FillPattern)(uint8_t*, size_t, const uint8_t*) = &FillPattern_Scalar;
+
+void il2cpp_Array__InitKernels()
+{
+#if defined(IL2CPP_X86)
+	if (il2cpp_CPUFeatures & IL2CPP_CPU_AVX2)
+	{
+		s_IndexOf[0] = &IndexOf_AVX2<1>;
+		s_IndexOf[1] = &IndexOf_AVX2<2>;
+		s_IndexOf[2] = &IndexOf_AVX2<4>;
+		s_IndexOf[3] = &IndexOf_AVX2<8>;
+		s_LastIndexOf[0] = &LastIndexOf_AVX2<1>;
+		s_LastIndexOf[1] = &LastIndexOf_AVX2<2>;
+		s_LastIndexOf[2] = &LastIndexOf_AVX2<4>;
+		s_LastIndexOf[3] = &LastIndexOf_AVX2<8>;
+		s_Reverse[0] = &Reverse_AVX2<1>;
+		s_Reverse[1] = &Reverse_AVX2<2>;
+		s_Reverse[2] = &Reverse_AVX2<4>;
+		s_Reverse[3] = &Reverse_AVX2<8>;
+		s_FillPattern = &FillPattern_AVX2;
+	}
+	else if (il2cpp_CPUFeatures & IL2CPP_CPU_SSE2)
+	{
+		s_IndexOf[0] = &IndexOf_SSE2<1>;
+		s_IndexOf[1] = &IndexOf_SSE2<2>;
+		s_IndexOf[2] = &IndexOf_SSE2<4>;
+		s_IndexOf[3] = &IndexOf_SSE2<8>;
+		s_LastIndexOf[0] = &LastIndexOf_SSE2<1>;
+		s_LastIndexOf[1] = &LastIndexOf_SSE2<2>;
+		s_LastIndexOf[2] = &LastIndexOf_SSE2<4>;
+		s_LastIndexOf[3] = &LastIndexOf_SSE2<8>;
+		s_Reverse[0] = &Reverse_SSE2<1>;
+		s_Reverse[1] = &Reverse_SSE2<2>;
+		s_Reverse[2] = &Reverse_SSE2<4>;
+		s_Reverse[3] = &Reverse_SSE2<8>;
+		s_FillPattern = &FillPattern_SSE2;
+	}
+#endif
+}
+
+void il2cpp_Array__Fill(void* data, uint32_t elemSize, const void* value, uint32_t count)
+{
+	if (count == 0)
+		return;
+
+	uint8_t* dst = (uint8_t*)data;
+	const uint8_t* src = (const uint8_t*)value;
+	const size_t bytes = (size_t)elemSize * count;
+
+	// 所有字节都相同时直接交给 memset
+	bool sameBytes = true;
+	for (uint32_t i = 1; i < elemSize; ++i)
+	{
+		if (src[i] != src[0])
+		{
+			sameBytes = false;
+			break;
+		}
+	}
+	if (sameBytes)
+	{
+		IL2CPP_MEMSET(dst, src[0], bytes);
+		return;
+	}
+
+	if (elemSize <= 32 && (32 % elemSize) == 0)
+	{
+		uint8_t pattern[32];
+		for (uint32_t i = 0; i < 32; i += elemSize)
+			IL2CPP_MEMCPY(pattern + i, src, elemSize);
+		s_FillPattern(dst, bytes, pattern);
+		return;
+	}
+
+	// 其他大小按已填充区域倍增复制
+	IL2CPP_MEMCPY(dst, src, elemSize);
+	size_t filled = elemSize;
+	while (filled < bytes)
+	{
+		size_t n = il2cpp_Min(filled, bytes - filled);
+		IL2CPP_MEMCPY(dst + filled, dst, n);
+		filled += n;
+	}
+}
+
+int32_t il2cpp_Array__IndexOf(const void* data, uint32_t elemSize, const void* value, uint32_t count)
+{
+	int32_t sc = SizeClass(elemSize);
+	IL2CPP_ASSERT(sc >= 0);
+	return (int32_t)s_IndexOf[sc]((const uint8_t*)data, count, LoadValue(value, elemSize));
+}
+
+int32_t il2cpp_Array__LastIndexOf(const void* data, uint32_t elemSize, const void* value, uint32_t count)
+{
+	int32_t sc = SizeClass(elemSize);
+	IL2CPP_ASSERT(sc >= 0);
+	return (int32_t)s_LastIndexOf[sc]((const uint8_t*)data, count, LoadValue(value, elemSize));
+}
+
+void il2cpp_Array__Reverse(void* data, uint32_t elemSize, uint32_t count)
+{
+	int32_t sc = SizeClass(elemSize);
+	if (IL2CPP_LIKELY(sc >= 0))
+	{
+		s_Reverse[sc]((uint8_t*)data, count);
+		return;
+	}
+
+	// 非基础大小的元素逐字节交换
+	uint8_t* lo = (uint8_t*)data;
+	uint8_t* hi = lo + (size_t)elemSize * count;
+	while (hi - lo > (intptr_t)elemSize)
+	{
+		hi -= elemSize;
+		for (uint32_t i = 0; i < elemSize; ++i)
+		{
+			uint8_t tmp = lo[i];
+			lo[i] = hi[i];
+			hi[i] = tmp;
+		}
+		lo += elemSize;
+	}
+}
+
+// 排序: 小数组用 pdqsort, 大的整数数组用 LSD 基数排序
+// 浮点按 CompareTo 语义排序, NaN 排在最前
+#define PDQ_INSERTION_SORT_THRESHOLD		24
+#define PDQ_NINTHER_THRESHOLD				128
+#define PDQ_PARTIAL_INSERTION_SORT_LIMIT	8
+#define RADIX_SORT_THRESHOLD				4096
+
+#if !defined(IL2CPP_PARALLEL_SORT_THRESHOLD)
+#define IL2CPP_PARALLEL_SORT_THRESHOLD		(1u << 20)
+#endif
+
+template <typename T>
+struct SortLess
+{
+	bool operator()(const T& lhs, const T& rhs) const
+	{
+		return lhs < rhs;
+	}
+};
+
+template <>
+struct SortLess<float>
+{
+	bool operator()(float lhs, float rhs) const
+	{
+		return lhs < rhs || (lhs != lhs && rhs == rhs);
+	}
+};
+
+template <>
+struct SortLess<double>
+{
+	bool operator()(double lhs, double rhs) const
+	{
+		return lhs < rhs || (lhs != lhs && rhs == rhs);
+	}
+};
+
+// 带原始下标的键, 用于键值对排序
+template <typename T>
+struct SortPair
+{
+	T Key;
+	uint32_t Index;
+};
+
+template <typename T>
+struct SortPairLess
+{
+	bool operator()(const SortPair<T>& lhs, const SortPair<T>& rhs) const
+	{
+		return SortLess<T>()(lhs.Key, rhs.Key);
+	}
+};
+
+template <typename T>
+static inline void SortSwap(T* lhs, T* rhs)
+{
+	T tmp = *lhs;
+	*lhs = *rhs;
+	*rhs = tmp;
+}
+
+template <typename T, typename Less>
+static inline void Sort2(T* a, T* b, Less less)
+{
+	if (less(*b, *a))
+		SortSwap(a, b);
+}
+
+template <typename T, typename Less>
+static inline void Sort3(T* a, T* b, T* c, Less less)
+{
+	Sort2(a, b, less);
+	Sort2(b, c, less);
+	Sort2(a, b, less);
+}
+
+template <typename T, typename Less>
+static void InsertionSort(T* begin, T* end, Less less)
+{
+	if (begin == end)
+		return;
+
+	for (T* cur = begin + 1; cur != end; ++cur)
+	{
+		T* sift = cur;
+		T* sift1 = cur - 1;
+		if (less(*sift, *sift1))
+		{
+			T tmp = *sift;
+			do
+			{
+				*sift-- = *sift1;
+			} while (sift != begin && less(tmp, *--sift1));
+			*sift = tmp;
+		}
+	}
+}
+
+// 要求 begin 左侧存在不大于区间内所有元素的哨兵
+template <typename T, typename Less>
+static void UnguardedInsertionSort(T* begin, T* end, Less less)
+{
+	if (begin == end)
+		return;
+
+	for (T* cur = begin + 1; cur != end; ++cur)
+	{
+		T* sift = cur;
+		T* sift1 = cur - 1;
+		if (less(*sift, *sift1))
+		{
+			T tmp = *sift;
+			do
+			{
+				*sift-- = *sift1;
+			} while (less(tmp, *--sift1));
+			*sift = tmp;
+		}
+	}
+}
+
+// 移动次数超过上限时放弃, 返回 false
+template <typename T, typename Less>
+static bool PartialInsertionSort(T* begin, T* end, Less less)
+{
+	if (begin == end)
+		return true;
+
+	size_t moves = 0;
+	for (T* cur = begin + 1; cur != end; ++cur)
+	{
+		T* sift = cur;
+		T* sift1 = cur - 1;
+		if (less(*sift, *sift1))
+		{
+			T tmp = *sift;
+			do
+			{
+				*sift-- = *sift1;
+			} while (sift != begin && less(tmp, *--sift1));
+			*sift = tmp;
+			moves += (size_t)(cur - sift);
+		}
+
+		if (moves > PDQ_PARTIAL_INSERTION_SORT_LIMIT)
+			return false;
+	}
+	return true;
+}
+
+// 以 *begin 为枢轴, 与枢轴相等的元素分到右侧
+template <typename T, typename Less>
+static T* PartitionRight(T* begin, T* end, bool& alreadyPartitioned, Less less)
+{
+	T pivot = *begin;
+	T* first = begin;
+	T* last = end;
+
+	while (less(*++first, pivot));
+
+	if (first - 1 == begin)
+	{
+		while (first < last && !less(*--last, pivot));
+	}
+	else
+	{
+		while (!less(*--last, pivot));
+	}
+
+	alreadyPartitioned = first >= last;
+
+	while (first < last)
+	{
+		SortSwap(first, last);
+		while (less(*++first, pivot));
+		while (!less(*--last, pivot));
+	}
+
+	T* pivotPos = first - 1;
+	*begin = *pivotPos;
+	*pivotPos = pivot;
+	return pivotPos;
+}
+
+// 与枢轴相等的元素分到左侧, 用于处理大量重复键
+template <typename T, typename Less>
+static T* PartitionLeft(T* begin, T* end, Less less)
+{
+	T pivot = *begin;
+	T* first = begin;
+	T* last = end;
+
+	while (less(pivot, *--last));
+
+	if (last + 1 == end)
+	{
+		while (first < last && !less(pivot, *++first));
+	}
+	else
+	{
+		while (!less(pivot, *++first));
+	}
+
+	while (first < last)
+	{
+		SortSwap(first, last);
+		while (less(pivot, *--last));
+		while (!less(pivot, *++first));
+	}
+
+	T* pivotPos = last;
+	*begin = *pivotPos;
+	*pivotPos = pivot;
+	return pivotPos;
+}
+
+template <typename T, typename Less>
+static void PdqSortLoop(T* begin, T* end, Less less, int32_t badAllowed, bool leftmost)
+{
+	for (;;)
+	{
+		size_t size = (size_t)(end - begin);
+		if (size < PDQ_INSERTION_SORT_THRESHOLD)
+		{
+			if (leftmost)
+				InsertionSort(begin, end, less);
+			else
+				UnguardedInsertionSort(begin, end, less);
+			return;
+		}
+
+		size_t half = size / 2;
+		if (size > PDQ_NINTHER_THRESHOLD)
+		{
+			Sort3(begin, begin + half, end - 1, less);
+			Sort3(begin + 1, begin + (half - 1), end - 2, less);
+			Sort3(begin + 2, begin + (half + 1), end - 3, less);
+			Sort3(begin + (half - 1), begin + half, begin + (half + 1), less);
+			SortSwap(begin, begin + half);
+		}
+		else
+			Sort3(begin + half, begin, end - 1, less);
+
+		// 枢轴与左侧哨兵相等, 说明区间内有大量与之相等的元素
+		if (!leftmost && !less(*(begin - 1), *begin))
+		{
+			begin = PartitionLeft(begin, end, less) + 1;
+			continue;
+		}
+
+		bool alreadyPartitioned;
+		T* pivotPos = PartitionRight(begin, end, alreadyPartitioned, less);
+
+		size_t leftSize = (size_t)(pivotPos - begin);
+		size_t rightSize = (size_t)(end - (pivotPos + 1));
+		if (leftSize < size / 8 || rightSize < size / 8)
+		{
+			// 划分严重失衡时打乱部分元素, 次数用尽则退回堆排序
+			if (--badAllowed == 0)
+			{
+				std::make_heap(begin, end, less);
+				std::sort_heap(begin, end, less);
+				return;
+			}
+
+			if (leftSize >= PDQ_INSERTION_SORT_THRESHOLD)
+			{
+				SortSwap(begin, begin + leftSize / 4);
+				SortSwap(pivotPos - 1, pivotPos - leftSize / 4);
+				if (leftSize > PDQ_NINTHER_THRESHOLD)
+				{
+					SortSwap(begin + 1, begin + (leftSize / 4 + 1));
+					SortSwap(begin + 2, begin + (leftSize / 4 + 2));
+					SortSwap(pivotPos - 2, pivotPos - (leftSize / 4 + 1));
+					SortSwap(pivotPos - 3, pivotPos - (leftSize / 4 + 2));
+				}
+			}
+
+			if (rightSize >= PDQ_INSERTION_SORT_THRESHOLD)
+			{
+				SortSwap(pivotPos + 1, pivotPos + (1 + rightSize / 4));
+				SortSwap(end - 1, end - rightSize / 4);
+				if (rightSize > PDQ_NINTHER_THRESHOLD)
+				{
+					SortSwap(pivotPos + 2, pivotPos + (2 + rightSize / 4));
+					SortSwap(pivotPos + 3, pivotPos + (3 + rightSize / 4));
+					SortSwap(end - 2, end - (1 + rightSize / 4));
+					SortSwap(end - 3, end - (2 + rightSize / 4));
+				}
+			}
+		}
+		else if (alreadyPartitioned &&
+			PartialInsertionSort(begin, pivotPos, less) &&
+			PartialInsertionSort(pivotPos + 1, end, less))
+		{
+			return;
+		}
+
+		PdqSortLoop(begin, pivotPos, less, badAllowed, leftmost);
+		begin = pivotPos + 1;
+		leftmost = false;
+	}
+}
+
+template <typename T, typename Less>
+static void PdqSort(T* begin, T* end, Less less)
+{
+	if (end - begin < 2)
+		return;
+
+	int32_t logSize = 0;
+	for (size_t n = (size_t)(end - begin); n > 1; n >>= 1)
+		++logSize;
+	PdqSortLoop(begin, end, less, logSize, true);
+}
+
+// 把整数键映射为无符号数, 使其按无符号比较的顺序与原顺序一致
+template <typename T>
+static inline typename std::make_unsigned<T>::type RadixKey(T val)
+{
+	typedef typename std::make_unsigned<T>::type U;
+	if (std::is_signed<T>::value)
+		return (U)val ^ ((U)1 << (sizeof(T) * 8 - 1));
+	return (U)val;
+}
+
+// 每次按 8 位分桶, 所有元素在某一字节上相同时跳过该趟
+template <typename T>
+static void RadixSort(T* data, T* scratch, size_t count)
+{
+	const uint32_t passes = sizeof(T);
+	uint32_t* counts = (uint32_t*)calloc(passes * 256, sizeof(uint32_t));
+	if (!counts)
+	{
+		PdqSort(data, data + count, SortLess<T>());
+		return;
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		auto key = RadixKey(data[i]);
+		for (uint32_t p = 0; p < passes; ++p)
+			++counts[p * 256 + (uint32_t)((key >> (p * 8)) & 0xFF)];
+	}
+
+	T* src = data;
+	T* dst = scratch;
+	for (uint32_t p = 0; p < passes; ++p)
+	{
+		uint32_t* cnt = counts + p * 256;
+		const uint32_t shift = p * 8;
+		if (cnt[(uint32_t)((RadixKey(src[0]) >> shift) & 0xFF)] == count)
+			continue;
+
+		uint32_t offset = 0;
+		for (uint32_t b = 0; b < 256; ++b)
+		{
+			uint32_t n = cnt[b];
+			cnt[b] = offset;
+			offset += n;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			T val = src[i];
+			dst[cnt[(uint32_t)((RadixKey(val) >> shift) & 0xFF)]++] = val;
+		}
+
+		T* tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+
+	if (src != data)
+		IL2CPP_MEMCPY(data, src, count * sizeof(T));
+	free(counts);
+}
+
+// 在给定的临时缓冲上排序, 整数键较多时使用基数排序
+template <typename T, bool IsIntegral = std::is_integral<T>::value>
+struct SequentialSort
+{
+	static void Run(T* data, T*, size_t count)
+	{
+		PdqSort(data, data + count, SortLess<T>());
+	}
+};
+
+template <typename T>
+struct SequentialSort<T, true>
+{
+	static void Run(T* data, T* scratch, size_t count)
+	{
+		if (scratch && count >= RADIX_SORT_THRESHOLD)
+			RadixSort(data, scratch, count);
+		else
+			PdqSort(data, data + count, SortLess<T>());
+	}
+};
+
+#if defined(IL2CPP_ENABLE_PARALLEL_SORT)
+// 采样排序: 按分隔键把元素分散到各个桶, 再并行排序每个桶
+#define SAMPLE_SORT_OVERSAMPLE		64
+
+template <typename T>
+static bool ParallelSampleSort(T* data, size_t count)
+{
+	uint32_t numThreads = std::thread::hardware_concurrency();
+	if (numThreads < 2)
+		return false;
+
+	const uint32_t numBuckets = il2cpp_Min(numThreads * 4, 256u);
+	T* scratch = (T*)malloc(count * sizeof(T));
+	uint8_t* bucketOf = (uint8_t*)malloc(count);
+	if (!scratch || !bucketOf)
+	{
+		free(scratch);
+		free(bucketOf);
+		return false;
+	}
+
+	SortLess<T> less;
+
+	// 等距采样选出分隔键
+	const size_t numSamples = (size_t)numBuckets * SAMPLE_SORT_OVERSAMPLE;
+	std::vector<T> samples(numSamples);
+	for (size_t i = 0; i < numSamples; ++i)
+		samples[i] = data[i * (count / numSamples)];
+	PdqSort(samples.data(), samples.data() + numSamples, less);
+
+	std::vector<T> splitters(numBuckets - 1);
+	for (uint32_t i = 0; i < numBuckets - 1; ++i)
+		splitters[i] = samples[(i + 1) * SAMPLE_SORT_OVERSAMPLE];
+
+	// 每个线程统计自己那一段的桶分布
+	const size_t chunkSize = (count + numThreads - 1) / numThreads;
+	std::vector<uint32_t> counts((size_t)numThreads * numBuckets);
+	auto runParallel = [numThreads](const std::function<void(uint32_t)>& func)
+	{
+		std::vector<std::thread> workers;
+		for (uint32_t t = 1; t < numThreads; ++t)
+			workers.emplace_back(func, t);
+		func(0);
+		for (auto& worker : workers)
+			worker.join();
+	};
+
+	runParallel([&](uint32_t t)
+	{
+		size_t begin = il2cpp_Min(t * chunkSize, count);
+		size_t end = il2cpp_Min(begin + chunkSize, count);
+		uint32_t* cnt = &counts[(size_t)t * numBuckets];
+		for (size_t i = begin; i < end; ++i)
+		{
+			uint8_t b = (uint8_t)(std::upper_bound(splitters.begin(), splitters.end(), data[i], less) - splitters.begin());
+			bucketOf[i] = b;
+			++cnt[b];
+		}
+	});
+
+	// 桶优先, 段次之计算各自的写入位置
+	std::vector<size_t> bucketStart(numBuckets + 1);
+	size_t offset = 0;
+	for (uint32_t b = 0; b < numBuckets; ++b)
+	{
+		bucketStart[b] = offset;
+		for (uint32_t t = 0; t < numThreads; ++t)
+		{
+			uint32_t n = counts[(size_t)t * numBuckets + b];
+			counts[(size_t)t * numBuckets + b] = (uint32_t)offset;
+			offset += n;
+		}
+	}
+	bucketStart[numBuckets] = offset;
+
+	runParallel([&](uint32_t t)
+	{
+		size_t begin = il2cpp_Min(t * chunkSize, count);
+		size_t end = il2cpp_Min(begin + chunkSize, count);
+		uint32_t* pos = &counts[(size_t)t * numBuckets];
+		for (size_t i = begin; i < end; ++i)
+			scratch[pos[bucketOf[i]]++] = data[i];
+	});
+
+	// 动态领取桶并排序, 原数组对应区间作为临时缓冲
+	std::atomic<uint32_t> nextBucket(0);
+	runParallel([&](uint32_t)
+	{
+		for (;;)
+		{
+			uint32_t b = nextBucket.fetch_add(1);
+			if (b >= numBuckets)
+				break;
+			size_t begin = bucketStart[b];
+			size_t n = bucketStart[b + 1] - begin;
+			SequentialSort<T>::Run(scratch + begin, data + begin, n);
+			IL2CPP_MEMCPY(data + begin, scratch + begin, n * sizeof(T));
+		}
+	});
+
+	free(scratch);
+	free(bucketOf);
+	return true;
+}
+#endif
+
+template <typename T>
+static void SortKeys(void* keys, uint32_t count)
+{
+	T* data = (T*)keys;
+#if defined(IL2CPP_ENABLE_PARALLEL_SORT)
+	if (count >= IL2CPP_PARALLEL_SORT_THRESHOLD && ParallelSampleSort(data, count))
+		return;
+#endif
+
+	T* scratch = nullptr;
+	if (std::is_integral<T>::value && count >= RADIX_SORT_THRESHOLD)
+		scratch = (T*)malloc((size_t)count * sizeof(T));
+	SequentialSort<T>::Run(data, scratch, count);
+	free(scratch);
+}
+
+// 先对 (键, 下标) 排序, 再按环置换原地移动值元素
+// 置换过程中每个值元素始终留在数组或栈上, 保证 GC 可见
+template <typename T>
+static void SortKeysItems(void* keys, void* items, uint32_t itemSize, uint32_t count)
+{
+	SortPair<T>* pairs = (SortPair<T>*)malloc((size_t)count * sizeof(SortPair<T>));
+	IL2CPP_ASSERT(pairs);
+
+	T* keyData = (T*)keys;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		pairs[i].Key = keyData[i];
+		pairs[i].Index = i;
+	}
+	PdqSort(pairs, pairs + count, SortPairLess<T>());
+
+	for (uint32_t i = 0; i < count; ++i)
+		keyData[i] = pairs[i].Key;
+
+	uint8_t* itemData = (uint8_t*)items;
+	uint8_t localBuf[64];
+	uint8_t* tmp = itemSize <= sizeof(localBuf) ? localBuf : (uint8_t*)il2cpp_GC_Alloc(itemSize);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		if (pairs[i].Index == i)
+			continue;
+
+		IL2CPP_MEMCPY(tmp, itemData + (size_t)i * itemSize, itemSize);
+		uint32_t j = i;
+		for (;;)
+		{
+			uint32_t from = pairs[j].Index;
+			pairs[j].Index = j;
+			if (from == i)
+				break;
+			IL2CPP_MEMCPY(itemData + (size_t)j * itemSize, itemData + (size_t)from * itemSize, itemSize);
+			j = from;
+		}
+		IL2CPP_MEMCPY(itemData + (size_t)j * itemSize, tmp, itemSize);
+	}
+
+	free(pairs);
+}
+
+void il2cpp_Array__Sort(void* keys, uint32_t keyKind, uint32_t count)
+{
+	if (count < 2)
+		return;
+
+	switch (keyKind)
+	{
+	case IL2CPP_SORTKEY_I1: SortKeys<int8_t>(keys, count); break;
+	case IL2CPP_SORTKEY_U1: SortKeys<uint8_t>(keys, count); break;
+	case IL2CPP_SORTKEY_I2: SortKeys<int16_t>(keys, count); break;
+	case IL2CPP_SORTKEY_U2: SortKeys<uint16_t>(keys, count); break;
+	case IL2CPP_SORTKEY_I4: SortKeys<int32_t>(keys, count); break;
+	case IL2CPP_SORTKEY_U4: SortKeys<uint32_t>(keys, count); break;
+	case IL2CPP_SORTKEY_I8: SortKeys<int64_t>(keys, count); break;
+	case IL2CPP_SORTKEY_U8: SortKeys<uint64_t>(keys, count); break;
+	case IL2CPP_SORTKEY_R4: SortKeys<float>(keys, count); break;
+	case IL2CPP_SORTKEY_R8: SortKeys<double>(keys, count); break;
+	default: IL2CPP_TRAP;
+	}
+}
+
+void il2cpp_Array__SortItems(void* keys, uint32_t keyKind, void* items, uint32_t itemSize, uint32_t count)
+{
+	if (count < 2)
+		return;
+
+	switch (keyKind)
+	{
+	case IL2CPP_SORTKEY_I1: SortKeysItems<int8_t>(keys, items, itemSize, count); break;
+	case IL2CPP_SORTKEY_U1: SortKeysItems<uint8_t>(keys, items, itemSize, count); break;
+	case IL2CPP_SORTKEY_I2: SortKeysItems<int16_t>(keys, items, itemSize, count); break;
+	case IL2CPP_SORTKEY_U2: SortKeysItems<uint16_t>(keys, items, itemSize, count); break;
+	case IL2CPP_SORTKEY_I4: SortKeysItems<int32_t>(keys, items, itemSize, count); break;
+	case IL2CPP_SORTKEY_U4: SortKeysItems<uint32_t>(keys, items, itemSize, count); break;
+	case IL2CPP_SORTKEY_I8: SortKeysItems<int64_t>(keys, items, itemSize, count); break;
+	case IL2CPP_SORTKEY_U8: SortKeysItems<uint64_t>(keys, items, itemSize, count); break;
+	case IL2CPP_SORTKEY_R4: SortKeysItems<float>(keys, items, itemSize, count); break;
+	case IL2CPP_SORTKEY_R8: SortKeysItems<double>(keys, items, itemSize, count); break;
+	default: IL2CPP_TRAP;
+	}
+}
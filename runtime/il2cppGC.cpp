@@ -91,11 +91,26 @@ void* il2cpp_GC_AllocAtomic(uintptr_t sz)
 	return ptr;
 }
 
+void* il2cpp_GC_AllocUncollectable(uintptr_t sz)
+{
+	return GC_MALLOC_UNCOLLECTABLE(sz);
+}
+
+void il2cpp_GC_Free(void* ptr)
+{
+	GC_FREE(ptr);
+}
+
 void il2cpp_GC_AddRoots(void* low, void* high)
 {
 	GC_add_roots(low, high);
 }
 
+void il2cpp_GC_RemoveRoots(void* low, void* high)
+{
+	GC_remove_roots(low, high);
+}
+
 bool il2cpp_GC_RegisterThread()
 {
 #if defined(GC_THREADS)
@@ -108,6 +123,10 @@ bool il2cpp_GC_RegisterThread()
 	res = GC_register_my_thread(&sb);
 	if ((res != GC_SUCCESS) && (res != GC_DUPLICATE))
 		return false;
+
+	// 线程静态块不在栈上, 需要单独注册
+	if (res == GC_SUCCESS)
+		il2cpp_ThreadStatics__Register(1);
 	return true;
 #else
 	return false;
@@ -117,6 +136,7 @@ bool il2cpp_GC_RegisterThread()
 bool il2cpp_GC_UnregisterThread()
 {
 #if defined(GC_THREADS)
+	il2cpp_ThreadStatics__Register(0);
 	int res = GC_unregister_my_thread();
 	return res == GC_SUCCESS;
 #else
@@ -135,6 +155,19 @@ void il2cpp_GC_RegisterFinalizer(cls_Object* obj, IL2CPP_FINALIZER_FUNC finalize
 	GC_REGISTER_FINALIZER_NO_ORDER(obj, &FinalizerCallback, (void*)finalizer, nullptr, nullptr);
 }
 
+IL2CPP_FINALIZER_FUNC il2cpp_GC_UnregisterFinalizer(cls_Object* obj)
+{
+	GC_finalization_proc oldProc = nullptr;
+	void* oldData = nullptr;
+	GC_REGISTER_FINALIZER_NO_ORDER(obj, nullptr, nullptr, &oldProc, &oldData);
+	return oldProc ? (IL2CPP_FINALIZER_FUNC)oldData : nullptr;
+}
+
+uintptr_t il2cpp_GC_GetSize(void* ptr)
+{
+	return GC_size(ptr);
+}
+
 void il2cpp_GC_Collect()
 {
 	GC_gcollect();
@@ -0,0 +1,978 @@
+﻿#include "il2cpp.h"
+#include <string.h>
+
+#if defined(IL2CPP_X86)
+#include <immintrin.h>
+#endif
+
+// 哈希算法必须在各个实现之间保持一致, 编译器预计算的哈希也依赖于此
+#define HASH_SEED		0x14AE055Cu
+#define HASH_LANE_MUL	0x9E3779B9u
+#define HASH_TAIL_MUL	0x85EBCA6Bu
+
+static inline uint32_t HashFinalize(uint32_t h)
+{
+	h ^= h >> 16;
+	h *= 0x85EBCA6Bu;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35u;
+	h ^= h >> 16;
+	return h;
+}
+
+static inline uint32_t HashLanesAndTail(const uint32_t* lanes, bool hasBlock, const uint16_t* str, size_t remain, uint32_t len)
+{
+	uint32_t h = HASH_SEED ^ len;
+	if (hasBlock)
+	{
+		for (size_t i = 0; i < 8; ++i)
+			h = (h ^ lanes[i]) * HASH_LANE_MUL;
+	}
+
+	// 每两个字符组成一个 32 位字
+	size_t i = 0;
+	for (; i + 2 <= remain; i += 2)
+	{
+		uint32_t w = (uint32_t)str[i] | ((uint32_t)str[i + 1] << 16);
+		h = (h ^ w) * HASH_TAIL_MUL;
+	}
+	if (i < remain)
+		h = (h ^ str[i]) * HASH_TAIL_MUL;
+
+	return HashFinalize(h);
+}
+
+// 8 个 32 位通道, 每个块 16 个字符
+static int32_t HashString_Scalar(const uint16_t* str, int32_t len)
+{
+	const size_t szLen = static_cast<size_t>(len);
+	const size_t blocks = szLen / 16;
+
+	uint32_t lanes[8];
+	for (uint32_t i = 0; i < 8; ++i)
+		lanes[i] = HASH_SEED ^ (i * HASH_LANE_MUL);
+
+	for (size_t b = 0; b < blocks; ++b)
+	{
+		const uint16_t* p = str + b * 16;
+		for (size_t i = 0; i < 8; ++i)
+		{
+			uint32_t w = (uint32_t)p[i * 2] | ((uint32_t)p[i * 2 + 1] << 16);
+			lanes[i] = (lanes[i] + (lanes[i] << 5)) ^ w;
+		}
+	}
+
+	return (int32_t)HashLanesAndTail(lanes, blocks != 0, str + blocks * 16, szLen % 16, (uint32_t)len);
+}
+
+static bool StringEquals_Scalar(const uint16_t* lhs, const uint16_t* rhs, int32_t len)
+{
+	return IL2CPP_MEMCMP(lhs, rhs, sizeof(uint16_t) * len) == 0;
+}
+
+static int32_t StringCompareOrdinal_Scalar(const uint16_t* lhs, int32_t lhsLen, const uint16_t* rhs, int32_t rhsLen)
+{
+	int32_t minLen = il2cpp_Min(lhsLen, rhsLen);
+	for (int32_t i = 0; i < minLen; ++i)
+	{
+		if (lhs[i] != rhs[i])
+			return (int32_t)lhs[i] - (int32_t)rhs[i];
+	}
+	return lhsLen - rhsLen;
+}
+
+static int32_t StringIndexOf_Scalar(const uint16_t* str, int32_t len, uint16_t ch)
+{
+	for (int32_t i = 0; i < len; ++i)
+	{
+		if (str[i] == ch)
+			return i;
+	}
+	return -1;
+}
+
+static int32_t AsciiPrefix8_Scalar(const uint8_t* src, int32_t len)
+{
+	int32_t i = 0;
+	while (i < len && src[i] < 0x80)
+		++i;
+	return i;
+}
+
+static int32_t AsciiPrefix16_Scalar(const uint16_t* src, int32_t len)
+{
+	int32_t i = 0;
+	while (i < len && src[i] < 0x80)
+		++i;
+	return i;
+}
+
+static int32_t WidenAscii_Scalar(const uint8_t* src, uint16_t* dst, int32_t len)
+{
+	int32_t i = 0;
+	for (; i < len && src[i] < 0x80; ++i)
+		dst[i] = src[i];
+	return i;
+}
+
+static int32_t NarrowAscii_Scalar(const uint16_t* src, uint8_t* dst, int32_t len)
+{
+	int32_t i = 0;
+	for (; i < len && src[i] < 0x80; ++i)
+		dst[i] = (uint8_t)src[i];
+	return i;
+}
+
+#if defined(IL2CPP_X86)
+IL2CPP_TARGET("sse2")
+static int32_t HashString_SSE2(const uint16_t* str, int32_t len)
+{
+	const size_t szLen = static_cast<size_t>(len);
+	const size_t blocks = szLen / 16;
+
+	alignas(16) uint32_t lanes[8];
+	for (uint32_t i = 0; i < 8; ++i)
+		lanes[i] = HASH_SEED ^ (i * HASH_LANE_MUL);
+
+	if (blocks)
+	{
+		__m128i lo = _mm_load_si128((const __m128i*)lanes);
+		__m128i hi = _mm_load_si128((const __m128i*)lanes + 1);
+		for (size_t b = 0; b < blocks; ++b)
+		{
+			const __m128i* p = (const __m128i*)(str + b * 16);
+			lo = _mm_xor_si128(_mm_add_epi32(lo, _mm_slli_epi32(lo, 5)), _mm_loadu_si128(p));
+			hi = _mm_xor_si128(_mm_add_epi32(hi, _mm_slli_epi32(hi, 5)), _mm_loadu_si128(p + 1));
+		}
+		_mm_store_si128((__m128i*)lanes, lo);
+		_mm_store_si128((__m128i*)lanes + 1, hi);
+	}
+
+	return (int32_t)HashLanesAndTail(lanes, blocks != 0, str + blocks * 16, szLen % 16, (uint32_t)len);
+}
+
+IL2CPP_TARGET("avx2")
+static int32_t HashString_AVX2(const uint16_t* str, int32_t len)
+{
+	const size_t szLen = static_cast<size_t>(len);
+	const size_t blocks = szLen / 16;
+
+	alignas(32) uint32_t lanes[8];
+	for (uint32_t i = 0; i < 8; ++i)
+		lanes[i] = HASH_SEED ^ (i * HASH_LANE_MUL);
+
+	if (blocks)
+	{
+		__m256i acc = _mm256_load_si256((const __m256i*)lanes);
+		for (size_t b = 0; b < blocks; ++b)
+		{
+			__m256i w = _mm256_loadu_si256((const __m256i*)(str + b * 16));
+			acc = _mm256_xor_si256(_mm256_add_epi32(acc, _mm256_slli_epi32(acc, 5)), w);
+		}
+		_mm256_store_si256((__m256i*)lanes, acc);
+	}
+
+	return (int32_t)HashLanesAndTail(lanes, blocks != 0, str + blocks * 16, szLen % 16, (uint32_t)len);
+}
+
+IL2CPP_TARGET("sse2")
+static bool StringEquals_SSE2(const uint16_t* lhs, const uint16_t* rhs, int32_t len)
+{
+	if (len < 8)
+		return StringEquals_Scalar(lhs, rhs, len);
+
+	// 最后一块与前面的块重叠, 避免标量尾部循环
+	const int32_t last = len - 8;
+	for (int32_t i = 0; i < last; i += 8)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i*)(lhs + i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(rhs + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF)
+			return false;
+	}
+	__m128i a = _mm_loadu_si128((const __m128i*)(lhs + last));
+	__m128i b = _mm_loadu_si128((const __m128i*)(rhs + last));
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF;
+}
+
+IL2CPP_TARGET("avx2")
+static bool StringEquals_AVX2(const uint16_t* lhs, const uint16_t* rhs, int32_t len)
+{
+	if (len < 16)
+		return StringEquals_SSE2(lhs, rhs, len);
+
+	const int32_t last = len - 16;
+	for (int32_t i = 0; i < last; i += 16)
+	{
+		__m256i a = _mm256_loadu_si256((const __m256i*)(lhs + i));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(rhs + i));
+		if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) != 0xFFFFFFFF)
+			return false;
+	}
+	__m256i a = _mm256_loadu_si256((const __m256i*)(lhs + last));
+	__m256i b = _mm256_loadu_si256((const __m256i*)(rhs + last));
+	return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) == 0xFFFFFFFF;
+}
+
+IL2CPP_TARGET("sse2")
+static int32_t StringCompareOrdinal_SSE2(const uint16_t* lhs, int32_t lhsLen, const uint16_t* rhs, int32_t rhsLen)
+{
+	int32_t minLen = il2cpp_Min(lhsLen, rhsLen);
+	int32_t i = 0;
+	for (; i + 8 <= minLen; i += 8)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i*)(lhs + i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(rhs + i));
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi16(a, b)) ^ 0xFFFF;
+		if (mask)
+		{
+			int32_t idx = i + (int32_t)(il2cpp_Ctz32(mask) >> 1);
+			return (int32_t)lhs[idx] - (int32_t)rhs[idx];
+		}
+	}
+	for (; i < minLen; ++i)
+	{
+		if (lhs[i] != rhs[i])
+			return (int32_t)lhs[i] - (int32_t)rhs[i];
+	}
+	return lhsLen - rhsLen;
+}
+
+IL2CPP_TARGET("avx2")
+static int32_t StringCompareOrdinal_AVX2(const uint16_t* lhs, int32_t lhsLen, const uint16_t* rhs, int32_t rhsLen)
+{
+	int32_t minLen = il2cpp_Min(lhsLen, rhsLen);
+	int32_t i = 0;
+	for (; i + 16 <= minLen; i += 16)
+	{
+		__m256i a = _mm256_loadu_si256((const __m256i*)(lhs + i));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(rhs + i));
+		uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b));
+		if (mask)
+		{
+			int32_t idx = i + (int32_t)(il2cpp_Ctz32(mask) >> 1);
+			return (int32_t)lhs[idx] - (int32_t)rhs[idx];
+		}
+	}
+	return StringCompareOrdinal_SSE2(lhs + i, lhsLen - i, rhs + i, rhsLen - i);
+}
+
+IL2CPP_TARGET("sse2")
+static int32_t StringIndexOf_SSE2(const uint16_t* str, int32_t len, uint16_t ch)
+{
+	if (len < 8)
+		return StringIndexOf_Scalar(str, len, ch);
+
+	const __m128i vch = _mm_set1_epi16((short)ch);
+	const int32_t last = len - 8;
+	for (int32_t i = 0; i < last; i += 8)
+	{
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(str + i)), vch));
+		if (mask)
+			return i + (int32_t)(il2cpp_Ctz32(mask) >> 1);
+	}
+	// 重叠部分已确认不包含目标字符
+	uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(str + last)), vch));
+	if (mask)
+		return last + (int32_t)(il2cpp_Ctz32(mask) >> 1);
+	return -1;
+}
+
+IL2CPP_TARGET("avx2")
+static int32_t StringIndexOf_AVX2(const uint16_t* str, int32_t len, uint16_t ch)
+{
+	if (len < 16)
+		return StringIndexOf_SSE2(str, len, ch);
+
+	const __m256i vch = _mm256_set1_epi16((short)ch);
+	const int32_t last = len - 16;
+	for (int32_t i = 0; i < last; i += 16)
+	{
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*)(str + i)), vch));
+		if (mask)
+			return i + (int32_t)(il2cpp_Ctz32(mask) >> 1);
+	}
+	uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*)(str + last)), vch));
+	if (mask)
+		return last + (int32_t)(il2cpp_Ctz32(mask) >> 1);
+	return -1;
+}
+
+IL2CPP_TARGET("sse2")
+static int32_t AsciiPrefix8_SSE2(const uint8_t* src, int32_t len)
+{
+	int32_t i = 0;
+	for (; i + 16 <= len; i += 16)
+	{
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(src + i)));
+		if (mask)
+			return i + (int32_t)il2cpp_Ctz32(mask);
+	}
+	return i + AsciiPrefix8_Scalar(src + i, len - i);
+}
+
+IL2CPP_TARGET("avx2")
+static int32_t AsciiPrefix8_AVX2(const uint8_t* src, int32_t len)
+{
+	int32_t i = 0;
+	for (; i + 32 <= len; i += 32)
+	{
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(src + i)));
+		if (mask)
+			return i + (int32_t)il2cpp_Ctz32(mask);
+	}
+	return i + AsciiPrefix8_SSE2(src + i, len - i);
+}
+
+// 非 ASCII 字符的掩码, 每个字符对应 movemask 的两位
+IL2CPP_TARGET("sse2")
+static inline uint32_t NonAsciiMask16_SSE2(__m128i v)
+{
+	const __m128i hiMask = _mm_set1_epi16((short)0xFF80);
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, hiMask), _mm_setzero_si128())) ^ 0xFFFF;
+}
+
+IL2CPP_TARGET("sse2")
+static int32_t AsciiPrefix16_SSE2(const uint16_t* src, int32_t len)
+{
+	int32_t i = 0;
+	for (; i + 8 <= len; i += 8)
+	{
+		uint32_t mask = NonAsciiMask16_SSE2(_mm_loadu_si128((const __m128i*)(src + i)));
+		if (mask)
+			return i + (int32_t)(il2cpp_Ctz32(mask) >> 1);
+	}
+	return i + AsciiPrefix16_Scalar(src + i, len - i);
+}
+
+IL2CPP_TARGET("avx2")
+static int32_t AsciiPrefix16_AVX2(const uint16_t* src, int32_t len)
+{
+	const __m256i hiMask = _mm256_set1_epi16((short)0xFF80);
+	int32_t i = 0;
+	for (; i + 16 <= len; i += 16)
+	{
+		__m256i v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(src + i)), hiMask);
+		uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi16(v, _mm256_setzero_si256()));
+		if (mask)
+			return i + (int32_t)(il2cpp_Ctz32(mask) >> 1);
+	}
+	return i + AsciiPrefix16_SSE2(src + i, len - i);
+}
+
+IL2CPP_TARGET("sse2")
+static int32_t WidenAscii_SSE2(const uint8_t* src, uint16_t* dst, int32_t len)
+{
+	const __m128i zero = _mm_setzero_si128();
+	int32_t i = 0;
+	for (; i + 16 <= len; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		if (_mm_movemask_epi8(v))
+			break;
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(v, zero));
+		_mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpackhi_epi8(v, zero));
+	}
+	return i + WidenAscii_Scalar(src + i, dst + i, len - i);
+}
+
+IL2CPP_TARGET("avx2")
+static int32_t WidenAscii_AVX2(const uint8_t* src, uint16_t* dst, int32_t len)
+{
+	int32_t i = 0;
+	for (; i + 32 <= len; i += 32)
+	{
+		__m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 16));
+		if (_mm_movemask_epi8(_mm_or_si128(lo, hi)))
+			break;
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_cvtepu8_epi16(lo));
+		_mm256_storeu_si256((__m256i*)(dst + i + 16), _mm256_cvtepu8_epi16(hi));
+	}
+	return i + WidenAscii_SSE2(src + i, dst + i, len - i);
+}
+
+IL2CPP_TARGET("sse2")
+static int32_t NarrowAscii_SSE2(const uint16_t* src, uint8_t* dst, int32_t len)
+{
+	int32_t i = 0;
+	for (; i + 16 <= len; i += 16)
+	{
+		__m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 8));
+		if (NonAsciiMask16_SSE2(_mm_or_si128(lo, hi)))
+			break;
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+	}
+	return i + NarrowAscii_Scalar(src + i, dst + i, len - i);
+}
+
+IL2CPP_TARGET("avx2")
+static int32_t NarrowAscii_AVX2(const uint16_t* src, uint8_t* dst, int32_t len)
+{
+	const __m256i hiMask = _mm256_set1_epi16((short)0xFF80);
+	int32_t i = 0;
+	for (; i + 32 <= len; i += 32)
+	{
+		__m256i lo = _mm256_loadu_si256((const __m256i*)(src + i));
+		__m256i hi = _mm256_loadu_si256((const __m256i*)(src + i + 16));
+		if (!_mm256_testz_si256(_mm256_or_si256(lo, hi), hiMask))
+			break;
+		// packus 按 128 位通道交错, 需要重新排列
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+		_mm256_storeu_si256((__m256i*)(dst + i), packed);
+	}
+	return i + NarrowAscii_SSE2(src + i, dst + i, len - i);
+}
+#endif
+
+static int32_t(*s_HashString)(const uint16_t*, int32_t) = &HashString_Scalar;
+static bool(*s_StringEquals)(const uint16_t*, const uint16_t*, int32_t) = &StringEquals_Scalar;
+static int32_t(*s_StringCompareOrdinal)(const uint16_t*, int32_t, const uint16_t*, int32_t) = &StringCompareOrdinal_Scalar;
+static int32_t(*s_StringIndexOf)(const uint16_t*, int32_t, uint16_t) = &StringIndexOf_Scalar;
+static int32_t(*s_AsciiPrefix8)(const uint8_t*, int32_t) = &AsciiPrefix8_Scalar;
+static int32_t(*s_AsciiPrefix16)(const uint16_t*, int32_t) = &AsciiPrefix16_Scalar;
+static int32_t(*s_WidenAscii)(const uint8_t*, uint16_t*, int32_t) = &WidenAscii_Scalar;
+static int32_t(*s_NarrowAscii)(const uint16_t*, uint8_t*, int32_t) = &NarrowAscii_Scalar;
+
+void il2cpp_String__InitKernels()
+{
+#if defined(IL2CPP_X86)
+	if (il2cpp_CPUFeatures & IL2CPP_CPU_AVX2)
+	{
+		s_HashString = &HashString_AVX2;
+		s_StringEquals = &StringEquals_AVX2;
+		s_StringCompareOrdinal = &StringCompareOrdinal_AVX2;
+		s_StringIndexOf = &StringIndexOf_AVX2;
+		s_AsciiPrefix8 = &AsciiPrefix8_AVX2;
+		s_AsciiPrefix16 = &AsciiPrefix16_AVX2;
+		s_WidenAscii = &WidenAscii_AVX2;
+		s_NarrowAscii = &NarrowAscii_AVX2;
+	}
+	else if (il2cpp_CPUFeatures & IL2CPP_CPU_SSE2)
+	{
+		s_HashString = &HashString_SSE2;
+		s_StringEquals = &StringEquals_SSE2;
+		s_StringCompareOrdinal = &StringCompareOrdinal_SSE2;
+		s_StringIndexOf = &StringIndexOf_SSE2;
+		s_AsciiPrefix8 = &AsciiPrefix8_SSE2;
+		s_AsciiPrefix16 = &AsciiPrefix16_SSE2;
+		s_WidenAscii = &WidenAscii_SSE2;
+		s_NarrowAscii = &NarrowAscii_SSE2;
+	}
+#endif
+}
+
+int32_t il2cpp_HashString(const uint16_t* str, int32_t len)
+{
+	return s_HashString(str, len);
+}
+
+bool il2cpp_String__Equals(const uint16_t* lhs, const uint16_t* rhs, int32_t len)
+{
+	return s_StringEquals(lhs, rhs, len);
+}
+
+int32_t il2cpp_String__CompareOrdinal(const uint16_t* lhs, int32_t lhsLen, const uint16_t* rhs, int32_t rhsLen)
+{
+	return s_StringCompareOrdinal(lhs, lhsLen, rhs, rhsLen);
+}
+
+int32_t il2cpp_String__IndexOf(const uint16_t* str, int32_t len, uint16_t ch)
+{
+	return s_StringIndexOf(str, len, ch);
+}
+
+// 非法序列的解码结果, 区别于输入中真实的 U+FFFD
+static const uint32_t kInvalidCodePoint = 0xFFFFFFFF;
+
+// 解码一个 UTF-8 码点, 非法序列按最大子部分跳过
+static inline uint32_t DecodeUTF8(const uint8_t* src, const uint8_t* end, int32_t& len)
+{
+	uint32_t c = src[0];
+	len = 1;
+	if (c < 0x80)
+		return c;
+
+	uint32_t need;
+	uint32_t lo = 0x80, hi = 0xBF;
+	if (c >= 0xC2 && c <= 0xDF)
+	{
+		need = 1;
+		c &= 0x1F;
+	}
+	else if (c >= 0xE0 && c <= 0xEF)
+	{
+		need = 2;
+		if (c == 0xE0)
+			lo = 0xA0;
+		else if (c == 0xED)
+			hi = 0x9F;
+		c &= 0x0F;
+	}
+	else if (c >= 0xF0 && c <= 0xF4)
+	{
+		need = 3;
+		if (c == 0xF0)
+			lo = 0x90;
+		else if (c == 0xF4)
+			hi = 0x8F;
+		c &= 0x07;
+	}
+	else
+		return kInvalidCodePoint;
+
+	for (uint32_t i = 0; i < need; ++i)
+	{
+		if (src + len >= end)
+			return kInvalidCodePoint;
+		uint32_t b = src[len];
+		if (b < lo || b > hi)
+			return kInvalidCodePoint;
+		lo = 0x80;
+		hi = 0xBF;
+		c = (c << 6) | (b & 0x3F);
+		++len;
+	}
+	return c;
+}
+
+// 解码一个 UTF-16 码点, 孤立的代理项视为非法
+static inline uint32_t DecodeUTF16(const uint16_t* src, const uint16_t* end, int32_t& len)
+{
+	uint32_t c = src[0];
+	len = 1;
+	if (c < 0xD800 || c > 0xDFFF)
+		return c;
+	if (c <= 0xDBFF && src + 1 < end && src[1] >= 0xDC00 && src[1] <= 0xDFFF)
+	{
+		len = 2;
+		return 0x10000 + ((c - 0xD800) << 10) + (src[1] - 0xDC00);
+	}
+	return kInvalidCodePoint;
+}
+
+// 严格模式下遇到非法序列返回 -1, 否则替换为 U+FFFD
+#define UTF_CHECK_INVALID(_cp) \
+	if (IL2CPP_UNLIKELY(_cp == kInvalidCodePoint)) \
+	{ \
+		if (isStrict) \
+			return -1; \
+		_cp = 0xFFFD; \
+	}
+
+int32_t il2cpp_UTF8__GetCharCount(const uint8_t* src, int32_t len, bool isStrict)
+{
+	const uint8_t* end = src + len;
+	int32_t count = 0;
+	while (src < end)
+	{
+		if (*src < 0x80)
+		{
+			int32_t n = s_AsciiPrefix8(src, (int32_t)(end - src));
+			src += n;
+			count += n;
+			if (src >= end)
+				break;
+		}
+
+		int32_t sz;
+		uint32_t cp = DecodeUTF8(src, end, sz);
+		UTF_CHECK_INVALID(cp);
+		src += sz;
+		count += cp >= 0x10000 ? 2 : 1;
+	}
+	return count;
+}
+
+int32_t il2cpp_UTF8__GetChars(const uint8_t* src, int32_t len, uint16_t* dst, int32_t dstLen, bool isStrict)
+{
+	const uint8_t* end = src + len;
+	uint16_t* dstBegin = dst;
+	uint16_t* dstEnd = dst + dstLen;
+	while (src < end)
+	{
+		if (*src < 0x80)
+		{
+			int32_t n = s_WidenAscii(src, dst, (int32_t)il2cpp_Min(end - src, dstEnd - dst));
+			src += n;
+			dst += n;
+			if (src >= end)
+				break;
+		}
+
+		int32_t sz;
+		uint32_t cp = DecodeUTF8(src, end, sz);
+		UTF_CHECK_INVALID(cp);
+		if (cp >= 0x10000)
+		{
+			if (dstEnd - dst < 2)
+				return -1;
+			cp -= 0x10000;
+			dst[0] = (uint16_t)(0xD800 + (cp >> 10));
+			dst[1] = (uint16_t)(0xDC00 + (cp & 0x3FF));
+			dst += 2;
+		}
+		else
+		{
+			if (dst >= dstEnd)
+				return -1;
+			*dst++ = (uint16_t)cp;
+		}
+		src += sz;
+	}
+	return (int32_t)(dst - dstBegin);
+}
+
+int32_t il2cpp_UTF8__GetByteCount(const uint16_t* src, int32_t len, bool isStrict)
+{
+	const uint16_t* end = src + len;
+	int32_t count = 0;
+	while (src < end)
+	{
+		if (*src < 0x80)
+		{
+			int32_t n = s_AsciiPrefix16(src, (int32_t)(end - src));
+			src += n;
+			count += n;
+			if (src >= end)
+				break;
+		}
+
+		int32_t sz;
+		uint32_t cp = DecodeUTF16(src, end, sz);
+		UTF_CHECK_INVALID(cp);
+		src += sz;
+		count += cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+	}
+	return count;
+}
+
+int32_t il2cpp_UTF8__GetBytes(const uint16_t* src, int32_t len, uint8_t* dst, int32_t dstLen, bool isStrict)
+{
+	const uint16_t* end = src + len;
+	uint8_t* dstBegin = dst;
+	uint8_t* dstEnd = dst + dstLen;
+	while (src < end)
+	{
+		if (*src < 0x80)
+		{
+			int32_t n = s_NarrowAscii(src, dst, (int32_t)il2cpp_Min(end - src, dstEnd - dst));
+			src += n;
+			dst += n;
+			if (src >= end)
+				break;
+		}
+
+		int32_t sz;
+		uint32_t cp = DecodeUTF16(src, end, sz);
+		UTF_CHECK_INVALID(cp);
+		if (cp < 0x80)
+		{
+			if (dst >= dstEnd)
+				return -1;
+			*dst++ = (uint8_t)cp;
+		}
+		else if (cp < 0x800)
+		{
+			if (dstEnd - dst < 2)
+				return -1;
+			dst[0] = (uint8_t)(0xC0 | (cp >> 6));
+			dst[1] = (uint8_t)(0x80 | (cp & 0x3F));
+			dst += 2;
+		}
+		else if (cp < 0x10000)
+		{
+			if (dstEnd - dst < 3)
+				return -1;
+			dst[0] = (uint8_t)(0xE0 | (cp >> 12));
+			dst[1] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+			dst[2] = (uint8_t)(0x80 | (cp & 0x3F));
+			dst += 3;
+		}
+		else
+		{
+			if (dstEnd - dst < 4)
+				return -1;
+			dst[0] = (uint8_t)(0xF0 | (cp >> 18));
+			dst[1] = (uint8_t)(0x80 | ((cp >> 12) & 0x3F));
+			dst[2] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+			dst[3] = (uint8_t)(0x80 | (cp & 0x3F));
+			dst += 4;
+		}
+		src += sz;
+	}
+	return (int32_t)(dst - dstBegin);
+}
+
+#undef UTF_CHECK_INVALID
+
+int32_t il2cpp_StrLen16(const uint16_t* str)
+{
+	const uint16_t* p = str;
+	while (*p)
+		++p;
+	return (int32_t)(p - str);
+}
+
+int32_t il2cpp_ToUTF16Len(const int8_t* str)
+{
+	return il2cpp_UTF8__GetCharCount((const uint8_t*)str, (int32_t)strlen((const char*)str), false);
+}
+
+int32_t il2cpp_ToUTF16Len(const int8_t* str, int32_t len)
+{
+	return il2cpp_UTF8__GetCharCount((const uint8_t*)str, len, false);
+}
+
+static il2cppString* AllocString(uint32_t typeID, int32_t len)
+{
+	il2cppString* str = (il2cppString*)il2cpp_New(sizeof(il2cppString) + sizeof(uint16_t) * len, typeID, 1);
+	str->Length = len;
+	return str;
+}
+
+// 与 String.Concat 语义一致: 空串与 null 跳过, 仅剩一个非空串时直接返回它
+static il2cppString* ConcatImpl(uint32_t typeID, il2cppString* empty, il2cppString* const* strs, uintptr_t count)
+{
+	int64_t total = 0;
+	uintptr_t nonEmpty = 0;
+	il2cppString* last = nullptr;
+	for (uintptr_t i = 0; i < count; ++i)
+	{
+		if (strs[i] && strs[i]->Length)
+		{
+			total += strs[i]->Length;
+			last = strs[i];
+			++nonEmpty;
+		}
+	}
+
+	if (nonEmpty == 0)
+		return empty;
+	if (nonEmpty == 1)
+		return last;
+	if (total > 0x3FFFFFF0)
+		IL2CPP_TRAP;
+
+	il2cppString* result = AllocString(typeID, (int32_t)total);
+	uint16_t* dst = result->Chars;
+	for (uintptr_t i = 0; i < count; ++i)
+	{
+		if (strs[i])
+		{
+			memcpy(dst, strs[i]->Chars, sizeof(uint16_t) * strs[i]->Length);
+			dst += strs[i]->Length;
+		}
+	}
+	return result;
+}
+
+il2cppString* il2cpp_String__Concat(uint32_t typeID, il2cppString* empty, il2cppString* s0, il2cppString* s1)
+{
+	il2cppString* const strs[] = { s0, s1 };
+	return ConcatImpl(typeID, empty, strs, 2);
+}
+
+il2cppString* il2cpp_String__Concat(uint32_t typeID, il2cppString* empty, il2cppString* s0, il2cppString* s1, il2cppString* s2)
+{
+	il2cppString* const strs[] = { s0, s1, s2 };
+	return ConcatImpl(typeID, empty, strs, 3);
+}
+
+il2cppString* il2cpp_String__Concat(uint32_t typeID, il2cppString* empty, il2cppString* s0, il2cppString* s1, il2cppString* s2, il2cppString* s3)
+{
+	il2cppString* const strs[] = { s0, s1, s2, s3 };
+	return ConcatImpl(typeID, empty, strs, 4);
+}
+
+il2cppString* il2cpp_String__ConcatArray(uint32_t typeID, il2cppString* empty, il2cppString* const* strs, uint32_t count)
+{
+	return ConcatImpl(typeID, empty, strs, count);
+}
+
+static const char s_DigitPairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+// 从缓冲区尾部向前写入十进制数字, 返回写入的位数
+static int32_t FormatDigits(uint64_t val, uint16_t* end)
+{
+	uint16_t* p = end;
+	while (val >= 100)
+	{
+		uint32_t pair = (uint32_t)(val % 100) * 2;
+		val /= 100;
+		*--p = s_DigitPairs[pair + 1];
+		*--p = s_DigitPairs[pair];
+	}
+	if (val >= 10)
+	{
+		uint32_t pair = (uint32_t)val * 2;
+		*--p = s_DigitPairs[pair + 1];
+		*--p = s_DigitPairs[pair];
+	}
+	else
+		*--p = (uint16_t)('0' + val);
+	return (int32_t)(end - p);
+}
+
+il2cppString* il2cpp_String__FromInt64(int64_t val, uint32_t typeID)
+{
+	uint16_t buf[20];
+	uint16_t* end = buf + 20;
+	uint64_t absVal = val < 0 ? 0 - (uint64_t)val : (uint64_t)val;
+	int32_t len = FormatDigits(absVal, end);
+	if (val < 0)
+		buf[20 - ++len] = '-';
+
+	il2cppString* str = AllocString(typeID, len);
+	memcpy(str->Chars, end - len, sizeof(uint16_t) * len);
+	return str;
+}
+
+il2cppString* il2cpp_String__FromUInt64(uint64_t val, uint32_t typeID)
+{
+	uint16_t buf[20];
+	uint16_t* end = buf + 20;
+	int32_t len = FormatDigits(val, end);
+
+	il2cppString* str = AllocString(typeID, len);
+	memcpy(str->Chars, end - len, sizeof(uint16_t) * len);
+	return str;
+}
+
+static inline uint32_t LiteralSlot(uint32_t hash, uint32_t disp)
+{
+	return HashFinalize(hash ^ (disp * HASH_LANE_MUL));
+}
+
+static inline bool IsSameString(const il2cppString* lhs, const il2cppString* rhs)
+{
+	return lhs->Length == rhs->Length &&
+		il2cpp_String__Equals(lhs->Chars, rhs->Chars, lhs->Length);
+}
+
+static const il2cppLiteralTable* s_LiteralTable;
+
+// 运行时驻留的非字面量字符串, 开放寻址
+static il2cppString** s_InternSlots;
+static uint32_t s_InternCapacity;
+static uint32_t s_InternCount;
+static uint8_t s_InternLock;
+
+void il2cpp_String__RegisterLiterals(const il2cppLiteralTable* table)
+{
+	s_LiteralTable = table;
+}
+
+static il2cppString* FindLiteral(const il2cppString* str, uint32_t hash)
+{
+	const il2cppLiteralTable* table = s_LiteralTable;
+	if (!table)
+		return nullptr;
+
+	uint32_t disp = table->Disps[hash % table->BucketCount];
+	const il2cppString* lit = table->Slots[LiteralSlot(hash, disp) % table->SlotCount];
+	if (lit &&
+		(uint32_t)il2cpp_String__GetHashCode(lit) == hash &&
+		IsSameString(lit, str))
+	{
+		return const_cast<il2cppString*>(lit);
+	}
+
+	for (uint32_t i = 0; i < table->OverflowCount; ++i)
+	{
+		lit = table->Overflows[i];
+		if (IsSameString(lit, str))
+			return const_cast<il2cppString*>(lit);
+	}
+	return nullptr;
+}
+
+static il2cppString* FindInterned(const il2cppString* str, uint32_t hash)
+{
+	if (!s_InternSlots)
+		return nullptr;
+
+	const uint32_t mask = s_InternCapacity - 1;
+	for (uint32_t i = hash & mask; ; i = (i + 1) & mask)
+	{
+		il2cppString* item = s_InternSlots[i];
+		if (!item)
+			return nullptr;
+		if (IsSameString(item, str))
+			return item;
+	}
+}
+
+static void InsertInterned(il2cppString* str, uint32_t hash)
+{
+	if ((s_InternCount + 1) * 2 > s_InternCapacity)
+	{
+		uint32_t newCapacity = s_InternCapacity ? s_InternCapacity * 2 : 64;
+		il2cppString** newSlots = (il2cppString**)il2cpp_GC_Alloc(sizeof(il2cppString*) * newCapacity);
+
+		const uint32_t mask = newCapacity - 1;
+		for (uint32_t i = 0; i < s_InternCapacity; ++i)
+		{
+			il2cppString* item = s_InternSlots[i];
+			if (!item)
+				continue;
+
+			uint32_t idx = (uint32_t)il2cpp_String__GetHashCode(item) & mask;
+			while (newSlots[idx])
+				idx = (idx + 1) & mask;
+			newSlots[idx] = item;
+		}
+
+		if (!s_InternSlots)
+			il2cpp_GC_AddRoots(&s_InternSlots, &s_InternSlots + 1);
+		s_InternSlots = newSlots;
+		s_InternCapacity = newCapacity;
+	}
+
+	const uint32_t mask = s_InternCapacity - 1;
+	uint32_t idx = hash & mask;
+	while (s_InternSlots[idx])
+		idx = (idx + 1) & mask;
+	s_InternSlots[idx] = str;
+	++s_InternCount;
+}
+
+il2cppString* il2cpp_String__Intern(il2cppString* str)
+{
+	uint32_t hash = (uint32_t)il2cpp_String__GetHashCode(str);
+	if (il2cppString* lit = FindLiteral(str, hash))
+		return lit;
+
+	il2cpp_SpinLock(s_InternLock);
+	il2cppString* result = FindInterned(str, hash);
+	if (!result)
+	{
+		InsertInterned(str, hash);
+		result = str;
+	}
+	il2cpp_SpinUnlock(s_InternLock);
+	return result;
+}
+
+il2cppString* il2cpp_String__IsInterned(il2cppString* str)
+{
+	uint32_t hash = (uint32_t)il2cpp_String__GetHashCode(str);
+	if (il2cppString* lit = FindLiteral(str, hash))
+		return lit;
+
+	il2cpp_SpinLock(s_InternLock);
+	il2cppString* result = FindInterned(str, hash);
+	il2cpp_SpinUnlock(s_InternLock);
+	return result;
+}
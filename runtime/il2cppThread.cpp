@@ -0,0 +1,416 @@
+﻿#include "il2cpp.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <limits.h>
+#endif
+
+// 与托管 ThreadState 枚举一致
+enum
+{
+	ThreadState_Running = 0,
+	ThreadState_Background = 4,
+	ThreadState_Unstarted = 8,
+	ThreadState_Stopped = 16,
+};
+
+// 托管线程对象对应的原生状态, 位于不回收的 GC 内存中以保持引用的对象存活
+struct il2cppThread
+{
+	cls_Object* ManagedThread = nullptr;
+	cls_Object* Target = nullptr;
+	void* MethodPtr = nullptr;
+	cls_Object* StartArg = nullptr;
+
+	std::mutex Mutex;
+	std::condition_variable FinishedCond;
+
+	int32_t ManagedID = 0;
+	uint32_t MaxStackSize = 0;
+	bool HasParam = false;
+	bool IsBackground = false;
+	bool IsStarted = false;
+	bool IsFinished = false;
+	bool IsFinalized = false;
+	// 附加到已有的原生线程, 不参与退出等待
+	bool IsAttached = false;
+};
+
+static std::atomic<int32_t> g_ManagedIDCounter(1);
+static uintptr_t g_MainThreadID = 0;
+
+static thread_local il2cppThread* t_CurrentThread = nullptr;
+
+// 进程退出前等待所有前台线程
+static std::mutex g_ForegroundMutex;
+static std::condition_variable g_ForegroundCond;
+static uint32_t g_ForegroundCount = 0;
+
+static il2cppThread* NewThreadState(cls_Object* managedThread)
+{
+	void* mem = il2cpp_GC_AllocUncollectable(sizeof(il2cppThread));
+	il2cppThread* th = new (mem) il2cppThread();
+	th->ManagedThread = managedThread;
+	return th;
+}
+
+static void DeleteThreadState(il2cppThread* th)
+{
+	th->~il2cppThread();
+	il2cpp_GC_Free(th);
+}
+
+static void WaitForegroundThreads()
+{
+	std::unique_lock<std::mutex> lk(g_ForegroundMutex);
+	g_ForegroundCond.wait(lk, [] { return g_ForegroundCount == 0; });
+}
+
+static void LeaveForeground()
+{
+	std::lock_guard<std::mutex> lk(g_ForegroundMutex);
+	if (--g_ForegroundCount == 0)
+		g_ForegroundCond.notify_all();
+}
+
+void il2cpp_Thread__Init()
+{
+	g_MainThreadID = il2cpp_ThreadID();
+	atexit(&WaitForegroundThreads);
+}
+
+// 启动前不持有托管对象, 未启动的线程对象可以被回收并终结
+il2cppThread* il2cpp_Thread__Create(uint8_t hasParam, int32_t maxStackSize)
+{
+	il2cppThread* th = NewThreadState(nullptr);
+	th->HasParam = hasParam != 0;
+	th->MaxStackSize = maxStackSize > 0 ? (uint32_t)maxStackSize : IL2CPP_THREAD_STACK_SIZE;
+	th->ManagedID = ++g_ManagedIDCounter;
+	return th;
+}
+
+il2cppThread* il2cpp_Thread__Attach(cls_Object* managedThread)
+{
+	IL2CPP_ASSERT(t_CurrentThread == nullptr);
+
+	il2cppThread* th = NewThreadState(managedThread);
+	if (il2cpp_ThreadID() == g_MainThreadID)
+		th->ManagedID = 1;
+	else
+	{
+		// 非托管创建的线程也需要能被 GC 扫描
+		il2cpp_GC_RegisterThread();
+		th->ManagedID = ++g_ManagedIDCounter;
+	}
+	th->IsStarted = true;
+	th->IsAttached = true;
+	t_CurrentThread = th;
+	return th;
+}
+
+cls_Object* il2cpp_Thread__GetCurrent()
+{
+	return t_CurrentThread ? t_CurrentThread->ManagedThread : nullptr;
+}
+
+static void RunThread(il2cppThread* th)
+{
+	il2cpp_GC_RegisterThread();
+	t_CurrentThread = th;
+
+	cls_Object* target = th->Target;
+	void* methodPtr = th->MethodPtr;
+	if (th->HasParam)
+	{
+		if (target)
+			((void(*)(cls_Object*, cls_Object*))methodPtr)(target, th->StartArg);
+		else
+			((void(*)(cls_Object*))methodPtr)(th->StartArg);
+	}
+	else
+	{
+		if (target)
+			((void(*)(cls_Object*))methodPtr)(target);
+		else
+			((void(*)())methodPtr)();
+	}
+
+#if defined(IL2CPP_EXCEPTION_STATUS)
+	// 未处理的异常终止进程
+	if (IL2CPP_PENDING_EXCEPTION)
+		IL2CPP_TRAP;
+#endif
+
+	bool isBackground;
+	{
+		std::lock_guard<std::mutex> lk(th->Mutex);
+		// 结束后不再持有托管对象, 线程对象可以被回收并终结
+		th->ManagedThread = nullptr;
+		th->Target = nullptr;
+		th->StartArg = nullptr;
+		th->IsFinished = true;
+		isBackground = th->IsBackground;
+	}
+	th->FinishedCond.notify_all();
+
+	t_CurrentThread = nullptr;
+	il2cpp_GC_UnregisterThread();
+
+	bool isFinalized;
+	{
+		std::lock_guard<std::mutex> lk(th->Mutex);
+		isFinalized = th->IsFinalized;
+	}
+	if (isFinalized)
+		DeleteThreadState(th);
+
+	if (!isBackground)
+		LeaveForeground();
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI ThreadEntry(LPVOID param)
+{
+	RunThread((il2cppThread*)param);
+	return 0;
+}
+#else
+static void* ThreadEntry(void* param)
+{
+	RunThread((il2cppThread*)param);
+	return nullptr;
+}
+#endif
+
+void il2cpp_Thread__Start(il2cppThread* th, cls_Object* managedThread, cls_Object* target, void* methodPtr, cls_Object* startArg)
+{
+	IL2CPP_ASSERT(th && !th->IsStarted);
+	th->IsStarted = true;
+	th->ManagedThread = managedThread;
+	th->Target = target;
+	th->MethodPtr = methodPtr;
+	th->StartArg = startArg;
+
+	if (!th->IsBackground)
+	{
+		std::lock_guard<std::mutex> lk(g_ForegroundMutex);
+		++g_ForegroundCount;
+	}
+
+	bool isOK;
+#if defined(_WIN32)
+	HANDLE handle = CreateThread(nullptr, th->MaxStackSize, &ThreadEntry, th,
+		th->MaxStackSize ? STACK_SIZE_PARAM_IS_A_RESERVATION : 0, nullptr);
+	isOK = handle != nullptr;
+	if (isOK)
+		CloseHandle(handle);
+#else
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	if (th->MaxStackSize)
+	{
+		size_t stackSize = th->MaxStackSize < PTHREAD_STACK_MIN ? PTHREAD_STACK_MIN : th->MaxStackSize;
+		pthread_attr_setstacksize(&attr, stackSize);
+	}
+
+	pthread_t tid;
+	isOK = pthread_create(&tid, &attr, &ThreadEntry, th) == 0;
+	pthread_attr_destroy(&attr);
+#endif
+
+	if (!isOK)
+		IL2CPP_TRAP;
+}
+
+uint8_t il2cpp_Thread__Join(il2cppThread* th, int32_t timeoutMS)
+{
+	IL2CPP_ASSERT(th);
+	std::unique_lock<std::mutex> lk(th->Mutex);
+	if (!th->IsStarted)
+		return 1;
+
+	if (timeoutMS < 0)
+	{
+		th->FinishedCond.wait(lk, [th] { return th->IsFinished; });
+		return 1;
+	}
+	return th->FinishedCond.wait_for(lk, std::chrono::milliseconds(timeoutMS),
+		[th] { return th->IsFinished; }) ? 1 : 0;
+}
+
+void il2cpp_Thread__Sleep(int32_t ms)
+{
+	if (ms <= 0)
+		il2cpp_Yield();
+	else
+		il2cpp_SleepMS((uint32_t)ms);
+}
+
+void il2cpp_Thread__SpinWait(int32_t iterations)
+{
+	for (int32_t i = 0; i < iterations; ++i)
+	{
+#if defined(IL2CPP_X86) && defined(IL2CPP_GNUC_LIKE)
+		__builtin_ia32_pause();
+#elif defined(IL2CPP_X86)
+		_mm_pause();
+#endif
+	}
+}
+
+int32_t il2cpp_Thread__GetManagedID(il2cppThread* th)
+{
+	IL2CPP_ASSERT(th);
+	return th->ManagedID;
+}
+
+uint8_t il2cpp_Thread__IsBackground(il2cppThread* th)
+{
+	IL2CPP_ASSERT(th);
+	std::lock_guard<std::mutex> lk(th->Mutex);
+	return th->IsBackground ? 1 : 0;
+}
+
+void il2cpp_Thread__SetBackground(il2cppThread* th, uint8_t isBackground)
+{
+	IL2CPP_ASSERT(th);
+	bool changed;
+	bool isRunning;
+	{
+		std::lock_guard<std::mutex> lk(th->Mutex);
+		changed = th->IsBackground != (isBackground != 0);
+		isRunning = th->IsStarted && !th->IsFinished;
+		th->IsBackground = isBackground != 0;
+	}
+
+	// 运行中的线程切换前后台时调整退出等待计数
+	if (changed && isRunning && !th->IsAttached)
+	{
+		std::lock_guard<std::mutex> lk(g_ForegroundMutex);
+		if (isBackground)
+		{
+			if (--g_ForegroundCount == 0)
+				g_ForegroundCond.notify_all();
+		}
+		else
+			++g_ForegroundCount;
+	}
+}
+
+int32_t il2cpp_Thread__GetState(il2cppThread* th)
+{
+	IL2CPP_ASSERT(th);
+	std::lock_guard<std::mutex> lk(th->Mutex);
+	int32_t state;
+	if (!th->IsStarted)
+		state = ThreadState_Unstarted;
+	else if (th->IsFinished)
+		state = ThreadState_Stopped;
+	else
+		state = ThreadState_Running;
+	if (th->IsBackground)
+		state |= ThreadState_Background;
+	return state;
+}
+
+void il2cpp_Thread__Finalize(il2cppThread* th)
+{
+	if (!th)
+		return;
+
+	// 线程仍在运行时由其退出时释放
+	bool canDelete;
+	{
+		std::lock_guard<std::mutex> lk(th->Mutex);
+		th->IsFinalized = true;
+		canDelete = !th->IsStarted || th->IsFinished;
+	}
+	if (canDelete)
+		DeleteThreadState(th);
+}
+
+// Monitor 的等待队列, 按对象地址分散到若干槽中
+struct MonitorWaiter
+{
+	void* Object;
+	MonitorWaiter* Next;
+	bool IsSignaled;
+};
+
+struct alignas(64) MonitorSlot
+{
+	std::mutex Mutex;
+	std::condition_variable Cond;
+	MonitorWaiter* Waiters = nullptr;
+};
+
+static MonitorSlot g_MonitorSlots[64];
+
+static MonitorSlot& GetMonitorSlot(void* obj)
+{
+	return g_MonitorSlots[((uintptr_t)obj >> 4) % 64];
+}
+
+uint8_t il2cpp_Monitor__Wait(void* obj, uint8_t& lockFlag, int32_t timeoutMS)
+{
+	MonitorSlot& slot = GetMonitorSlot(obj);
+	MonitorWaiter waiter = { obj, nullptr, false };
+
+	{
+		std::unique_lock<std::mutex> lk(slot.Mutex);
+		// 入队后才释放对象锁, 之后的 Pulse 一定能看到本等待者
+		MonitorWaiter** tail = &slot.Waiters;
+		while (*tail)
+			tail = &(*tail)->Next;
+		*tail = &waiter;
+
+		il2cpp_SpinUnlock(lockFlag);
+
+		if (timeoutMS < 0)
+			slot.Cond.wait(lk, [&waiter] { return waiter.IsSignaled; });
+		else
+			slot.Cond.wait_for(lk, std::chrono::milliseconds(timeoutMS), [&waiter] { return waiter.IsSignaled; });
+
+		for (MonitorWaiter** it = &slot.Waiters; *it; it = &(*it)->Next)
+		{
+			if (*it == &waiter)
+			{
+				*it = waiter.Next;
+				break;
+			}
+		}
+	}
+
+	il2cpp_SpinLock(lockFlag);
+	return waiter.IsSignaled ? 1 : 0;
+}
+
+void il2cpp_Monitor__Pulse(void* obj, uint8_t isAll)
+{
+	MonitorSlot& slot = GetMonitorSlot(obj);
+	bool isNotify = false;
+	{
+		std::lock_guard<std::mutex> lk(slot.Mutex);
+		for (MonitorWaiter* it = slot.Waiters; it; it = it->Next)
+		{
+			if (it->Object == obj && !it->IsSignaled)
+			{
+				it->IsSignaled = true;
+				isNotify = true;
+				if (!isAll)
+					break;
+			}
+		}
+	}
+	// 槽位由多个对象共享, 唤醒全部后由各自的条件过滤
+	if (isNotify)
+		slot.Cond.notify_all();
+}
@@ -0,0 +1,705 @@
+﻿#include "il2cpp.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+#if defined(IL2CPP_THREADPOOL_STATS)
+#include <stdio.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// 工作项, 位于不回收的 GC 内存中以保持引用的对象存活
+struct il2cppWorkItem
+{
+	IL2CPP_WORKITEM_FUNC Func;
+	cls_Object* Object;
+	cls_Object* State;
+	il2cppWorkItem* NextFree;
+#if defined(IL2CPP_THREADPOOL_STATS)
+	int64_t QueuedTime;
+#endif
+};
+
+#if defined(IL2CPP_THREADPOOL_STATS)
+static std::atomic<int64_t> g_StatItems(0);
+static std::atomic<int64_t> g_StatDispatchNS(0);
+static std::atomic<int64_t> g_StatSteals(0);
+static std::atomic<int64_t> g_StatParks(0);
+
+static int64_t StatNow()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void StatReport()
+{
+	int64_t items = g_StatItems.load();
+	if (items == 0)
+		return;
+	fprintf(stderr, "[threadpool] items: %lld, queue wait: %.1f ns/item, steals: %lld, parks: %lld\n",
+		(long long)items,
+		(double)g_StatDispatchNS.load() / (double)items,
+		(long long)g_StatSteals.load(),
+		(long long)g_StatParks.load());
+}
+#define IL2CPP_TPSTAT(_x)	_x
+#else
+#define IL2CPP_TPSTAT(_x)
+#endif
+
+// 线程私有的空闲工作项链表, 执行线程回收到自己的链表中
+static thread_local il2cppWorkItem* t_FreeItems = nullptr;
+static thread_local uint32_t t_FreeCount = 0;
+static const uint32_t MaxFreeItems = 256;
+
+static il2cppWorkItem* AllocItem()
+{
+	il2cppWorkItem* item = t_FreeItems;
+	if (item)
+	{
+		t_FreeItems = item->NextFree;
+		--t_FreeCount;
+		return item;
+	}
+	return (il2cppWorkItem*)il2cpp_GC_AllocUncollectable(sizeof(il2cppWorkItem));
+}
+
+static void FreeItem(il2cppWorkItem* item)
+{
+	item->Object = nullptr;
+	item->State = nullptr;
+	if (t_FreeCount < MaxFreeItems)
+	{
+		item->NextFree = t_FreeItems;
+		t_FreeItems = item;
+		++t_FreeCount;
+	}
+	else
+		il2cpp_GC_Free(item);
+}
+
+// Chase-Lev 工作窃取队列. 所有者在底部压入与弹出, 其他线程从顶部窃取
+class WorkDeque
+{
+	struct Ring
+	{
+		int64_t Mask;
+		std::atomic<il2cppWorkItem*>* Items;
+
+		explicit Ring(int64_t capacity)
+			: Mask(capacity - 1)
+			, Items(new std::atomic<il2cppWorkItem*>[capacity])
+		{}
+
+		~Ring()
+		{
+			delete[] Items;
+		}
+
+		il2cppWorkItem* Get(int64_t idx) const
+		{
+			return Items[idx & Mask].load(std::memory_order_relaxed);
+		}
+
+		void Put(int64_t idx, il2cppWorkItem* item)
+		{
+			Items[idx & Mask].store(item, std::memory_order_relaxed);
+		}
+	};
+
+public:
+	static il2cppWorkItem* const StealAbort;
+
+	WorkDeque()
+		: Top_(0)
+		, Bottom_(0)
+		, Array_(new Ring(64))
+	{}
+
+	void Push(il2cppWorkItem* item)
+	{
+		int64_t b = Bottom_.load(std::memory_order_relaxed);
+		int64_t t = Top_.load(std::memory_order_acquire);
+		Ring* a = Array_.load(std::memory_order_relaxed);
+		if (b - t > a->Mask)
+			a = Grow(a, t, b);
+		a->Put(b, item);
+		Bottom_.store(b + 1, std::memory_order_release);
+	}
+
+	il2cppWorkItem* Pop()
+	{
+		int64_t b = Bottom_.load(std::memory_order_relaxed) - 1;
+		Ring* a = Array_.load(std::memory_order_relaxed);
+		Bottom_.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = Top_.load(std::memory_order_relaxed);
+
+		if (t > b)
+		{
+			Bottom_.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		il2cppWorkItem* item = a->Get(b);
+		if (t == b)
+		{
+			// 最后一项与窃取者竞争
+			if (!Top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				item = nullptr;
+			Bottom_.store(b + 1, std::memory_order_relaxed);
+		}
+		return item;
+	}
+
+	// 仅所有者调用, 底部恰为 obj 时弹出
+	il2cppWorkItem* PopIf(cls_Object* obj)
+	{
+		int64_t b = Bottom_.load(std::memory_order_relaxed);
+		if (b <= Top_.load(std::memory_order_acquire))
+			return nullptr;
+		if (Array_.load(std::memory_order_relaxed)->Get(b - 1)->Object != obj)
+			return nullptr;
+
+		il2cppWorkItem* item = Pop();
+		if (item && item->Object != obj)
+		{
+			// 读取期间底部项已被窃取者换走, 放回原处
+			Push(item);
+			return nullptr;
+		}
+		return item;
+	}
+
+	il2cppWorkItem* Steal()
+	{
+		int64_t t = Top_.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = Bottom_.load(std::memory_order_acquire);
+		if (t >= b)
+			return nullptr;
+
+		Ring* a = Array_.load(std::memory_order_acquire);
+		il2cppWorkItem* item = a->Get(t);
+		if (!Top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return StealAbort;
+		return item;
+	}
+
+	bool IsEmpty() const
+	{
+		return Bottom_.load(std::memory_order_acquire) <= Top_.load(std::memory_order_acquire);
+	}
+
+private:
+	Ring* Grow(Ring* a, int64_t t, int64_t b)
+	{
+		Ring* na = new Ring((a->Mask + 1) * 2);
+		for (int64_t i = t; i < b; ++i)
+			na->Put(i, a->Get(i));
+		// 窃取者可能仍在读取旧数组, 直到队列销毁时才释放
+		Retired_.push_back(a);
+		Array_.store(na, std::memory_order_release);
+		return na;
+	}
+
+	alignas(64) std::atomic<int64_t> Top_;
+	alignas(64) std::atomic<int64_t> Bottom_;
+	std::atomic<Ring*> Array_;
+	std::vector<Ring*> Retired_;
+};
+
+il2cppWorkItem* const WorkDeque::StealAbort = (il2cppWorkItem*)(uintptr_t)1;
+
+struct alignas(64) il2cppWorker
+{
+	WorkDeque Deque;
+	uint32_t Index = 0;
+	uint32_t Seed = 0;
+};
+
+static il2cppWorker** g_Workers = nullptr;
+static std::atomic<int32_t> g_WorkerCount(0);
+static int32_t g_TargetWorkers = IL2CPP_THREADPOOL_WORKERS;
+static std::atomic<int32_t> g_BusyWorkers(0);
+static std::mutex g_StartMutex;
+
+static thread_local il2cppWorker* t_Worker = nullptr;
+
+// 全局注入队列, 非工作线程或要求公平调度时使用
+static std::mutex g_GlobalMutex;
+// 后台工作线程在进程退出时可能仍在访问, 因此不析构
+static std::deque<il2cppWorkItem*>& g_GlobalQueue = *new std::deque<il2cppWorkItem*>();
+static std::atomic<int32_t> g_GlobalSize(0);
+
+// 空闲工作线程在 g_ParkEpoch 上休眠
+static std::atomic<uint32_t> g_ParkEpoch(0);
+static std::atomic<int32_t> g_Sleepers(0);
+
+#if defined(__linux__)
+static void FutexWait(std::atomic<uint32_t>* addr, uint32_t val)
+{
+	syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAIT_PRIVATE, val, nullptr, nullptr, 0);
+}
+
+static void FutexWake(std::atomic<uint32_t>* addr, int32_t count)
+{
+	syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+#else
+static std::mutex g_ParkMutex;
+static std::condition_variable g_ParkCond;
+
+static void FutexWait(std::atomic<uint32_t>* addr, uint32_t val)
+{
+	std::unique_lock<std::mutex> lk(g_ParkMutex);
+	g_ParkCond.wait(lk, [addr, val] { return addr->load() != val; });
+}
+
+static void FutexWake(std::atomic<uint32_t>*, int32_t count)
+{
+	std::lock_guard<std::mutex> lk(g_ParkMutex);
+	if (count == 1)
+		g_ParkCond.notify_one();
+	else
+		g_ParkCond.notify_all();
+}
+#endif
+
+static void WakeWorker()
+{
+	// 与休眠线程的 g_Sleepers 递增及随后的队列检查构成全序
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (g_Sleepers.load(std::memory_order_relaxed) > 0)
+	{
+		g_ParkEpoch.fetch_add(1, std::memory_order_release);
+		FutexWake(&g_ParkEpoch, 1);
+	}
+}
+
+static il2cppWorkItem* PopGlobal()
+{
+	if (g_GlobalSize.load(std::memory_order_acquire) == 0)
+		return nullptr;
+
+	std::lock_guard<std::mutex> lk(g_GlobalMutex);
+	if (g_GlobalQueue.empty())
+		return nullptr;
+	il2cppWorkItem* item = g_GlobalQueue.front();
+	g_GlobalQueue.pop_front();
+	g_GlobalSize.fetch_sub(1, std::memory_order_relaxed);
+	return item;
+}
+
+static il2cppWorkItem* StealWork(il2cppWorker* self)
+{
+	int32_t count = g_WorkerCount.load(std::memory_order_acquire);
+	for (int retry = 0; retry < 2; ++retry)
+	{
+		bool isAborted = false;
+		// xorshift 选择起始的窃取对象以分散竞争
+		self->Seed ^= self->Seed << 13;
+		self->Seed ^= self->Seed >> 17;
+		self->Seed ^= self->Seed << 5;
+		uint32_t start = self->Seed % (uint32_t)count;
+
+		for (int32_t i = 0; i < count; ++i)
+		{
+			il2cppWorker* victim = g_Workers[(start + i) % count];
+			if (victim == self)
+				continue;
+
+			il2cppWorkItem* item = victim->Deque.Steal();
+			if (item == WorkDeque::StealAbort)
+				isAborted = true;
+			else if (item)
+			{
+				IL2CPP_TPSTAT(g_StatSteals.fetch_add(1, std::memory_order_relaxed));
+				return item;
+			}
+		}
+		if (!isAborted)
+			break;
+	}
+	return nullptr;
+}
+
+static bool HasWork()
+{
+	if (g_GlobalSize.load(std::memory_order_acquire) != 0)
+		return true;
+	int32_t count = g_WorkerCount.load(std::memory_order_acquire);
+	for (int32_t i = 0; i < count; ++i)
+	{
+		if (!g_Workers[i]->Deque.IsEmpty())
+			return true;
+	}
+	return false;
+}
+
+static void ExecuteItem(il2cppWorkItem* item)
+{
+	IL2CPP_TPSTAT(g_StatDispatchNS.fetch_add(StatNow() - item->QueuedTime, std::memory_order_relaxed));
+	IL2CPP_TPSTAT(g_StatItems.fetch_add(1, std::memory_order_relaxed));
+
+	g_BusyWorkers.fetch_add(1, std::memory_order_relaxed);
+	item->Func(item->Object, item->State);
+	g_BusyWorkers.fetch_sub(1, std::memory_order_relaxed);
+
+#if defined(IL2CPP_EXCEPTION_STATUS)
+	// 未处理的异常终止进程
+	if (IL2CPP_PENDING_EXCEPTION)
+		IL2CPP_TRAP;
+#endif
+
+	FreeItem(item);
+}
+
+static void WorkerMain(il2cppWorker* self)
+{
+	il2cpp_GC_RegisterThread();
+	t_Worker = self;
+
+	for (;;)
+	{
+		il2cppWorkItem* item = self->Deque.Pop();
+		if (!item)
+			item = PopGlobal();
+		if (!item)
+			item = StealWork(self);
+		if (item)
+		{
+			ExecuteItem(item);
+			continue;
+		}
+
+		// 短暂自旋后休眠
+		bool isFound = false;
+		for (int spin = 0; spin < 16 && !isFound; ++spin)
+		{
+			il2cpp_Yield();
+			isFound = HasWork();
+		}
+		if (isFound)
+			continue;
+
+		uint32_t epoch = g_ParkEpoch.load(std::memory_order_acquire);
+		g_Sleepers.fetch_add(1, std::memory_order_seq_cst);
+		if (!HasWork())
+		{
+			IL2CPP_TPSTAT(g_StatParks.fetch_add(1, std::memory_order_relaxed));
+			FutexWait(&g_ParkEpoch, epoch);
+		}
+		g_Sleepers.fetch_sub(1, std::memory_order_relaxed);
+	}
+}
+
+static void StartWorkers()
+{
+	std::lock_guard<std::mutex> lk(g_StartMutex);
+	if (g_WorkerCount.load(std::memory_order_relaxed) != 0)
+		return;
+
+	int32_t count = g_TargetWorkers > 0 ? g_TargetWorkers : il2cpp_ProcessorCount();
+	if (count < 1)
+		count = 1;
+
+	g_Workers = new il2cppWorker*[count];
+	for (int32_t i = 0; i < count; ++i)
+	{
+		il2cppWorker* w = new il2cppWorker();
+		w->Index = (uint32_t)i;
+		w->Seed = 0x9E3779B9u * (uint32_t)(i + 1);
+		g_Workers[i] = w;
+	}
+
+	IL2CPP_TPSTAT(atexit(&StatReport));
+
+	g_WorkerCount.store(count, std::memory_order_release);
+
+	// 工作线程均为后台线程, 不阻止进程退出
+	for (int32_t i = 0; i < count; ++i)
+		std::thread(&WorkerMain, g_Workers[i]).detach();
+}
+
+void il2cpp_ThreadPool__Queue(IL2CPP_WORKITEM_FUNC func, cls_Object* obj, cls_Object* state, uint8_t preferLocal)
+{
+	if (IL2CPP_UNLIKELY(g_WorkerCount.load(std::memory_order_acquire) == 0))
+		StartWorkers();
+
+	il2cppWorkItem* item = AllocItem();
+	item->Func = func;
+	item->Object = obj;
+	item->State = state;
+	IL2CPP_TPSTAT(item->QueuedTime = StatNow());
+
+	il2cppWorker* self = t_Worker;
+	if (self && preferLocal)
+		self->Deque.Push(item);
+	else
+	{
+		std::lock_guard<std::mutex> lk(g_GlobalMutex);
+		g_GlobalQueue.push_back(item);
+		g_GlobalSize.fetch_add(1, std::memory_order_release);
+	}
+
+	WakeWorker();
+}
+
+uint8_t il2cpp_ThreadPool__TryPop(cls_Object* obj)
+{
+	il2cppWorker* self = t_Worker;
+	if (!self)
+		return 0;
+
+	il2cppWorkItem* item = self->Deque.PopIf(obj);
+	if (!item)
+		return 0;
+	FreeItem(item);
+	return 1;
+}
+
+int32_t il2cpp_ThreadPool__GetWorkerCount()
+{
+	int32_t count = g_WorkerCount.load(std::memory_order_acquire);
+	if (count != 0)
+		return count;
+	return g_TargetWorkers > 0 ? g_TargetWorkers : il2cpp_ProcessorCount();
+}
+
+int32_t il2cpp_ThreadPool__GetBusyCount()
+{
+	return g_BusyWorkers.load(std::memory_order_relaxed);
+}
+
+uint8_t il2cpp_ThreadPool__SetWorkerCount(int32_t count)
+{
+	// 工作线程数固定, 仅在线程池启动前可以调整
+	std::lock_guard<std::mutex> lk(g_StartMutex);
+	if (count < 1 || g_WorkerCount.load(std::memory_order_relaxed) != 0)
+		return 0;
+	g_TargetWorkers = count;
+	return 1;
+}
+
+// 计时器线程, 代替 TimerQueue 使用的原生 AppDomain 计时器. 到期后在线程池上回调
+// 计时线程在进程退出时仍在等待, 因此以下对象均不析构
+static std::mutex& g_TimerMutex = *new std::mutex();
+static std::condition_variable& g_TimerCond = *new std::condition_variable();
+// 按 TimerQueue 编号保存的到期时间, 负数表示未调度
+static std::vector<int64_t>& g_TimerDue = *new std::vector<int64_t>();
+static IL2CPP_TIMER_FUNC g_TimerCallback = nullptr;
+static bool g_TimerStarted = false;
+
+static int64_t TimerNowMS()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void TimerWorkItem(cls_Object*, cls_Object* state)
+{
+	g_TimerCallback((int32_t)(intptr_t)state);
+}
+
+static void TimerMain()
+{
+	il2cpp_GC_RegisterThread();
+
+	std::vector<int32_t> fired;
+	std::unique_lock<std::mutex> lk(g_TimerMutex);
+	for (;;)
+	{
+		int64_t now = TimerNowMS();
+		int64_t next = INT64_MAX;
+		for (size_t i = 0; i < g_TimerDue.size(); ++i)
+		{
+			int64_t due = g_TimerDue[i];
+			if (due < 0)
+				continue;
+			if (due <= now)
+			{
+				g_TimerDue[i] = -1;
+				fired.push_back((int32_t)i);
+			}
+			else if (due < next)
+				next = due;
+		}
+
+		if (!fired.empty())
+		{
+			lk.unlock();
+			for (int32_t id : fired)
+				il2cpp_ThreadPool__Queue(&TimerWorkItem, nullptr, (cls_Object*)(intptr_t)id, 0);
+			fired.clear();
+			lk.lock();
+			continue;
+		}
+
+		if (next == INT64_MAX)
+			g_TimerCond.wait(lk);
+		else
+			g_TimerCond.wait_for(lk, std::chrono::milliseconds(next - now));
+	}
+}
+
+void il2cpp_Timer__Schedule(int32_t id, uint32_t dueMS, IL2CPP_TIMER_FUNC callback)
+{
+	IL2CPP_ASSERT(id >= 0);
+	std::lock_guard<std::mutex> lk(g_TimerMutex);
+	g_TimerCallback = callback;
+	if ((size_t)id >= g_TimerDue.size())
+		g_TimerDue.resize(id + 1, -1);
+	// 与原生计时器一致, 重新调度会替换之前的到期时间
+	g_TimerDue[id] = TimerNowMS() + dueMS;
+
+	if (!g_TimerStarted)
+	{
+		g_TimerStarted = true;
+		std::thread(&TimerMain).detach();
+	}
+	g_TimerCond.notify_one();
+}
+
+// Parallel.For 降级后的循环任务, 分配在不回收的 GC 内存中以便扫描闭包与异常
+struct il2cppParallelJob
+{
+	IL2CPP_PARALLELFOR_FUNC Func;
+	cls_Object* Context;
+	std::atomic<cls_Object*> Exception;
+	int64_t Lo;
+	int64_t Hi;
+	int64_t Grain;
+	int32_t NumChunks;
+	std::atomic<int32_t> NextChunk;
+	std::atomic<int32_t> DoneChunks;
+	std::atomic<int32_t> RefCount;
+	std::mutex Mutex;
+	std::condition_variable Cond;
+};
+
+static void ReleaseJob(il2cppParallelJob* job)
+{
+	if (job->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		job->~il2cppParallelJob();
+		il2cpp_GC_Free(job);
+	}
+}
+
+static void RunChunks(il2cppParallelJob* job)
+{
+	for (;;)
+	{
+		int32_t chunk = job->NextChunk.fetch_add(1, std::memory_order_relaxed);
+		if (chunk >= job->NumChunks)
+			return;
+
+		// 出现异常后剩余的分段只计数不执行
+		if (!job->Exception.load(std::memory_order_relaxed))
+		{
+			int64_t lo = job->Lo + chunk * job->Grain;
+			int64_t hi = IL2CPP_MIN(lo + job->Grain, job->Hi);
+			cls_Object* ex = nullptr;
+#if defined(IL2CPP_EXCEPTION_STATUS)
+			job->Func(job->Context, (int32_t)lo, (int32_t)hi);
+			if (IL2CPP_PENDING_EXCEPTION)
+				ex = il2cpp_TakePendingException();
+#else
+			try
+			{
+				job->Func(job->Context, (int32_t)lo, (int32_t)hi);
+			}
+			catch (const il2cppException& exp)
+			{
+				ex = exp.ExceptionPtr;
+			}
+#endif
+			if (ex)
+			{
+				cls_Object* expected = nullptr;
+				job->Exception.compare_exchange_strong(expected, ex, std::memory_order_relaxed);
+			}
+		}
+
+		if (job->DoneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == job->NumChunks)
+		{
+			std::lock_guard<std::mutex> lk(job->Mutex);
+			job->Cond.notify_all();
+		}
+	}
+}
+
+static void ParallelWorkItem(cls_Object* obj, cls_Object*)
+{
+	il2cppParallelJob* job = (il2cppParallelJob*)obj;
+	RunChunks(job);
+	ReleaseJob(job);
+}
+
+void il2cpp_ParallelFor(int32_t lo, int32_t hi, int32_t grain, IL2CPP_PARALLELFOR_FUNC func, cls_Object* ctx)
+{
+	if (lo >= hi)
+		return;
+
+	// 默认按参与线程数静态均分, 调用线程也执行分段
+	int64_t count = (int64_t)hi - lo;
+	int32_t workers = il2cpp_ThreadPool__GetWorkerCount();
+	int64_t chunkSize = grain > 0 ? grain : (count + workers) / (workers + 1);
+
+	int64_t numChunks = (count + chunkSize - 1) / chunkSize;
+	if (numChunks <= 1 || workers <= 0)
+	{
+		func(ctx, lo, hi);
+		return;
+	}
+
+	int32_t helpers = (int32_t)IL2CPP_MIN(numChunks - 1, (int64_t)workers);
+
+	void* mem = il2cpp_GC_AllocUncollectable(sizeof(il2cppParallelJob));
+	il2cppParallelJob* job = new (mem) il2cppParallelJob();
+	job->Func = func;
+	job->Context = ctx;
+	job->Exception.store(nullptr, std::memory_order_relaxed);
+	job->Lo = lo;
+	job->Hi = hi;
+	job->Grain = chunkSize;
+	job->NumChunks = (int32_t)numChunks;
+	job->NextChunk.store(0, std::memory_order_relaxed);
+	job->DoneChunks.store(0, std::memory_order_relaxed);
+	job->RefCount.store(helpers + 1, std::memory_order_relaxed);
+
+	for (int32_t i = 0; i < helpers; ++i)
+		il2cpp_ThreadPool__Queue(&ParallelWorkItem, (cls_Object*)job, nullptr, 1);
+
+	RunChunks(job);
+
+	// 只等待已被领取的分段完成, 尚未运行的辅助工作项领取不到分段会直接返回
+	if (job->DoneChunks.load(std::memory_order_acquire) != job->NumChunks)
+	{
+		std::unique_lock<std::mutex> lk(job->Mutex);
+		job->Cond.wait(lk, [job]() { return job->DoneChunks.load(std::memory_order_acquire) == job->NumChunks; });
+	}
+
+	cls_Object* ex = job->Exception.load(std::memory_order_relaxed);
+	ReleaseJob(job);
+
+	if (ex)
+	{
+#if defined(IL2CPP_EXCEPTION_STATUS)
+		il2cpp_PendingException = ex;
+#else
+		throw il2cppException(ex);
+#endif
+	}
+}
@@ -63,6 +63,9 @@ namespace test
 	{
 		private static int TotalTests;
 		private static int PassedTests;
+		private static bool UseStatusException;
+		private static bool UseImplicitNullCheck;
+		private static uint ValueTypeRefSize;
 
 		private static MethodDef IsTestBinding(TypeDef typeDef)
 		{
@@ -189,11 +192,19 @@ namespace test
 			if (metDef == null)
 				return;
 
+			// 依赖隐式空检查的测试只在对应模式下运行
+			if ((!UseImplicitNullCheck || UseStatusException) &&
+				typeDef.CustomAttributes.Any(attr => attr.AttributeType.Name == "ImplicitNullCheckAttribute"))
+				return;
+
 			string testName = string.Format("[{0}]{1}", imageName, typeDef.FullName);
 			var oldColor = Console.ForegroundColor;
 			Console.Write("{0,-52}", string.Format("{0} {1}:", subDir, testName));
 
 			context.AddEntry(metDef);
+			context.UseStatusException = UseStatusException;
+			context.UseImplicitNullCheck = UseImplicitNullCheck;
+			context.ValueTypeRefSize = ValueTypeRefSize;
 
 			var sw = new Stopwatch();
 			sw.Start();
@@ -213,6 +224,14 @@ namespace test
 			sw.Stop();
 			elapsedMS = sw.ElapsedMilliseconds;
 			Console.Write("{0,-12}", string.Format("Gen({0}ms)", elapsedMS));
+			Console.Write("{0,-20}", string.Format("Fold({0}/{1} {2:P1})",
+				genResult.FoldedMethodCount,
+				genResult.ImplMethodCount,
+				genResult.FoldRatio));
+
+			string foldErr = CheckFolded(genResult, typeDef);
+			if (foldErr != null)
+				Console.Write("{0,-20}", foldErr);
 
 			string validatedName = ValidatePath(testName);
 			string genDir = Path.Combine(imageDir, "../../gen/", validatedName);
@@ -244,7 +263,8 @@ namespace test
 			Il2cppContext.SaveToFolder(
 				genDir,
 				genResult.UnitList,
-				new HashSet<string> { "main" });
+				new HashSet<string> { "main" },
+				genResult.BuildParams);
 			genDir = Path.GetFullPath(genDir);
 
 			Console.Write("Building");
@@ -298,7 +318,7 @@ namespace test
 					result = GetRunResult(runOutput);
 			}
 
-			if (result == "0")
+			if (result == "0" && foldErr == null)
 			{
 				Console.ForegroundColor = ConsoleColor.Green;
 				Console.WriteLine("PASS");
@@ -318,6 +338,33 @@ namespace test
 			context.Reset();
 		}
 
+		// 标记为同组的方法应使用同一实现函数
+		private static string CheckFolded(GenerateResult genResult, TypeDef typeDef)
+		{
+			var typeList = new List<TypeDef> { typeDef };
+			for (int i = 0; i < typeList.Count; ++i)
+				typeList.AddRange(typeList[i].NestedTypes);
+
+			var groupMap = new Dictionary<string, string>();
+			foreach (var tyDef in typeList)
+			{
+				foreach (var metDef in tyDef.Methods)
+				{
+					var foldAttr = metDef.CustomAttributes.FirstOrDefault(attr => attr.AttributeType.Name == "FoldedAttribute");
+					if (foldAttr == null)
+						continue;
+
+					string group = foldAttr.ConstructorArguments[0].Value.ToString();
+					string implName = genResult.GetImplMethodName(metDef);
+					if (!groupMap.TryGetValue(group, out string groupImpl))
+						groupMap.Add(group, implName);
+					else if (groupImpl != implName)
+						return string.Format("NotFolded({0})", group);
+				}
+			}
+			return null;
+		}
+
 		private static string GetRunResult(string str)
 		{
 			int lp = str.IndexOf('(');
@@ -451,6 +498,12 @@ namespace test
 			testBinding.Start();
 			Console.WriteLine("\nTestBinding Passed: {0}/{1}", PassedTests, TotalTests);
 #else
+			UseStatusException = args.Contains("-status-exception");
+			UseImplicitNullCheck = args.Contains("-implicit-nullcheck");
+			string refSizeArg = args.FirstOrDefault(arg => arg.StartsWith("-valuetype-ref-size="));
+			if (refSizeArg != null)
+				ValueTypeRefSize = uint.Parse(refSizeArg.Substring(refSizeArg.IndexOf('=') + 1));
+
 			var testCodeGen = new Testbed();
 			testCodeGen.TestDir = "../../../testcases/";
 			testCodeGen.OnType = TestCodeGen;
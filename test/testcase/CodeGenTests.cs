@@ -2,6 +2,7 @@
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.Linq;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using testInsts;
 
@@ -11,6 +12,20 @@ namespace testcase
 	{
 	}
 
+	// 同组的方法应折叠为同一实现
+	[AttributeUsage(AttributeTargets.Method | AttributeTargets.Constructor)]
+	class FoldedAttribute : Attribute
+	{
+		public FoldedAttribute(string group)
+		{
+		}
+	}
+
+	// 只在开启隐式空检查时运行
+	class ImplicitNullCheckAttribute : Attribute
+	{
+	}
+
 	static class Helper
 	{
 		public static bool IsEquals(this float lhs, float rhs, float prec = 0.00001f)
@@ -399,255 +414,2082 @@ namespace testcase
 			}
 		}
 
-		class ClsB : Inf
+		class ClsB : Inf
+		{
+			public int Foo()
+			{
+				return 456;
+			}
+		}
+
+		struct Stru : Inf
+		{
+			public int num;
+
+			public Stru(int n)
+			{
+				num = n;
+			}
+			public int Foo()
+			{
+				return num;
+			}
+		}
+
+		private static int Bla(Inf inf)
+		{
+			return inf.Foo();
+		}
+
+		public static int Entry()
+		{
+			if (Bla(new ClsB()) - Bla(new ClsA()) != 333)
+				return 1;
+			if (Bla(new Stru(789)) != 789)
+				return 2;
+			Inf inf = new Stru(789);
+			if (inf.Foo() != 789)
+				return 3;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestCallVirtStru
+	{
+		interface Inf<T>
+		{
+			T Foo(T t);
+		}
+
+		struct StruA<T> : Inf<T>
+		{
+			public T num;
+
+			public StruA(T n)
+			{
+				num = n;
+			}
+			public T Foo(T t)
+			{
+				return num;
+			}
+		}
+
+		class ClsB<T> : Inf<T>
+		{
+			public T num;
+			public T Foo(T t)
+			{
+				return num;
+			}
+		}
+
+		struct StruC : Inf<int>
+		{
+			public int Foo(int t)
+			{
+				return t * 2;
+			}
+		}
+
+		class ClsD : Inf<int>
+		{
+			public int Foo(int t)
+			{
+				return t * 3;
+			}
+		}
+
+		private static T Bla2<T>(Inf<T> inf, T t)
+		{
+			return inf.Foo(t);
+		}
+
+		public static int Entry()
+		{
+			if (Bla2(new StruA<int>(123), 123) != 123)
+				return 1;
+			var bb = new ClsB<int>();
+			bb.num = 456;
+			if (Bla2(bb, 123) != 456)
+				return 2;
+			if (Bla2(new StruC(), 123) != 246)
+				return 3;
+			if (Bla2(new ClsD(), 124) != 372)
+				return 4;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestString
+	{
+		class MyCls
+		{
+			public string strfld = "defaultstr";
+		}
+
+		private static string Foo(string s)
+		{
+			return s;
+		}
+
+		public static unsafe int Entry()
+		{
+			string s = "asdf\\1234\"zxcv'!~";
+
+			if (s[4] != 0x5C)
+				return -1;
+			if (s[9] != 0x22)
+				return -2;
+			if (s[14] != 0x27)
+				return -3;
+
+			s = "0987\r\n!~";
+			if (s[4] != 0x0D)
+				return -4;
+			if (s[5] != 0x0A)
+				return -5;
+
+			s = "你好世界";
+			if (s[0] != 0x4F60)
+				return -6;
+			if (s[1] != 0x597D)
+				return -7;
+			if (s[2] != 0x4E16)
+				return -8;
+			if (s[3] != 0x754C)
+				return -9;
+			if (s.Length != 4)
+				return -10;
+
+			s = "";
+			object o = s.Length == 0 ? s : null;
+			if (!(o is string))
+				return -11;
+
+			s = "hello,world";
+			if (s != "hello,world")
+				return 1;
+			if (s.Length != 11)
+				return 2;
+
+			if (Foo(s) != s)
+				return 3;
+
+			if (s[0] != 'h')
+				return 4;
+			if (s[10] != 'd')
+				return 5;
+
+			int hash = s.GetHashCode();
+			if (hash != "hello,world".GetHashCode())
+				return 6;
+
+			MyCls cls = new MyCls();
+			if (cls.strfld != "defaultstr")
+				return 7;
+			cls.strfld = "nice";
+			if (cls.strfld != "nice")
+				return 8;
+
+			string strRep = "adsf @calloc 1234";
+			if (strRep[6] != 'c' ||
+				strRep[7] != 'a' ||
+				strRep[8] != 'l' ||
+				strRep[9] != 'l' ||
+				strRep[10] != 'o' ||
+				strRep[11] != 'c' ||
+				strRep[12] != ' ')
+				return 9;
+
+			string strRep2 = "adsf  attributes # 1234";
+			if (strRep2[6] != 'a' ||
+				strRep2[7] != 't' ||
+				strRep2[8] != 't' ||
+				strRep2[9] != 'r' ||
+				strRep2[10] != 'i' ||
+				strRep2[11] != 'b' ||
+				strRep2[12] != 'u' ||
+				strRep2[13] != 't' ||
+				strRep2[14] != 'e' ||
+				strRep2[15] != 's' ||
+				strRep2[16] != ' ')
+				return 10;
+
+			string aa = "Test";
+			string bb = "拼接";
+			string con = aa + bb;
+			if (con != "Test拼接")
+				return 11;
+
+			if (con.Substring(2, 3) != "st拼")
+				return 12;
+
+			if (con.IndexOf('拼') != 4)
+				return 13;
+
+			string strCmp = "qwe\0r";
+			if (strCmp != strCmp ||
+				strCmp == "qwe\0\0")
+				return 14;
+
+			char* pstr = stackalloc char[10];
+			pstr[5] = 'H';
+			pstr[6] = 'e';
+			pstr[7] = 'l';
+			pstr[8] = 'l';
+			pstr[9] = 'o';
+			string str = new string(pstr, 5, 5);
+			if (str != "Hello")
+				return 15;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestString2
+	{
+		public static int Entry()
+		{
+			string str = "1234asdf测试字符串字符串";
+			if (str.IndexOf("df测试", StringComparison.Ordinal) != 6)
+				return 1;
+
+			if (str.LastIndexOf("字符串", StringComparison.Ordinal) != 13)
+				return 2;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestStringKernels
+	{
+		public static int Entry()
+		{
+			string a = "0123456789abcdefghijklmnopqrstuvwxyz测试";
+			string b = "0123456789abcdef" + "ghijklmnopqrstuvwxyz测试";
+			if (!string.Equals(a, b))
+				return 1;
+			if (a.GetHashCode() != b.GetHashCode())
+				return 2;
+
+			string c = "0123456789abcdefghijklmnopqrstuvwxyZ测试";
+			if (string.Equals(a, c))
+				return 3;
+			if (string.CompareOrdinal(a, c) <= 0)
+				return 4;
+			if (string.CompareOrdinal(c, a) >= 0)
+				return 5;
+			if (string.CompareOrdinal(a, a + "!") >= 0)
+				return 6;
+			if (string.CompareOrdinal(a, 10, c, 10, 5) != 0)
+				return 7;
+
+			if (a.IndexOf('试') != 37)
+				return 8;
+			if (a.IndexOf('z', 20) != 35)
+				return 9;
+			if (a.IndexOf('0', 1) != -1)
+				return 10;
+			if (a.IndexOf('9', 3, 5) != -1)
+				return 11;
+			if (a.IndexOf('9', 3, 7) != 9)
+				return 12;
+
+			try
+			{
+				a.IndexOf('0', 30, 20);
+				return 13;
+			}
+			catch (ArgumentOutOfRangeException)
+			{
+			}
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestStringIntern
+	{
+		public static int Entry()
+		{
+			string lit = "intern-literal";
+			string dyn = new string('x', 3) + "-dynamic";
+
+			if ((object)string.Intern("intern-" + "literal".Substring(0)) != (object)string.Intern(lit))
+				return 1;
+			if (string.IsInterned(dyn) != null)
+				return 2;
+			if ((object)string.Intern(dyn) != (object)dyn)
+				return 3;
+			if ((object)string.IsInterned(new string('x', 3) + "-dynamic") != (object)dyn)
+				return 4;
+			if (lit.GetHashCode() != ("intern-" + "literal".Substring(0)).GetHashCode())
+				return 5;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestStringConcat
+	{
+		public static int Entry()
+		{
+			string a = "ab";
+			string b = null;
+			string e = "";
+			int i = -1234;
+			long l = long.MinValue;
+			ulong u = ulong.MaxValue;
+
+			if ((object)string.Concat(b, e) != (object)string.Empty)
+				return 1;
+			if ((object)string.Concat(a, b) != (object)a)
+				return 2;
+			if (a + "cd" + i.ToString() != "abcd-1234")
+				return 3;
+			if (string.Concat(a, l.ToString(), e, u.ToString()) != "ab-922337203685477580818446744073709551615")
+				return 4;
+			if (string.Concat(new[] { a, b, "x", e, a }) != "abxab")
+				return 5;
+			if (0.ToString() != "0" || uint.MaxValue.ToString() != "4294967295")
+				return 6;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestStringCtor
+	{
+		public static unsafe int Entry()
+		{
+			char[] chs = { 'a', 'b', 'c', 'd' };
+			if (new string('z', 3) != "zzz" || new string('z', 0).Length != 0)
+				return 1;
+			if (new string(chs) != "abcd" || new string((char[])null).Length != 0)
+				return 2;
+			if (new string(chs, 1, 2) != "bc" || new string(chs, 4, 0).Length != 0)
+				return 3;
+
+			fixed (char* p = "xyz")
+			{
+				if (new string(p) != "xyz")
+					return 4;
+			}
+			if (new string((char*)null).Length != 0)
+				return 5;
+
+			try
+			{
+				new string('z', -1);
+				return 6;
+			}
+			catch (ArgumentOutOfRangeException)
+			{
+			}
+
+			try
+			{
+				new string(chs, 3, 2);
+				return 7;
+			}
+			catch (ArgumentOutOfRangeException)
+			{
+			}
+
+			try
+			{
+				new string((char[])null, 0, 0);
+				return 8;
+			}
+			catch (ArgumentNullException)
+			{
+			}
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestUTF8
+	{
+		public static unsafe int Entry()
+		{
+			var enc = System.Text.Encoding.UTF8;
+			string str = "ascii-prefix-that-is-long-enough-for-simd: \u00e9\u4e2d\ud83d\ude00!";
+
+			byte[] bytes = enc.GetBytes(str);
+			if (bytes.Length != 43 + 2 + 3 + 4 + 1)
+				return 1;
+			if (enc.GetString(bytes) != str)
+				return 2;
+			if (enc.GetCharCount(bytes, 0, bytes.Length) != str.Length)
+				return 3;
+
+			// 非法序列按 corlib 的回退规则替换为 U+FFFD
+			byte[] bad = { 0x61, 0xC0, 0xAF, 0xED, 0xA0, 0x80, 0xF0, 0x9F, 0x62 };
+			if (enc.GetString(bad) != "a\ufffd\ufffd\ufffd\ufffd\ufffdb")
+				return 4;
+
+			sbyte* pstr = stackalloc sbyte[4];
+			pstr[0] = 0x68;
+			pstr[1] = unchecked((sbyte)0xC3);
+			pstr[2] = unchecked((sbyte)0xA9);
+			pstr[3] = 0;
+			if (new string(pstr) != "h\u00e9")
+				return 5;
+			if (new string(pstr, 1, 2) != "\u00e9")
+				return 6;
+
+			// 抛出异常的编码
+			var strict = new System.Text.UTF8Encoding(false, true);
+			if (strict.GetString(bytes) != str)
+				return 7;
+			try
+			{
+				strict.GetString(bad);
+				return 8;
+			}
+			catch (ArgumentException)
+			{
+			}
+			try
+			{
+				strict.GetBytes("\ud800");
+				return 9;
+			}
+			catch (ArgumentException)
+			{
+			}
+
+			// 自定义替换字符串
+			var repl = (System.Text.Encoding)System.Text.Encoding.UTF8.Clone();
+			repl.EncoderFallback = new System.Text.EncoderReplacementFallback("?");
+			repl.DecoderFallback = new System.Text.DecoderReplacementFallback("?");
+			if (repl.GetString(new byte[] { 0x61, 0xFF, 0x62 }) != "a?b")
+				return 10;
+			byte[] replBytes = repl.GetBytes("a\ud800b");
+			if (replBytes.Length != 3 || replBytes[1] != (byte)'?')
+				return 11;
+
+			// 目标空间不足与空参数
+			try
+			{
+				enc.GetBytes(str, 0, str.Length, new byte[4], 0);
+				return 12;
+			}
+			catch (ArgumentException)
+			{
+			}
+			try
+			{
+				enc.GetString(null);
+				return 13;
+			}
+			catch (ArgumentNullException)
+			{
+			}
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestLoopRangeCheck
+	{
+		private static int Sum(int[] ary)
+		{
+			int sum = 0;
+			for (int i = 0; i < ary.Length; ++i)
+				sum += ary[i];
+			return sum;
+		}
+
+		private static void Scale(float[] dst, float[] src, int count, float factor)
+		{
+			for (int i = 0; i < count; ++i)
+				dst[i] = src[i] * factor;
+		}
+
+		private static void Copy(int[] dst, int[] src, int count)
+		{
+			for (int i = 0; i < count; ++i)
+				dst[i] = src[i];
+		}
+
+		// 越界前的迭代必须已经执行
+		private static int PartialSum(int[] ary, int count)
+		{
+			int sum = 0;
+			int i = 0;
+			try
+			{
+				for (i = 0; i < count; ++i)
+					sum += ary[i];
+			}
+			catch (IndexOutOfRangeException)
+			{
+				return sum * 1000 + i;
+			}
+			return -1;
+		}
+
+		private static int CountChar(string str, char ch)
+		{
+			int count = 0;
+			for (int i = 0; i < str.Length; ++i)
+			{
+				if (str[i] == ch)
+					++count;
+			}
+			return count;
+		}
+
+		public static int Entry()
+		{
+			int[] ary = new int[100];
+			for (int i = 0; i < ary.Length; ++i)
+				ary[i] = i;
+			if (Sum(ary) != 4950)
+				return 1;
+
+			float[] src = new float[10];
+			float[] dst = new float[10];
+			for (int i = 0; i < src.Length; ++i)
+				src[i] = i;
+			Scale(dst, src, 10, 2.0f);
+			if (dst[9] != 18.0f)
+				return 2;
+			Scale(dst, src, 0, 2.0f);
+
+			if (CountChar("a,b,,c", ',') != 3)
+				return 3;
+
+			int[] small = new int[4];
+			try
+			{
+				Copy(small, ary, 10);
+				return 4;
+			}
+			catch (IndexOutOfRangeException)
+			{
+			}
+			if (small[1] != 1 || small[3] != 3)
+				return 5;
+
+			if (PartialSum(small, 6) != 6 * 1000 + 4)
+				return 6;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestCharsOutOfRange
+	{
+		// 没有数组元素访问时, 字符串下标越界同样需要抛出异常
+		public static int Entry()
+		{
+			string str = "abc";
+			if (str[2] != 'c')
+				return 1;
+
+			try
+			{
+				char ch = str[3];
+				return 2;
+			}
+			catch (IndexOutOfRangeException)
+			{
+			}
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestIndexOutOfRange
+	{
+		private static int Load(int[] ary, int idx)
+		{
+			try
+			{
+				return ary[idx];
+			}
+			catch (IndexOutOfRangeException)
+			{
+				return -1;
+			}
+		}
+
+		public static int Entry()
+		{
+			int[] ary = { 1, 2, 3 };
+			if (Load(ary, 2) != 3)
+				return 1;
+			if (Load(ary, 3) != -1)
+				return 2;
+			if (Load(ary, -1) != -1)
+				return 3;
+
+			try
+			{
+				char ch = "abc"[5];
+				return 4;
+			}
+			catch (IndexOutOfRangeException)
+			{
+			}
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestArrayBulk
+	{
+		public static int Entry()
+		{
+			int[] ary = new int[100];
+			for (int i = 0; i < ary.Length; ++i)
+				ary[i] = i;
+
+			// 同一数组内的重叠复制
+			Array.Copy(ary, 0, ary, 1, 99);
+			if (ary[0] != 0 || ary[1] != 0 || ary[99] != 98)
+				return 1;
+			Array.Copy(ary, 2, ary, 0, 98);
+			if (ary[0] != 1 || ary[97] != 98 || ary[98] != 97)
+				return 2;
+
+			if (Array.IndexOf(ary, 50) != 49)
+				return 3;
+			if (Array.IndexOf(ary, 50, 60) != -1)
+				return 4;
+			if (Array.LastIndexOf(ary, 98) != 99)
+				return 5;
+			if (Array.LastIndexOf(ary, 1, 10, 5) != -1)
+				return 6;
+
+			long[] lary = { 1, 2, 3, 1L << 40, 5 };
+			if (Array.IndexOf(lary, 1L << 40) != 3)
+				return 7;
+			if (Array.IndexOf(lary, 1L << 41) != -1)
+				return 8;
+
+			char[] chs = "hello world, hello array".ToCharArray();
+			if (Array.LastIndexOf(chs, 'h') != 13)
+				return 9;
+
+			Array.Reverse(chs);
+			if (new string(chs) != "yarra olleh ,dlrow olleh")
+				return 10;
+			Array.Reverse(chs, 0, 5);
+			if (new string(chs, 0, 5) != "array")
+				return 11;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestSpan
+	{
+		struct Pair
+		{
+			public int A;
+			public long B;
+		}
+
+		public static int Entry()
+		{
+			int[] ints = new int[37];
+			var span = new Span<int>(ints, 3, 30);
+			span.Fill(7);
+			if (ints[2] != 0 || ints[3] != 7 || ints[32] != 7 || ints[33] != 0)
+				return 1;
+
+			byte[] bytes = new byte[9];
+			new Span<byte>(bytes).Fill(0xAB);
+			if (bytes[0] != 0xAB || bytes[8] != 0xAB)
+				return 2;
+
+			char[] chs = new char[5];
+			Span<char> cspan = chs;
+			cspan.Slice(1, 3).Fill('x');
+			if (new string(chs, 1, 3) != "xxx" || chs[0] != 0 || chs[4] != 0)
+				return 3;
+			char[] copy = cspan.ToArray();
+			if (copy.Length != 5 || copy[2] != 'x')
+				return 4;
+
+			var pairs = new Pair[4];
+			new Span<Pair>(pairs).Fill(new Pair { A = 1, B = 2 });
+			if (pairs[3].A != 1 || pairs[3].B != 2)
+				return 5;
+
+			string[] strs = new string[3];
+			new Span<string>(strs).Fill("s");
+			if (strs[0] != "s" || strs[2] != "s")
+				return 6;
+
+			span[0] = 9;
+			if (ints[3] != 9 || span.Length != 30)
+				return 7;
+			span.Clear();
+			if (ints[3] != 0 || ints[32] != 0)
+				return 8;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestArraySort
+	{
+		enum Level : short
+		{
+			Low = -5,
+			Mid = 0,
+			High = 7,
+		}
+
+		public static int Entry()
+		{
+			long[] lary = new long[10000];
+			long seed = 12345;
+			for (int i = 0; i < lary.Length; ++i)
+			{
+				seed = seed * 6364136223846793005L + 1442695040888963407L;
+				lary[i] = seed;
+			}
+			Array.Sort(lary);
+			for (int i = 1; i < lary.Length; ++i)
+			{
+				if (lary[i - 1] > lary[i])
+					return 1;
+			}
+
+			double[] dary = { 3.5, double.NaN, -1, 0, double.NegativeInfinity, 2 };
+			Array.Sort(dary);
+			if (!double.IsNaN(dary[0]) || dary[1] != double.NegativeInfinity || dary[5] != 3.5)
+				return 2;
+
+			int[] keys = { 5, 3, 9, 1, 7 };
+			string[] items = { "e", "c", "i", "a", "g" };
+			Array.Sort(keys, items);
+			if (keys[0] != 1 || items[0] != "a" || keys[4] != 9 || items[4] != "i")
+				return 3;
+
+			int[] part = { 9, 8, 7, 6, 5, 4 };
+			Array.Sort(part, 1, 3);
+			if (part[0] != 9 || part[1] != 6 || part[3] != 8 || part[4] != 5)
+				return 4;
+
+			Level[] levels = { Level.High, Level.Low, Level.Mid };
+			Array.Sort(levels);
+			if (levels[0] != Level.Low || levels[2] != Level.High)
+				return 5;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestMDArrayAccess
+	{
+		private static double Sum(double[,] grid, int rows, int cols)
+		{
+			double s = 0;
+			for (int i = 0; i < rows; ++i)
+			{
+				for (int j = 0; j < cols; ++j)
+					s += grid[i, j];
+			}
+			return s;
+		}
+
+		public static int Entry()
+		{
+			double[,] grid = new double[30, 40];
+			for (int i = 0; i < grid.GetLength(0); ++i)
+			{
+				for (int j = 0; j < grid.GetLength(1); ++j)
+					grid[i, j] = i * 100 + j;
+			}
+			if (grid[29, 39] != 2939)
+				return 1;
+
+			double expect = 0;
+			for (int i = 0; i < 30; ++i)
+				for (int j = 0; j < 40; ++j)
+					expect += i * 100 + j;
+			if (Sum(grid, 30, 40) != expect)
+				return 2;
+
+			try
+			{
+				Sum(grid, 30, 41);
+				return 3;
+			}
+			catch (IndexOutOfRangeException)
+			{
+			}
+
+			int[,,] cube = new int[3, 4, 5];
+			cube[2, 3, 4] = 42;
+			ref int r = ref cube[1, 2, 3];
+			r = 7;
+			if (cube[2, 3, 4] != 42 || cube[1, 2, 3] != 7)
+				return 4;
+
+			try
+			{
+				cube[3, 0, 0] = 1;
+				return 5;
+			}
+			catch (IndexOutOfRangeException)
+			{
+			}
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestStaticArray
+	{
+		private static readonly int[] Fib = { 1, 1, 2, 3, 5, 8, 13, 21, 34, 55 };
+		private static readonly ushort[] Crc = { 0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7 };
+		private static readonly byte[] Mutable = { 9, 8, 7, 6, 5, 4, 3, 2 };
+		private static ReadOnlySpan<byte> Hex => new byte[] { 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46 };
+
+		public static int Entry()
+		{
+			int sum = 0;
+			for (int i = 0; i < Fib.Length; ++i)
+				sum += Fib[i];
+			if (sum != 143)
+				return 1;
+
+			if (Crc.Length != 8 || Crc[7] != 0x70E7 || Crc[Fib[3]] != 0x3063)
+				return 2;
+
+			Mutable[0] = 1;
+			if (Mutable[0] != 1 || Mutable[7] != 2)
+				return 3;
+
+			// 直接引用只读数据, 不分配数组
+			ReadOnlySpan<byte> hex = Hex;
+			if (hex.Length != 16 || hex[10] != 0x41 || hex[15] != 0x46)
+				return 4;
+			int hexSum = 0;
+			foreach (byte b in Hex)
+				hexSum += b;
+			if (hexSum != 0x30 * 10 + 45 + 0x41 * 6 + 15)
+				return 5;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestExceptionPropagation
+	{
+		private static int Trace;
+
+		private static void Deep(int n)
+		{
+			if (n == 0)
+				throw new ArgumentException();
+			Deep(n - 1);
+			Trace += 1000;
+		}
+
+		private static int WithFinally()
+		{
+			try
+			{
+				Trace = Trace * 10 + 1;
+				Deep(3);
+				Trace = Trace * 10 + 9;
+			}
+			finally
+			{
+				Trace = Trace * 10 + 2;
+			}
+			return -1;
+		}
+
+		private static void Rethrow()
+		{
+			try
+			{
+				Deep(1);
+			}
+			catch (ArgumentException)
+			{
+				Trace = Trace * 10 + 3;
+				throw;
+			}
+		}
+
+		private static int Checked(int a, int b)
+		{
+			return checked(a * b);
+		}
+
+		public static int Entry()
+		{
+			Trace = 0;
+			try
+			{
+				WithFinally();
+				return 1;
+			}
+			catch (ArgumentException)
+			{
+				Trace = Trace * 10 + 4;
+			}
+			if (Trace != 124)
+				return 2;
+
+			Trace = 0;
+			try
+			{
+				Rethrow();
+				return 3;
+			}
+			catch (Exception)
+			{
+			}
+			if (Trace != 3)
+				return 4;
+
+			int caught = 0;
+			try
+			{
+				object o = "str";
+				Trace = ((int[])o).Length;
+			}
+			catch (InvalidCastException)
+			{
+				++caught;
+			}
+
+			try
+			{
+				Trace = Checked(int.MaxValue, 2);
+			}
+			catch (OverflowException)
+			{
+				++caught;
+			}
+
+			int[] ary = new int[4];
+			try
+			{
+				for (int i = 0; i <= ary.Length; ++i)
+					ary[i] = i;
+			}
+			catch (IndexOutOfRangeException)
+			{
+				++caught;
+			}
+			if (caught != 3 || ary[3] != 3)
+				return 5;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestRuntimeExceptionReuse
+	{
+		private static int ParseDigit(int ch)
+		{
+			return checked((byte)(ch - '0'));
+		}
+
+		public static int Entry()
+		{
+			int failed = 0;
+			Exception last = null;
+			for (int i = 0; i < 1000; ++i)
+			{
+				try
+				{
+					ParseDigit('0' + i % 300);
+				}
+				catch (OverflowException ex)
+				{
+					++failed;
+					last = ex;
+				}
+			}
+			if (failed != 132)
+				return 1;
+
+			if (last.StackTrace == null)
+				return 2;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	[ImplicitNullCheck]
+	static class TestImplicitNullCheck
+	{
+		class Node
+		{
+			public int Value;
+			public Node Next;
+
+			public virtual int GetValue()
+			{
+				return Value;
+			}
+		}
+
+		class DerivedNode : Node
+		{
+			public override int GetValue()
+			{
+				return -Value;
+			}
+		}
+
+		struct Block16
+		{
+			public long A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15;
+		}
+
+		struct Block256
+		{
+			public Block16 B0, B1, B2, B3, B4, B5, B6, B7, B8, B9, B10, B11, B12, B13, B14, B15;
+		}
+
+		// 末尾字段超出保护页
+		class Huge
+		{
+			public Block256 Head0;
+			public Block256 Head1;
+			public int Tail;
+		}
+
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private static T GetNull<T>() where T : class
+		{
+			return null;
+		}
+
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private static int LoadValue(Node n)
+		{
+			return n.Value;
+		}
+
+		private static int TestLoad()
+		{
+			try
+			{
+				return LoadValue(GetNull<Node>());
+			}
+			catch (NullReferenceException)
+			{
+				return 0;
+			}
+		}
+
+		private static int TestStore()
+		{
+			Node n = GetNull<Node>();
+			try
+			{
+				n.Value = 1;
+			}
+			catch (NullReferenceException)
+			{
+				return 0;
+			}
+			return 1;
+		}
+
+		private static int TestDiscard()
+		{
+			Node n = GetNull<Node>();
+			int[] ary = GetNull<int[]>();
+			int caught = 0;
+			try
+			{
+				_ = n.Next;
+			}
+			catch (NullReferenceException)
+			{
+				++caught;
+			}
+			try
+			{
+				_ = ary.Length;
+			}
+			catch (NullReferenceException)
+			{
+				++caught;
+			}
+			return caught == 2 ? 0 : 1;
+		}
+
+		private static int TestArrayLength()
+		{
+			int[] ary = GetNull<int[]>();
+			try
+			{
+				return ary.Length + 1;
+			}
+			catch (NullReferenceException)
+			{
+				return 0;
+			}
+		}
+
+		private static int TestVirtualCall()
+		{
+			Node n = new DerivedNode();
+			if (n.GetValue() != 0)
+				return 1;
+			n = GetNull<Node>();
+			try
+			{
+				return n.GetValue() + 2;
+			}
+			catch (NullReferenceException)
+			{
+				return 0;
+			}
+		}
+
+		private static int TestLargeOffset()
+		{
+			Huge h = GetNull<Huge>();
+			try
+			{
+				return h.Tail + 1;
+			}
+			catch (NullReferenceException)
+			{
+				return 0;
+			}
+		}
+
+		private static int TestRepeated()
+		{
+			int caught = 0;
+			bool finallyRun = false;
+			for (int i = 0; i < 100; ++i)
+			{
+				try
+				{
+					try
+					{
+						caught += LoadValue(i % 2 == 0 ? GetNull<Node>() : new Node());
+					}
+					finally
+					{
+						finallyRun = true;
+					}
+				}
+				catch (NullReferenceException)
+				{
+					++caught;
+				}
+			}
+			return caught == 50 && finallyRun ? 0 : 1;
+		}
+
+		public static int Entry()
+		{
+			if (TestLoad() != 0)
+				return 1;
+			if (TestStore() != 0)
+				return 2;
+			if (TestDiscard() != 0)
+				return 3;
+			if (TestArrayLength() != 0)
+				return 4;
+			if (TestVirtualCall() != 0)
+				return 5;
+			if (TestLargeOffset() != 0)
+				return 6;
+			if (TestRepeated() != 0)
+				return 7;
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestThreading
+	{
+		class Worker
+		{
+			public int[] Results;
+			public int Index;
+			public int ThreadID;
+
+			public void Run()
+			{
+				int sum = 0;
+				for (int i = 0; i <= 1000 * (Index + 1); ++i)
+					sum += i;
+				Results[Index] = sum;
+				ThreadID = System.Threading.Thread.CurrentThread.ManagedThreadId;
+			}
+		}
+
+		private static int ParamSum;
+
+		private static void RunParam(object arg)
+		{
+			ParamSum = (int)arg + 1;
+		}
+
+		public static int Entry()
+		{
+			var results = new int[4];
+			var workers = new Worker[4];
+			var threads = new System.Threading.Thread[4];
+			for (int i = 0; i < 4; ++i)
+			{
+				workers[i] = new Worker { Results = results, Index = i };
+				threads[i] = new System.Threading.Thread(workers[i].Run, i == 0 ? 256 * 1024 : 0);
+				if (threads[i].IsAlive)
+					return 1;
+				threads[i].Start();
+			}
+
+			for (int i = 0; i < 4; ++i)
+				threads[i].Join();
+
+			int mainID = System.Threading.Thread.CurrentThread.ManagedThreadId;
+			for (int i = 0; i < 4; ++i)
+			{
+				int n = 1000 * (i + 1);
+				if (results[i] != n * (n + 1) / 2)
+					return 2;
+				if (threads[i].IsAlive)
+					return 3;
+				if (workers[i].ThreadID != threads[i].ManagedThreadId || workers[i].ThreadID == mainID)
+					return 4;
+				for (int j = 0; j < i; ++j)
+				{
+					if (workers[i].ThreadID == workers[j].ThreadID)
+						return 5;
+				}
+			}
+
+			var th = new System.Threading.Thread(RunParam);
+			th.IsBackground = true;
+			if (!th.IsBackground)
+				return 6;
+			th.Start(41);
+			if (!th.Join(10000) || ParamSum != 42)
+				return 7;
+
+			System.Threading.Thread.Sleep(1);
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestThreadPool
+	{
+		class FanIn
+		{
+			public int Pending;
+			public long Sum;
+
+			public void Done(long value)
+			{
+				lock (this)
+				{
+					Sum += value;
+					if (--Pending == 0)
+						System.Threading.Monitor.PulseAll(this);
+				}
+			}
+
+			public void Wait()
+			{
+				lock (this)
+				{
+					while (Pending != 0)
+						System.Threading.Monitor.Wait(this);
+				}
+			}
+		}
+
+		private static void Work(object state)
+		{
+			var item = (Tuple<FanIn, int>)state;
+			long sum = 0;
+			for (int i = 0; i <= item.Item2; ++i)
+				sum += i;
+			item.Item1.Done(sum);
+		}
+
+		public static int Entry()
+		{
+			const int count = 1000;
+			var fanIn = new FanIn { Pending = count };
+			long expect = 0;
+			for (int i = 0; i < count; ++i)
+			{
+				System.Threading.ThreadPool.QueueUserWorkItem(Work, Tuple.Create(fanIn, i));
+				expect += (long)i * (i + 1) / 2;
+			}
+			fanIn.Wait();
+			if (fanIn.Sum != expect)
+				return 1;
+
+			var tasks = new System.Threading.Tasks.Task<int>[16];
+			for (int i = 0; i < tasks.Length; ++i)
+			{
+				int n = i;
+				tasks[i] = System.Threading.Tasks.Task.Run(() => n * n);
+			}
+			int total = 0;
+			for (int i = 0; i < tasks.Length; ++i)
+				total += tasks[i].Result;
+			if (total != 1240)
+				return 2;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestInterlocked
+	{
+		class Node
+		{
+		}
+
+		static int Counter;
+		static long Total;
+
+		public static int Entry()
+		{
+			if (System.Threading.Interlocked.Increment(ref Counter) != 1)
+				return 1;
+			if (System.Threading.Interlocked.Decrement(ref Counter) != 0)
+				return 2;
+			if (System.Threading.Interlocked.Add(ref Counter, 5) != 5)
+				return 3;
+			if (System.Threading.Interlocked.Exchange(ref Counter, 9) != 5 || Counter != 9)
+				return 4;
+
+			Total = long.MaxValue;
+			if (System.Threading.Interlocked.Increment(ref Total) != long.MinValue)
+				return 5;
+			if (System.Threading.Interlocked.Add(ref Total, -1) != long.MaxValue)
+				return 6;
+
+			double d = 1.5;
+			if (System.Threading.Interlocked.Exchange(ref d, 2.5) != 1.5 || d != 2.5)
+				return 7;
+			if (System.Threading.Interlocked.CompareExchange(ref d, 3.5, 2.5) != 2.5 || d != 3.5)
+				return 8;
+
+			var a = new Node();
+			var b = new Node();
+			Node n = a;
+			if (System.Threading.Interlocked.Exchange(ref n, b) != a || n != b)
+				return 9;
+			if (System.Threading.Interlocked.CompareExchange(ref n, a, a) != b || n != b)
+				return 10;
+
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestParallelFor
+	{
+		public static int Entry()
+		{
+			// 捕获局部变量的闭包
+			int[] squares = new int[10000];
+			System.Threading.Tasks.Parallel.For(0, squares.Length, i =>
+			{
+				squares[i] = i * i;
+			});
+			for (int i = 0; i < squares.Length; ++i)
+			{
+				if (squares[i] != i * i)
+					return 1;
+			}
+
+			// 不捕获变量的缓存委托
+			System.Threading.Tasks.Parallel.For(0, Hits.Length, i =>
+			{
+				System.Threading.Interlocked.Increment(ref Hits[i % 8]);
+			});
+			int total = 0;
+			foreach (int n in Hits)
+				total += n;
+			if (total != Hits.Length)
+				return 2;
+
+			// 空区间与单元素区间
+			System.Threading.Tasks.Parallel.For(5, 5, i => squares[0] = -1);
+			System.Threading.Tasks.Parallel.For(7, 8, i => squares[i] = -i);
+			if (squares[0] != 0 || squares[7] != -7)
+				return 3;
+
+			return 0;
+		}
+
+		private static readonly int[] Hits = new int[4096];
+	}
+
+	[CodeGen]
+	static class TestThreadStatic
+	{
+		[ThreadStatic]
+		private static int Counter;
+		[ThreadStatic]
+		private static string Name;
+
+		private static int OtherCounter;
+		private static string OtherName;
+
+		public static int Entry()
+		{
+			Counter = 10;
+			Name = "main";
+
+			var th = new System.Threading.Thread(() =>
+			{
+				// 新线程看到的是默认值
+				OtherCounter = Counter;
+				OtherName = Name;
+				Counter = 20;
+				Name = "worker";
+				GC.Collect();
+				if (Name != "worker")
+					OtherCounter = -1;
+			});
+			th.Start();
+			th.Join();
+
+			if (OtherCounter != 0 || OtherName != null)
+				return 1;
+			if (Counter != 10 || Name != "main")
+				return 2;
+
+			++Counter;
+			if (Counter != 11)
+				return 3;
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestAsync
+	{
+		private static async System.Threading.Tasks.Task<int> Sum(int n)
+		{
+			int sum = 0;
+			for (int i = 1; i <= n; ++i)
+			{
+				// 同步完成的等待不挂起状态机
+				sum += await Identity(i);
+			}
+			return sum;
+		}
+
+		private static async System.Threading.Tasks.Task<int> Identity(int n)
+		{
+			if (n % 4 == 0)
+				await System.Threading.Tasks.Task.Yield();
+			return n;
+		}
+
+		private static async System.Threading.Tasks.Task<int> Delayed(int n)
+		{
+			await System.Threading.Tasks.Task.Delay(10);
+			return await System.Threading.Tasks.Task.Run(() => n * 2);
+		}
+
+		private static async System.Threading.Tasks.Task Fail()
+		{
+			await System.Threading.Tasks.Task.Yield();
+			throw new InvalidOperationException();
+		}
+
+		private static async System.Threading.Tasks.Task<int> Run()
+		{
+			int total = await Sum(10);
+			total += await Delayed(21);
+
+			try
+			{
+				await Fail();
+				return -1;
+			}
+			catch (InvalidOperationException)
+			{
+			}
+			return total;
+		}
+
+		public static int Entry()
+		{
+			if (Run().Result != 97)
+				return 1;
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestExprForward
+	{
+		private static int Poly(int a, int b, int c, int d)
+		{
+			return a + b * c - (d << 2) ^ ~a;
+		}
+
+		private static int StoreBetween(int a, int b)
+		{
+			// 栈上已加载的旧值不能被后续写入影响
+			return a * 10 + (a = b) + a;
+		}
+
+		private static int PostInc(int[] ary)
+		{
+			int i = 0;
+			int sum = 0;
+			sum += ary[i++] * 100;
+			sum += ary[i++] * 10;
+			sum += ary[i] + i;
+			return sum;
+		}
+
+		private static long Select(bool cond, int a, long b)
+		{
+			return (cond ? a : b) + (cond ? b : a) * 2;
+		}
+
+		private static int ByRef(ref int x, int y)
+		{
+			int old = x;
+			x = y;
+			return old - x;
+		}
+
+		private static double Mixed(float f, double d, uint u)
+		{
+			return f * 2 + d / 4 + u;
+		}
+
+		public static int Entry()
+		{
+			if (Poly(1, 2, 3, 4) != ((1 + 2 * 3 - (4 << 2)) ^ ~1))
+				return 1;
+			if (StoreBetween(3, 5) != 40)
+				return 2;
+			if (PostInc(new[] { 1, 2, 3 }) != 125)
+				return 3;
+			if (Select(true, 1, 2) != 5 || Select(false, 1, 2) != 4)
+				return 4;
+			int v = 7;
+			if (ByRef(ref v, 2) != 5 || v != 2)
+				return 5;
+			if (Mixed(1.5f, 8, 0xFFFFFFFF) != 3 + 2 + 4294967295.0)
+				return 6;
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestInline
+	{
+		struct Vec2
+		{
+			public int X, Y;
+
+			public Vec2(int x, int y)
+			{
+				X = x;
+				Y = y;
+			}
+
+			public int Dot(Vec2 o)
+			{
+				return X * o.X + Y * o.Y;
+			}
+		}
+
+		class Box
+		{
+			private int Value_;
+			public int Value
+			{
+				get { return Value_; }
+				set { Value_ = value; }
+			}
+		}
+
+		abstract class Shape
+		{
+			public abstract int Area();
+		}
+
+		sealed class Square : Shape
+		{
+			public int Side;
+			public override int Area()
+			{
+				return Side * Side;
+			}
+		}
+
+		private static int Sign(int v)
+		{
+			if (v > 0)
+				return 1;
+			if (v < 0)
+				return -1;
+			return 0;
+		}
+
+		private static byte Low(int v)
+		{
+			return (byte)v;
+		}
+
+		private static int Swap(ref int a, ref int b)
+		{
+			int t = a;
+			a = b;
+			b = t;
+			return a - b;
+		}
+
+		private static int Throws(int v)
+		{
+			if (v == 0)
+				throw new ArgumentException();
+			return 100 / v;
+		}
+
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private static int NoInline(int v)
+		{
+			return v + 1;
+		}
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		private static int Sum(int[] ary)
+		{
+			int sum = 0;
+			for (int i = 0; i < ary.Length; ++i)
+				sum += ary[i];
+			return sum;
+		}
+
+		public static int Entry()
+		{
+			var box = new Box();
+			box.Value = 42;
+			if (box.Value != 42)
+				return 1;
+
+			if (new Vec2(2, 3).Dot(new Vec2(4, 5)) != 23)
+				return 2;
+
+			if (Sign(5) + Sign(-5) * 2 + Sign(0) != -1)
+				return 3;
+
+			if (Low(0x1FF) != 0xFF)
+				return 4;
+
+			int a = 3, b = 8;
+			if (Swap(ref a, ref b) != 5 || a != 8 || b != 3)
+				return 5;
+
+			Shape shape = new Square() { Side = 6 };
+			if (shape.Area() != 36)
+				return 6;
+
+			int caught = 0;
+			try
+			{
+				Throws(0);
+			}
+			catch (ArgumentException)
+			{
+				caught = Throws(4);
+			}
+			if (caught != 25)
+				return 7;
+
+			if (NoInline(1) != 2)
+				return 8;
+
+			// 调用者栈上已有的值不受展开影响
+			if (10 + Sum(new[] { 1, 2, 3 }) * Sign(-1) != 4)
+				return 9;
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestGenericShare
+	{
+		class Foo
+		{
+			public int Value = 1;
+		}
+
+		class Bar
+		{
+			public string Name = "bar";
+		}
+
+		class Pair<T>
+		{
+			private T First;
+			private T Second;
+			private int Count;
+
+			public void Set(T first, T second)
+			{
+				First = first;
+				Second = second;
+				++Count;
+			}
+
+			public void Swap()
+			{
+				T tmp = First;
+				First = Second;
+				Second = tmp;
+			}
+
+			public T GetFirst()
+			{
+				return First;
+			}
+
+			public int GetCount()
+			{
+				return Count;
+			}
+
+			// 依赖具体实参, 不能共享
+			public T[] ToArray()
+			{
+				return new T[] { First, Second };
+			}
+
+			public bool IsFoo()
+			{
+				return First is Foo;
+			}
+		}
+
+		struct Slot<T>
+		{
+			public T Item;
+			public int Tag;
+
+			public Slot(T item, int tag)
+			{
+				Item = item;
+				Tag = tag;
+			}
+		}
+
+		private static Slot<T> Retag<T>(Slot<T> slot, int tag)
+		{
+			slot.Tag = tag;
+			return slot;
+		}
+
+		public static int Entry()
+		{
+			var foos = new Pair<Foo>();
+			var f1 = new Foo();
+			var f2 = new Foo() { Value = 2 };
+			foos.Set(f1, f2);
+			foos.Swap();
+			if (foos.GetFirst() != f2 || foos.GetCount() != 1)
+				return 1;
+
+			var bars = new Pair<Bar>();
+			var b1 = new Bar();
+			bars.Set(b1, null);
+			bars.Set(b1, new Bar() { Name = "b2" });
+			bars.Swap();
+			if (bars.GetFirst().Name != "b2" || bars.GetCount() != 2)
+				return 2;
+
+			var ints = new Pair<int>();
+			ints.Set(3, 4);
+			ints.Swap();
+			if (ints.GetFirst() != 4)
+				return 3;
+
+			if (!(foos.ToArray() is Foo[]) || !(bars.ToArray() is Bar[]))
+				return 4;
+			if (!foos.IsFoo() || bars.IsFoo())
+				return 5;
+
+			var sf = Retag(new Slot<Foo>(f1, 1), 5);
+			var sb = Retag(new Slot<Bar>(b1, 2), 6);
+			if (sf.Item != f1 || sf.Tag != 5 || sb.Item != b1 || sb.Tag != 6)
+				return 6;
+			return 0;
+		}
+	}
+
+	[CodeGen]
+	static class TestCodeFold
+	{
+		enum Color
+		{
+			Red,
+			Green
+		}
+
+		enum Shape
+		{
+			Circle,
+			Square
+		}
+
+		class Alpha
+		{
+			public int Value;
+
+			[Folded("ctor")]
+			public Alpha()
+			{
+			}
+
+			public int Twice()
+			{
+				return Value * 2;
+			}
+		}
+
+		class Beta
+		{
+			public int Value;
+
+			[Folded("ctor")]
+			public Beta()
+			{
+			}
+
+			public int Twice()
+			{
+				return Value * 2;
+			}
+		}
+
+		[Folded("mix")]
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private static int MixA(int x, int y)
+		{
+			return x * 31 + y;
+		}
+
+		[Folded("mix")]
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private static int MixB(int x, int y)
+		{
+			return x * 31 + y;
+		}
+
+		// 引用类型参数不同, 折叠后经转换调用
+		[Folded("count")]
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private static int CountOf(Alpha a)
+		{
+			return a == null ? 0 : 1;
+		}
+
+		[Folded("count")]
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private static int CountOf(Beta b)
+		{
+			return b == null ? 0 : 1;
+		}
+
+		private static int Fact(int n)
 		{
-			public int Foo()
-			{
-				return 456;
-			}
+			return n <= 1 ? 1 : n * Fact(n - 1);
 		}
 
-		struct Stru : Inf
+		private static int Fact2(int n)
 		{
-			public int num;
+			return n <= 1 ? 1 : n * Fact2(n - 1);
+		}
 
-			public Stru(int n)
-			{
-				num = n;
-			}
-			public int Foo()
-			{
-				return num;
-			}
+		// 委托目标的地址需要保持唯一
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private static int One()
+		{
+			return 1;
 		}
 
-		private static int Bla(Inf inf)
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private static int Uno()
 		{
-			return inf.Foo();
+			return 1;
 		}
 
 		public static int Entry()
 		{
-			if (Bla(new ClsB()) - Bla(new ClsA()) != 333)
+			// 实现相同的方法折叠后仍各自可用
+			if (new Alpha() { Value = 3 }.Twice() != 6 || new Beta() { Value = 4 }.Twice() != 8)
 				return 1;
-			if (Bla(new Stru(789)) != 789)
+			// 值类型的 GetHashCode 只有类型盐值不同, 不能折叠
+			if (Color.Green.GetHashCode() == Shape.Square.GetHashCode() ||
+				Color.Red.GetHashCode() == Color.Green.GetHashCode())
 				return 2;
-			Inf inf = new Stru(789);
-			if (inf.Foo() != 789)
+			if (Fact(5) != 120 || Fact2(4) != 24)
 				return 3;
 
+			Func<int> fa = new Alpha() { Value = 5 }.Twice;
+			Func<int> fb = new Beta() { Value = 6 }.Twice;
+			if (fa() + fb() != 22)
+				return 4;
+
+			if (MixA(1, 2) != 33 || MixB(2, 1) != 63)
+				return 5;
+			if (CountOf(new Alpha()) != 1 || CountOf(new Beta()) != 1 || CountOf((Beta)null) != 0)
+				return 6;
+
+			Func<int> f1 = One;
+			Func<int> f2 = Uno;
+			if (f1() + f2() != 2 || f1.Equals(f2))
+				return 7;
 			return 0;
 		}
 	}
 
 	[CodeGen]
-	static class TestCallVirtStru
+	static class TestLargeStructArgs
 	{
-		interface Inf<T>
-		{
-			T Foo(T t);
-		}
-
-		struct StruA<T> : Inf<T>
+		struct Mat
 		{
-			public T num;
+			public double M00, M01, M10, M11;
+			public long Tag;
 
-			public StruA(T n)
+			public Mat(double a, double b, double c, double d)
 			{
-				num = n;
-			}
-			public T Foo(T t)
-			{
-				return num;
+				M00 = a;
+				M01 = b;
+				M10 = c;
+				M11 = d;
+				Tag = 0;
 			}
 		}
 
-		class ClsB<T> : Inf<T>
+		interface IScale
 		{
-			public T num;
-			public T Foo(T t)
+			double Scale(Mat m);
+		}
+
+		struct Scaler : IScale
+		{
+			public double Factor;
+			public double Scale(Mat m)
 			{
-				return num;
+				return (m.M00 + m.M11) * Factor;
 			}
 		}
 
-		struct StruC : Inf<int>
+		class Base
 		{
-			public int Foo(int t)
+			public virtual double Trace(Mat m)
 			{
-				return t * 2;
+				return m.M00 + m.M11;
 			}
 		}
 
-		class ClsD : Inf<int>
+		class Derived : Base
 		{
-			public int Foo(int t)
+			public override double Trace(Mat m)
 			{
-				return t * 3;
+				return base.Trace(m) * 2;
 			}
 		}
 
-		private static T Bla2<T>(Inf<T> inf, T t)
+		private static double Det(Mat m)
 		{
-			return inf.Foo(t);
+			return m.M00 * m.M11 - m.M01 * m.M10;
 		}
 
-		public static int Entry()
+		// 修改参数不能影响调用者的值
+		private static double Bump(Mat m)
 		{
-			if (Bla2(new StruA<int>(123), 123) != 123)
-				return 1;
-			var bb = new ClsB<int>();
-			bb.num = 456;
-			if (Bla2(bb, 123) != 456)
-				return 2;
-			if (Bla2(new StruC(), 123) != 246)
-				return 3;
-			if (Bla2(new ClsD(), 124) != 372)
-				return 4;
-
-			return 0;
+			m.M00 += 1;
+			m = new Mat(m.M00, m.M01, m.M10, m.M11 + 1);
+			return Det(m);
 		}
-	}
 
-	[CodeGen]
-	static class TestString
-	{
-		class MyCls
+		private static void Touch(ref Mat m)
 		{
-			public string strfld = "defaultstr";
+			m.Tag = 42;
 		}
 
-		private static string Foo(string s)
+		private static long TagOf(Mat m)
 		{
-			return s;
+			Touch(ref m);
+			return m.Tag;
 		}
 
-		public static unsafe int Entry()
+		private static double SumIn(in Mat m)
 		{
-			string s = "asdf\\1234\"zxcv'!~";
-
-			if (s[4] != 0x5C)
-				return -1;
-			if (s[9] != 0x22)
-				return -2;
-			if (s[14] != 0x27)
-				return -3;
-
-			s = "0987\r\n!~";
-			if (s[4] != 0x0D)
-				return -4;
-			if (s[5] != 0x0A)
-				return -5;
-
-			s = "你好世界";
-			if (s[0] != 0x4F60)
-				return -6;
-			if (s[1] != 0x597D)
-				return -7;
-			if (s[2] != 0x4E16)
-				return -8;
-			if (s[3] != 0x754C)
-				return -9;
-			if (s.Length != 4)
-				return -10;
-
-			s = "";
-			object o = s.Length == 0 ? s : null;
-			if (!(o is string))
-				return -11;
+			return m.M00 + m.M01 + m.M10 + m.M11;
+		}
 
-			s = "hello,world";
-			if (s != "hello,world")
+		public static int Entry()
+		{
+			var m = new Mat(1, 2, 3, 4);
+			if (Det(m) != -2)
 				return 1;
-			if (s.Length != 11)
+			if (Bump(m) != 2 * 5 - 6 || m.M00 != 1 || m.M11 != 4)
 				return 2;
-
-			if (Foo(s) != s)
+			if (TagOf(m) != 42 || m.Tag != 0)
 				return 3;
 
-			if (s[0] != 'h')
+			Base b = new Derived();
+			if (b.Trace(m) != 10)
 				return 4;
-			if (s[10] != 'd')
+
+			IScale s = new Scaler() { Factor = 3 };
+			if (s.Scale(m) != 15)
 				return 5;
 
-			int hash = s.GetHashCode();
-			if (hash != "hello,world".GetHashCode())
+			Func<Mat, double> fn = Det;
+			if (fn(m) != -2)
 				return 6;
 
-			MyCls cls = new MyCls();
-			if (cls.strfld != "defaultstr")
+			if (SumIn(m) != 10)
 				return 7;
-			cls.strfld = "nice";
-			if (cls.strfld != "nice")
-				return 8;
-
-			string strRep = "adsf @calloc 1234";
-			if (strRep[6] != 'c' ||
-				strRep[7] != 'a' ||
-				strRep[8] != 'l' ||
-				strRep[9] != 'l' ||
-				strRep[10] != 'o' ||
-				strRep[11] != 'c' ||
-				strRep[12] != ' ')
-				return 9;
-
-			string strRep2 = "adsf  attributes # 1234";
-			if (strRep2[6] != 'a' ||
-				strRep2[7] != 't' ||
-				strRep2[8] != 't' ||
-				strRep2[9] != 'r' ||
-				strRep2[10] != 'i' ||
-				strRep2[11] != 'b' ||
-				strRep2[12] != 'u' ||
-				strRep2[13] != 't' ||
-				strRep2[14] != 'e' ||
-				strRep2[15] != 's' ||
-				strRep2[16] != ' ')
-				return 10;
-
-			string aa = "Test";
-			string bb = "拼接";
-			string con = aa + bb;
-			if (con != "Test拼接")
-				return 11;
-
-			if (con.Substring(2, 3) != "st拼")
-				return 12;
-
-			if (con.IndexOf('拼') != 4)
-				return 13;
-
-			string strCmp = "qwe\0r";
-			if (strCmp != strCmp ||
-				strCmp == "qwe\0\0")
-				return 14;
-
-			char* pstr = stackalloc char[10];
-			pstr[5] = 'H';
-			pstr[6] = 'e';
-			pstr[7] = 'l';
-			pstr[8] = 'l';
-			pstr[9] = 'o';
-			string str = new string(pstr, 5, 5);
-			if (str != "Hello")
-				return 15;
-
-			return 0;
-		}
-	}
-
-	[CodeGen]
-	static class TestString2
-	{
-		public static int Entry()
-		{
-			string str = "1234asdf测试字符串字符串";
-			if (str.IndexOf("df测试", StringComparison.Ordinal) != 6)
-				return 1;
-
-			if (str.LastIndexOf("字符串", StringComparison.Ordinal) != 13)
-				return 2;
-
 			return 0;
 		}
 	}
@@ -1756,6 +3598,79 @@ namespace testcase
 			}
 		}
 
+		static int test5num = 0;
+		static int Test5()
+		{
+			// 跨越两层 finally 返回
+			try
+			{
+				try
+				{
+					test5num = 2;
+					return 1;
+				}
+				finally
+				{
+					test5num += 1;
+				}
+			}
+			finally
+			{
+				test5num *= 10;
+			}
+		}
+
+		static int test6num = 0;
+		static int Test6()
+		{
+			// finally 中的异常块不能覆盖外层待执行的返回
+			try
+			{
+				test6num = 1;
+				return 5;
+			}
+			finally
+			{
+				try
+				{
+					test6num += 10;
+				}
+				finally
+				{
+					test6num += 100;
+				}
+				test6num *= 2;
+			}
+		}
+
+		static int test7num = 0;
+		static int Test7()
+		{
+			// finally 中的异常块不能吞掉正在传播的异常
+			try
+			{
+				try
+				{
+					throw new Except1();
+				}
+				finally
+				{
+					try
+					{
+						test7num = 1;
+					}
+					finally
+					{
+						test7num += 1;
+					}
+				}
+			}
+			catch (Except1)
+			{
+				return test7num;
+			}
+		}
+
 		public static int Entry()
 		{
 			if (Test1() != 9)
@@ -1766,6 +3681,12 @@ namespace testcase
 				return -3;
 			if (Test4() != 20790)
 				return -4;
+			if (Test5() != 1 || test5num != 30)
+				return -5;
+			if (Test6() != 5 || test6num != 222)
+				return -6;
+			if (Test7() != 2)
+				return -7;
 
 			filterNum = 0;
 			ExceptionFunc();